@@ -166,6 +166,16 @@ namespace Elastos {
 					const nlohmann::json &createdTx,
 					const std::string &payPassword) const = 0;
 
+			/**
+			 * Sign a batch of transactions with a single unlock of the root private key. Keys derived for one transaction are reused by the others, and transactions are signed in parallel.
+			 * @param createdTxs json array of transactions, each in the same format as for SignTransaction().
+			 * @param payPassword use to decrypt the root private key temporarily. Pay password should between 8 and 128, otherwise will throw invalid argument exception.
+			 * @return If success return json array of signed transactions, in the same order as createdTxs.
+			 */
+			virtual nlohmann::json SignTransactions(
+					const nlohmann::json &createdTxs,
+					const std::string &payPassword) const = 0;
+
 			/**
 			 * Get signers already signed specified transaction.
 			 * @param tx a signed transaction to find signed signers.
@@ -15,6 +15,9 @@
 #include <WalletCore/HDKeychain.h>
 #include <WalletCore/Key.h>
 
+#include <boost/thread.hpp>
+#include <atomic>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -630,9 +633,10 @@ namespace Elastos {
 				return false;
 			}
 
-			bytes_t bytes;
-			bytes.setBase64(walletJSON["Data"].get<std::string>());
-			ByteStream stream(bytes);
+			bytes_t data, bytes;
+			data.setBase64(walletJSON["Data"].get<std::string>());
+			// fields are read into bytes, which must not alias the buffer the view reads from
+			ByteStreamView stream(data);
 
 			uint8_t byte;
 			if (!stream.ReadUint8(byte)) {
@@ -892,6 +896,71 @@ namespace Elastos {
 			_localstore->Save();
 		}
 
+		std::string Account::DerivedCodesOwner() const {
+			if (GetSignType() != MultiSign)
+				return _localstore->GetxPubKey();
+
+			std::string owner = _localstore->DerivationStrategy() + "/" + std::to_string(_localstore->GetM());
+			for (size_t i = 0; i < _allMultiSigners.size(); ++i)
+				owner += "/" + _allMultiSigners[i]->pubkey().getHex();
+
+			return owner;
+		}
+
+		std::vector<bytes_t> Account::AddressCodes(uint32_t chain, uint32_t start, size_t count) const {
+			boost::mutex::scoped_lock scopedLock(_derivedCodesLock);
+
+			if (_derivedCodes == nullptr)
+				_derivedCodes = boost::shared_ptr<DerivedCodeStore>(new DerivedCodeStore(_localstore->GetDataPath()));
+			_derivedCodes->SetOwner(DerivedCodesOwner());
+			const std::vector<bytes_t> &cached = _derivedCodes->GetCodes(chain);
+
+			if (cached.size() < start + count) {
+				size_t first = cached.size(), total = start + count - first;
+				std::vector<bytes_t> codes(total);
+
+				std::vector<HDKeychain> keychains;
+				if (GetSignType() == MultiSign) {
+					for (const HDKeychainPtr &keychain : MultiSignCosigner())
+						keychains.push_back(keychain->getChild(chain));
+				} else {
+					keychains.push_back(MasterPubKey()->getChild(chain));
+				}
+
+				// an invalid address leaves its code empty
+				std::atomic<size_t> next(0);
+				boost::function<void()> worker = [&]() {
+					std::vector<bytes_t> pubkeys(keychains.size());
+					for (size_t i = next++; i < total; i = next++) {
+						for (size_t k = 0; k < keychains.size(); ++k)
+							pubkeys[k] = keychains[k].getChild((uint32_t) (first + i)).pubkey();
+
+						Address address = GetSignType() == MultiSign ?
+										  Address(PrefixMultiSign, pubkeys, (uint8_t) GetM()) :
+										  Address(PrefixStandard, pubkeys[0]);
+						if (address.Valid())
+							codes[i] = address.RedeemScript();
+					}
+				};
+
+				size_t threadCount = std::max(1u, boost::thread::hardware_concurrency());
+				threadCount = std::min(threadCount, total);
+
+				boost::thread_group workers;
+				for (size_t i = 1; i < threadCount; ++i)
+					workers.create_thread(worker);
+				worker();
+				workers.join_all();
+
+				SPVLOG_DEBUG("derived {} addresses of chain {} with {} threads", total, chain, threadCount);
+
+				_derivedCodes->AddCodes(chain, codes);
+				_derivedCodes->Save();
+			}
+
+			return std::vector<bytes_t>(cached.begin() + start, cached.begin() + start + count);
+		}
+
 		void Account::Remove() {
 			_localstore->Remove();
 		}
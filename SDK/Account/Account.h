@@ -6,6 +6,7 @@
 #define __ELASTOS_SDK_ACCOUNT_H__
 
 #include "IAccount.h"
+#include "DerivedCodeStore.h"
 
 #include <WalletCore/Mnemonic.h>
 #include <Common/Mstream.h>
@@ -13,6 +14,7 @@
 #include <SpvService/LocalStore.h>
 
 #include <nlohmann/json.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -125,9 +127,15 @@ namespace Elastos {
 			std::string GetDataPath() const;
 
 			void RegenerateKey(const std::string &payPasswd) const;
+
+			// redeem scripts of the addresses [start, start + count) of a chain. Codes missing from the DerivedCodeStore
+			// are derived on a pool of threads and saved, so every address is derived only once per wallet
+			std::vector<bytes_t> AddressCodes(uint32_t chain, uint32_t start, size_t count) const;
 		private:
 			void Init() const;
 
+			std::string DerivedCodesOwner() const;
+
 		private:
 			LocalStorePtr _localstore;
 			mutable HDKeychainPtr _xpub;
@@ -135,6 +143,8 @@ namespace Elastos {
 			mutable HDKeychainPtr _curMultiSigner; // multi sign current wallet signer
 			mutable HDKeychainArray _allMultiSigners; // including _multiSigner and sorted
 			mutable bytes_t _ownerPubKey, _requestPubKey;
+			mutable boost::mutex _derivedCodesLock;
+			mutable boost::shared_ptr<DerivedCodeStore> _derivedCodes; // loaded by the first AddressCodes
 		};
 
 	}
@@ -0,0 +1,127 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "DerivedCodeStore.h"
+
+#include <Common/ByteStream.h>
+#include <Common/ErrorChecker.h>
+#include <Common/Log.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+#define DERIVED_CODE_STORE_FILE "DerivedCodes.dat"
+#define DERIVED_CODE_STORE_VERSION 1
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		DerivedCodeStore::DerivedCodeStore(const std::string &dataPath) {
+			if (!dataPath.empty()) {
+				_path = dataPath;
+				_path /= DERIVED_CODE_STORE_FILE;
+				Load();
+			}
+		}
+
+		DerivedCodeStore::~DerivedCodeStore() {
+		}
+
+		void DerivedCodeStore::SetOwner(const std::string &owner) {
+			if (_owner != owner) {
+				_owner = owner;
+				_codes[0].clear();
+				_codes[1].clear();
+			}
+		}
+
+		const std::vector<bytes_t> &DerivedCodeStore::GetCodes(uint32_t chain) const {
+			ErrorChecker::CheckParam(chain > 1, Error::InvalidArgument, "invalid chain");
+			return _codes[chain];
+		}
+
+		void DerivedCodeStore::AddCodes(uint32_t chain, const std::vector<bytes_t> &codes) {
+			ErrorChecker::CheckParam(chain > 1, Error::InvalidArgument, "invalid chain");
+			_codes[chain].insert(_codes[chain].end(), codes.begin(), codes.end());
+		}
+
+		bool DerivedCodeStore::Save() const {
+			if (_path.empty())
+				return true;
+
+			ByteStream stream;
+			stream.WriteUint32(DERIVED_CODE_STORE_VERSION);
+			stream.WriteVarString(_owner);
+			for (size_t chain = 0; chain < 2; ++chain) {
+				stream.WriteVarUint(_codes[chain].size());
+				for (size_t i = 0; i < _codes[chain].size(); ++i)
+					stream.WriteVarBytes(_codes[chain][i]);
+			}
+
+			boost::system::error_code ec;
+			boost::filesystem::create_directories(_path.parent_path(), ec);
+
+			boost::filesystem::path tmpPath = _path.string() + ".tmp";
+			FILE *file = fopen(tmpPath.string().c_str(), "wb");
+			if (file == nullptr) {
+				Log::error("create derived codes {} failed", tmpPath.string());
+				return false;
+			}
+
+			const bytes_t &data = stream.GetBytes();
+			bool ok = fwrite(data.data(), data.size(), 1, file) == 1 && fflush(file) == 0 && fsync(fileno(file)) == 0;
+			fclose(file);
+
+			if (!ok) {
+				Log::error("write derived codes {} failed", tmpPath.string());
+				boost::filesystem::remove(tmpPath, ec);
+				return false;
+			}
+
+			boost::filesystem::rename(tmpPath, _path, ec);
+			if (ec) {
+				Log::error("replace derived codes {}: {}", _path.string(), ec.message());
+				return false;
+			}
+
+			return true;
+		}
+
+		void DerivedCodeStore::Load() {
+			std::ifstream is(_path.string(), std::ios::binary);
+			if (!is)
+				return;
+
+			bytes_t data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+			ByteStreamView stream(data);
+
+			uint32_t version = 0;
+			std::string owner;
+			std::vector<bytes_t> codes[2];
+			bool ok = stream.ReadUint32(version) && version == DERIVED_CODE_STORE_VERSION &&
+					  stream.ReadVarString(owner);
+			for (size_t chain = 0; ok && chain < 2; ++chain) {
+				uint64_t count = 0;
+				ok = stream.ReadVarUint(count);
+				for (uint64_t i = 0; ok && i < count; ++i) {
+					bytes_t code;
+					ok = stream.ReadVarBytes(code);
+					codes[chain].push_back(code);
+				}
+			}
+
+			if (!ok) {
+				Log::warn("ignore unreadable derived codes {}", _path.string());
+				return;
+			}
+
+			_owner = owner;
+			_codes[0].swap(codes[0]);
+			_codes[1].swap(codes[1]);
+		}
+
+	}
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_DERIVEDCODESTORE_H__
+#define __ELASTOS_SDK_DERIVEDCODESTORE_H__
+
+#include <Common/typedefs.h>
+
+#include <boost/filesystem.hpp>
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Redeem scripts of the derived addresses of the external and internal chain, so every address is derived
+		 * once per wallet. Kept in a file of its own next to the local store, which holds the keys and is not
+		 * rewritten while syncing. The file is only a cache, a missing or unreadable one is derived again.
+		 * Not thread safe.
+		 */
+		class DerivedCodeStore {
+		public:
+			// dataPath is the wallet directory, an empty one keeps the codes in memory only
+			explicit DerivedCodeStore(const std::string &dataPath);
+
+			~DerivedCodeStore();
+
+			// forget the codes when they were derived from other public keys
+			void SetOwner(const std::string &owner);
+
+			const std::vector<bytes_t> &GetCodes(uint32_t chain) const;
+
+			void AddCodes(uint32_t chain, const std::vector<bytes_t> &codes);
+
+			// Writes a temporary file and renames it over the old one, a crash leaves either one or the other.
+			bool Save() const;
+
+		private:
+			void Load();
+
+		private:
+			boost::filesystem::path _path;
+			std::string _owner;
+			std::vector<bytes_t> _codes[2];
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_DERIVEDCODESTORE_H__
@@ -0,0 +1,90 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "DerivedKeyCache.h"
+
+#include <Common/ErrorChecker.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		DerivedKeyCache::DerivedKeyCache(const HDKeychainPtr &rootKey) :
+			_rootKey(rootKey) {
+			ErrorChecker::CheckLogic(_rootKey == nullptr, Error::Key, "invalid root key");
+		}
+
+		DerivedKeyCache::~DerivedKeyCache() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			_keys.clear();
+			_nodes.clear();
+		}
+
+		bool DerivedKeyCache::FindKey(const std::string &path, const std::vector<SmallBytes> &pubKeys, Key &key) {
+			const DerivedKey &derived = GetKey(path);
+
+			for (size_t i = 0; i < pubKeys.size(); ++i) {
+				if (pubKeys[i] == derived.pubKey) {
+					key = derived.key;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		size_t DerivedKeyCache::Size() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _keys.size();
+		}
+
+		bool DerivedKeyCache::ContainsNode(const std::string &path) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _nodes.find(path) != _nodes.end();
+		}
+
+		HDKeychain DerivedKeyCache::GetNode(const std::string &path) {
+			if (path.empty())
+				return *_rootKey;
+
+			{
+				boost::mutex::scoped_lock scopedLock(_lock);
+				std::map<std::string, HDKeychain>::iterator it = _nodes.find(path);
+				if (it != _nodes.end())
+					return it->second;
+			}
+
+			// derive from the parent node, which caches every ancestor on the way (44', 44'/0', ..., 45'/n, ...).
+			// done outside the lock, a duplicate derivation by another thread is harmless
+			size_t pos = path.rfind('/');
+			HDKeychain node = pos == std::string::npos ? _rootKey->getChild(path) :
+							  GetNode(path.substr(0, pos)).getChild(path.substr(pos + 1));
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			_nodes.insert(std::make_pair(path, node));
+			return node;
+		}
+
+		const DerivedKeyCache::DerivedKey &DerivedKeyCache::GetKey(const std::string &path) {
+			{
+				boost::mutex::scoped_lock scopedLock(_lock);
+				std::map<std::string, DerivedKey>::iterator it = _keys.find(path);
+				if (it != _keys.end())
+					return it->second;
+			}
+
+			// the leaf itself is not kept as a node, only as a key
+			size_t pos = path.rfind('/');
+			HDKeychain node = pos == std::string::npos ? _rootKey->getChild(path) :
+							  GetNode(path.substr(0, pos)).getChild(path.substr(pos + 1));
+
+			DerivedKey derived;
+			derived.key = node;
+			derived.pubKey = derived.key.PubKey();
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _keys.insert(std::make_pair(path, derived)).first->second;
+		}
+
+	}
+}
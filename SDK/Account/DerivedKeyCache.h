@@ -0,0 +1,55 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_DERIVEDKEYCACHE_H__
+#define __ELASTOS_SDK_DERIVEDKEYCACHE_H__
+
+#include <WalletCore/HDKeychain.h>
+#include <WalletCore/Key.h>
+
+#include <boost/thread/mutex.hpp>
+#include <map>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Memoizes child keys derived from an unlocked root key while signing a batch of transactions.
+		 * Every ancestor node of a path (44'/0'/0', 45'/n, 45'/n/0, ...) is cached too, so sibling
+		 * paths only pay for their last step. Safe to share between signing threads.
+		 */
+		class DerivedKeyCache {
+		public:
+			DerivedKeyCache(const HDKeychainPtr &rootKey);
+
+			~DerivedKeyCache();
+
+			// return true and set key if the key derived from path matches one of the public keys
+			bool FindKey(const std::string &path, const std::vector<SmallBytes> &pubKeys, Key &key);
+
+			size_t Size() const;
+
+			bool ContainsNode(const std::string &path) const;
+
+		private:
+			struct DerivedKey {
+				Key key;
+				bytes_t pubKey;
+			};
+
+			HDKeychain GetNode(const std::string &path);
+
+			const DerivedKey &GetKey(const std::string &path);
+
+		private:
+			mutable boost::mutex _lock;
+			HDKeychainPtr _rootKey;
+			std::map<std::string, HDKeychain> _nodes;
+			std::map<std::string, DerivedKey> _keys;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_DERIVEDKEYCACHE_H__
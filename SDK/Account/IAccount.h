@@ -106,6 +106,8 @@ namespace Elastos {
 			virtual std::string GetDataPath() const = 0;
 
 			virtual void RegenerateKey(const std::string &payPasswd) const = 0;
+
+			virtual std::vector<bytes_t> AddressCodes(uint32_t chain, uint32_t start, size_t count) const = 0;
 		};
 
 		typedef boost::shared_ptr<IAccount> AccountPtr;
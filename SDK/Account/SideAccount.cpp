@@ -69,6 +69,8 @@ namespace Elastos {
 
 		void SideAccount::SignTransaction(const TransactionPtr &, const std::string &) const {}
 
+		void SideAccount::SignTransactions(const std::vector<TransactionPtr> &, const std::string &) const {}
+
 		Key SideAccount::GetKeyWithDID(const AddressPtr &did, const std::string &payPasswd) const {
 			return Key();
 		}
@@ -103,6 +103,8 @@ namespace Elastos {
 
 			std::string GetDataPath() const { return ""; }
 
+			std::vector<bytes_t> AddressCodes(uint32_t, uint32_t, size_t) const { return {}; }
+
 		private:
 			std::vector<PublicKeyRing> _empty_pub_keys;
 			std::vector<CoinInfoPtr> _empty_coin_info;
@@ -147,6 +149,8 @@ namespace Elastos {
 
 			void SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const;
 
+			void SignTransactions(const std::vector<TransactionPtr> &txs, const std::string &payPasswd) const;
+
 			Key GetKeyWithDID(const AddressPtr &did, const std::string &payPasswd) const;
 
 			Key DeriveOwnerKey(const std::string &payPasswd);
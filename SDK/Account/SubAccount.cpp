@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "SubAccount.h"
+#include "DerivedKeyCache.h"
 
 #include <Wallet/Wallet.h>
 #include <Common/Utils.h>
@@ -14,6 +15,10 @@
 #include <Plugin/Transaction/Attribute.h>
 #include <WalletCore/Key.h>
 
+#include <boost/thread.hpp>
+#include <atomic>
+#include <exception>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -144,36 +149,28 @@ namespace Elastos {
 			assert(gapLimit > 0);
 
 			AddressArray &addrChain = internal ? _internalChain : _externalChain;
-			std::vector<HDKeychain> keychains;
-			if (_parent->GetSignType() == Account::MultiSign) {
-				for (const HDKeychainPtr &keychain : _parent->MultiSignCosigner())
-					keychains.push_back(keychain->getChild(chain));
-			} else {
-				keychains.push_back(_parent->MasterPubKey()->getChild(chain));
-			}
+			Prefix prefix = _parent->GetSignType() == Account::MultiSign ? PrefixMultiSign : PrefixStandard;
 
 			i = count = startCount = addrChain.size();
 
 			// keep only the trailing contiguous block of addresses with no transactions
 			while (i > 0 && _usedAddrs.find(addrChain[i - 1]) == _usedAddrs.end()) i--;
 
-			while (i + gapLimit > count) { // generate new addresses up to gapLimit
-				AddressPtr address;
-				if (_parent->GetSignType() == Account::MultiSign) {
-					pubkeys.clear();
-					for (const HDKeychain &signer : keychains) {
-						pubkeys.push_back(signer.getChild(count).pubkey());
+			bool valid = true;
+			while (valid && i + gapLimit > count) { // generate new addresses up to gapLimit
+				std::vector<bytes_t> codes = _parent->AddressCodes(chain, count, i + gapLimit - count);
+
+				valid = !codes.empty();
+				for (size_t n = 0; valid && n < codes.size(); ++n) {
+					valid = !codes[n].empty();
+					if (valid) {
+						AddressPtr address(new Address());
+						address->SetRedeemScript(prefix, codes[n]);
+						addrChain.push_back(address);
+						count++;
+						if (_usedAddrs.find(address) != _usedAddrs.end()) i = count;
 					}
-					address = AddressPtr(new Address(PrefixMultiSign, pubkeys, _parent->GetM()));
-				} else {
-					pubkey = keychains[0].getChild(count).pubkey();
-					address = AddressPtr(new Address(PrefixStandard, pubkey));
 				}
-
-				if (!address->Valid()) break;
-				addrChain.push_back(address);
-				count++;
-				if (_usedAddrs.find(address) != _usedAddrs.end()) i = count;
 			}
 
 			if (i + gapLimit <= count) {
@@ -198,61 +195,88 @@ namespace Elastos {
 		}
 
 		void SubAccount::SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const {
-			std::string addr;
+			ErrorChecker::CheckParam(_parent->Readonly(), Error::Sign, "Readonly wallet can not sign tx");
+
+			DerivedKeyCache keyCache(_parent->RootKey(payPasswd));
+			SignTransaction(tx, keyCache);
+		}
+
+		void SubAccount::SignTransactions(const std::vector<TransactionPtr> &txs, const std::string &payPasswd) const {
+			ErrorChecker::CheckParam(_parent->Readonly(), Error::Sign, "Readonly wallet can not sign tx");
+
+			if (txs.empty())
+				return;
+
+			// unlock once for the whole batch, the derived keys are shared by all signing threads
+			DerivedKeyCache keyCache(_parent->RootKey(payPasswd));
+
+			size_t threadCount = std::max(1u, boost::thread::hardware_concurrency());
+			threadCount = std::min(threadCount, txs.size());
+
+			std::atomic<size_t> next(0);
+			boost::mutex errorLock;
+			std::exception_ptr error;
+
+			boost::function<void()> worker = [&]() {
+				for (size_t i = next++; i < txs.size(); i = next++) {
+					try {
+						SignTransaction(txs[i], keyCache);
+					} catch (...) {
+						boost::mutex::scoped_lock scopedLock(errorLock);
+						if (!error)
+							error = std::current_exception();
+						next = txs.size();
+					}
+				}
+			};
+
+			boost::thread_group workers;
+			for (size_t i = 1; i < threadCount; ++i)
+				workers.create_thread(worker);
+			worker();
+			workers.join_all();
+
+			SPVLOG_DEBUG("signed {} txs with {} threads, {} derived keys", txs.size(), threadCount, keyCache.Size());
+
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		void SubAccount::SignTransaction(const TransactionPtr &tx, DerivedKeyCache &keyCache) const {
 			Key key;
 			bytes_t signature;
 			ByteStream stream;
 
-			ErrorChecker::CheckParam(_parent->Readonly(), Error::Sign, "Readonly wallet can not sign tx");
 			ErrorChecker::CheckParam(tx->IsSigned(), Error::AlreadySigned, "Transaction signed");
 			ErrorChecker::CheckParam(tx->GetPrograms().empty(), Error::InvalidTransaction,
 			                         "Invalid transaction program");
 
 			uint256 md = tx->GetShaData();
 
-			HDKeychainPtr rootKey = _parent->RootKey(payPasswd);
-			std::vector<bytes_t> publicKeys;
+			std::vector<SmallBytes> publicKeys;
 			const std::vector<ProgramPtr> &programs = tx->GetPrograms();
 			for (size_t i = 0; i < programs.size(); ++i) {
 				publicKeys.clear();
 				SignType type = programs[i]->DecodePublicKey(publicKeys);
 				ErrorChecker::CheckLogic(type != SignTypeMultiSign && type != SignTypeStandard, Error::InvalidArgument,
 										 "Invalid redeem script");
-				ErrorChecker::CheckLogic(programs[i]->GetPath().empty(), Error::UnSupportOldTx, "Unsupport old tx");
+				const std::string &path = programs[i]->GetPath();
+				ErrorChecker::CheckLogic(path.empty(), Error::UnSupportOldTx, "Unsupport old tx");
 
 				bool found = false;
 				if (type == SignTypeStandard) {
-					key = rootKey->getChild(programs[i]->GetPath());
-					for (size_t k = 0; !found && k < publicKeys.size(); ++k) {
-						if (publicKeys[k] == key.PubKey()) {
-							found = true;
-						}
-					}
+					found = keyCache.FindKey(path, publicKeys, key);
 				} else if (type == SignTypeMultiSign) {
 					if (_parent->GetSignType() == Account::MultiSign) {
 						if (_parent->DerivationStrategy() == "BIP44")
-							key = rootKey->getChild("44'/0'/0'").getChild(programs[i]->GetPath());
+							found = keyCache.FindKey("44'/0'/0'/" + path, publicKeys, key);
 						else
-							key = rootKey->getChild("45'").getChild((uint32_t) _parent->CosignerIndex()).getChild(programs[i]->GetPath());
-						for (size_t k = 0; !found && k < publicKeys.size(); ++k) {
-							if (publicKeys[k] == key.PubKey()) {
-								found = true;
-							}
-						}
+							found = keyCache.FindKey("45'/" + std::to_string((uint32_t) _parent->CosignerIndex()) + "/" + path,
+							                         publicKeys, key);
 					} else {
-						key = rootKey->getChild("44'/0'/0'").getChild(programs[i]->GetPath());
-						for (size_t k = 0; !found && k < publicKeys.size(); ++k) {
-							if (publicKeys[k] == key.PubKey()) {
-								found = true;
-							}
-						}
+						found = keyCache.FindKey("44'/0'/0'/" + path, publicKeys, key);
 						for (uint32_t idx = 0; !found && idx < MAX_MULTISIGN_COSIGNERS; ++idx) {
-							key = rootKey->getChild("45'").getChild(idx).getChild(programs[i]->GetPath());
-							for (size_t k = 0; !found && k < publicKeys.size(); ++k) {
-								if (publicKeys[k] == key.PubKey()) {
-									found = true;
-								}
-							}
+							found = keyCache.FindKey("45'/" + std::to_string(idx) + "/" + path, publicKeys, key);
 						}
 					}
 				}
@@ -261,7 +285,7 @@ namespace Elastos {
 
 				stream.Reset();
 				if (programs[i]->GetParameter().size() > 0) {
-					ByteStream verifyStream(programs[i]->GetParameter());
+					ByteStreamView verifyStream(programs[i]->GetParameter());
 					while (verifyStream.ReadVarBytes(signature)) {
 						ErrorChecker::CheckLogic(key.Verify(md, signature), Error::AlreadySigned, "Already signed");
 					}
@@ -329,7 +353,7 @@ namespace Elastos {
 			bytes_t pubkey;
 
 			for (size_t i = start, cnt = 0; i < maxCount && cnt < count; ++i, ++cnt) {
-				ByteStream stream(allAddress[i]->RedeemScript());
+				ByteStreamView stream(allAddress[i]->RedeemScript());
 				stream.ReadVarBytes(pubkey);
 				pubkeys.push_back(pubkey);
 			}
@@ -17,6 +17,7 @@ namespace Elastos {
 
 		class Transaction;
 		typedef boost::shared_ptr<Transaction> TransactionPtr;
+		class DerivedKeyCache;
 
 		class SubAccount : public ISubAccount {
 		public:
@@ -57,6 +58,8 @@ namespace Elastos {
 
 			void SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const;
 
+			void SignTransactions(const std::vector<TransactionPtr> &txs, const std::string &payPasswd) const;
+
 			Key GetKeyWithDID(const AddressPtr &did, const std::string &payPasswd) const;
 
 			Key DeriveOwnerKey(const std::string &payPasswd);
@@ -70,6 +73,9 @@ namespace Elastos {
 			size_t ExternalChainIndex(const TransactionPtr &tx) const;
 
 			AccountPtr Parent() const;
+		private:
+			void SignTransaction(const TransactionPtr &tx, DerivedKeyCache &keyCache) const;
+
 		private:
 			uint32_t _coinIndex;
 			AddressArray _internalChain, _externalChain, _did;
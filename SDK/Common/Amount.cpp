@@ -0,0 +1,182 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "Amount.h"
+#include "BigInt.h"
+#include "ErrorChecker.h"
+
+#include <algorithm>
+
+#define AMOUNT_DEC_CHUNK 1000000000
+#define AMOUNT_DEC_CHUNK_DIGITS 9
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		static void Mul64(uint64_t a, uint64_t b, uint64_t &hi, uint64_t &lo) {
+			uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+			uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+			uint64_t p0 = aLo * bLo, p1 = aLo * bHi, p2 = aHi * bLo, p3 = aHi * bHi;
+			uint64_t mid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+
+			lo = (mid << 32) | (p0 & 0xffffffff);
+			hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+		}
+
+		Amount::Amount(const BigInt &value) : _hi(0), _lo(0) {
+			if (value < BigInt(0))
+				Overflow("negative BigInt");
+			setHexBytes(value.getHexBytes());
+		}
+
+		Amount &Amount::operator*=(const Amount &rhs) {
+			if (_hi != 0 && rhs._hi != 0)
+				Overflow("mul");
+
+			uint64_t hi, lo, crossHi, crossLo;
+			Mul64(_lo, rhs._lo, hi, lo);
+			Mul64(_hi != 0 ? _hi : rhs._hi, _hi != 0 ? rhs._lo : _lo, crossHi, crossLo);
+			if (crossHi != 0 || hi + crossLo < hi)
+				Overflow("mul");
+
+			_hi = hi + crossLo;
+			_lo = lo;
+			return *this;
+		}
+
+		Amount &Amount::operator/=(const Amount &rhs) {
+			if (rhs.isZero())
+				Overflow("div");
+
+			if (_hi == 0 && rhs._hi == 0) {
+				_lo /= rhs._lo;
+				return *this;
+			}
+
+			Amount q, r;
+			for (int i = 127; i >= 0; --i) {
+				bool top = (r._hi >> 63) != 0;
+				r._hi = (r._hi << 1) | (r._lo >> 63);
+				r._lo = (r._lo << 1) | ((i >= 64 ? _hi >> (i - 64) : _lo >> i) & 1);
+				if (top || r >= rhs) {
+					uint64_t borrow = r._lo < rhs._lo ? 1 : 0;
+					r._lo -= rhs._lo;
+					r._hi = r._hi - rhs._hi - borrow;
+					if (i >= 64)
+						q._hi |= uint64_t(1) << (i - 64);
+					else
+						q._lo |= uint64_t(1) << i;
+				}
+			}
+
+			*this = q;
+			return *this;
+		}
+
+		Amount &Amount::operator%=(const Amount &rhs) {
+			Amount q = *this / rhs;
+			return *this -= q * rhs;
+		}
+
+		uint64_t Amount::getUint64() const {
+			if (_hi != 0)
+				Overflow("getUint64");
+			return _lo;
+		}
+
+		bytes_t Amount::getHexBytes(bool littleEndian) const {
+			bytes_t bytes;
+			bytes.reserve(sizeof(_hi) + sizeof(_lo));
+
+			for (int i = 15; i >= 0; --i) {
+				uint8_t b = (uint8_t) (i >= 8 ? _hi >> ((i - 8) * 8) : _lo >> (i * 8));
+				if (b != 0 || !bytes.empty())
+					bytes.push_back(b);
+			}
+
+			if (bytes.empty())
+				bytes.push_back(0);
+
+			if (littleEndian)
+				std::reverse(bytes.begin(), bytes.end());
+
+			return bytes;
+		}
+
+		void Amount::setHexBytes(const bytes_t &bytes, bool littleEndian) {
+			uint64_t hi = 0, lo = 0;
+			size_t n = 0;
+
+			for (size_t i = 0; i < bytes.size(); ++i) {
+				uint8_t b = bytes[littleEndian ? bytes.size() - 1 - i : i];
+				if (b == 0 && n == 0)
+					continue;
+				if (++n > sizeof(_hi) + sizeof(_lo))
+					Overflow("setHexBytes");
+				hi = (hi << 8) | (lo >> 56);
+				lo = (lo << 8) | b;
+			}
+
+			_hi = hi;
+			_lo = lo;
+		}
+
+		std::string Amount::getDec() const {
+			if (_hi == 0)
+				return std::to_string(_lo);
+
+			Amount value(*this);
+			std::string dec;
+			while (!value.isZero()) {
+				std::string chunk = std::to_string(value.DivSmall(AMOUNT_DEC_CHUNK));
+				if (!value.isZero())
+					chunk.insert(0, AMOUNT_DEC_CHUNK_DIGITS - chunk.size(), '0');
+				dec.insert(0, chunk);
+			}
+
+			return dec;
+		}
+
+		void Amount::setDec(const std::string &dec) {
+			if (dec.empty())
+				ErrorChecker::ThrowLogicException(Error::BigInt, "invalid amount: empty");
+
+			Amount value;
+			for (size_t i = 0; i < dec.size(); ++i) {
+				if (dec[i] < '0' || dec[i] > '9')
+					ErrorChecker::ThrowLogicException(Error::BigInt, "invalid amount: " + dec);
+				value *= 10;
+				value += (uint64_t) (dec[i] - '0');
+			}
+
+			*this = value;
+		}
+
+		BigInt Amount::getBigInt() const {
+			BigInt value;
+			value.setHexBytes(getHexBytes());
+			return value;
+		}
+
+		void Amount::Overflow(const char *op) {
+			ErrorChecker::ThrowLogicException(Error::BigInt, std::string("amount overflow: ") + op);
+		}
+
+		uint32_t Amount::DivSmall(uint32_t divisor) {
+			uint64_t parts[4] = {_hi >> 32, _hi & 0xffffffff, _lo >> 32, _lo & 0xffffffff};
+			uint64_t rem = 0;
+
+			for (int i = 0; i < 4; ++i) {
+				uint64_t cur = (rem << 32) | parts[i];
+				parts[i] = cur / divisor;
+				rem = cur % divisor;
+			}
+
+			_hi = (parts[0] << 32) | parts[1];
+			_lo = (parts[2] << 32) | parts[3];
+			return (uint32_t) rem;
+		}
+
+	}
+}
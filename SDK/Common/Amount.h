@@ -0,0 +1,112 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_AMOUNT_H__
+#define __ELASTOS_SDK_AMOUNT_H__
+
+#include "typedefs.h"
+
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		class BigInt;
+
+		/*
+		 * Unsigned 128-bit amount held by value in two 64-bit limbs, so it needs no heap and also builds
+		 * on 32-bit targets without __int128. Arithmetic that overflows, underflows or divides by zero
+		 * throws. Accessors mirror BigInt, and getHexBytes/setHexBytes produce the same bytes.
+		 */
+		class Amount {
+		public:
+			Amount() : _hi(0), _lo(0) {}
+
+			Amount(uint64_t value) : _hi(0), _lo(value) {}
+
+			explicit Amount(const BigInt &value);
+
+			Amount &operator+=(const Amount &rhs) {
+				uint64_t lo = _lo + rhs._lo;
+				uint64_t carry = lo < _lo ? 1 : 0;
+				uint64_t hi = _hi + rhs._hi;
+				if (hi < _hi || hi + carry < hi)
+					Overflow("add");
+				_hi = hi + carry;
+				_lo = lo;
+				return *this;
+			}
+
+			Amount &operator-=(const Amount &rhs) {
+				if (*this < rhs)
+					Overflow("sub");
+				uint64_t borrow = _lo < rhs._lo ? 1 : 0;
+				_lo -= rhs._lo;
+				_hi = _hi - rhs._hi - borrow;
+				return *this;
+			}
+
+			Amount &operator*=(const Amount &rhs);
+
+			Amount &operator/=(const Amount &rhs);
+
+			Amount &operator%=(const Amount &rhs);
+
+			Amount operator+(const Amount &rhs) const { return Amount(*this) += rhs; }
+
+			Amount operator-(const Amount &rhs) const { return Amount(*this) -= rhs; }
+
+			Amount operator*(const Amount &rhs) const { return Amount(*this) *= rhs; }
+
+			Amount operator/(const Amount &rhs) const { return Amount(*this) /= rhs; }
+
+			Amount operator%(const Amount &rhs) const { return Amount(*this) %= rhs; }
+
+			bool operator==(const Amount &rhs) const { return _hi == rhs._hi && _lo == rhs._lo; }
+
+			bool operator!=(const Amount &rhs) const { return !(*this == rhs); }
+
+			bool operator<(const Amount &rhs) const { return _hi < rhs._hi || (_hi == rhs._hi && _lo < rhs._lo); }
+
+			bool operator>(const Amount &rhs) const { return rhs < *this; }
+
+			bool operator<=(const Amount &rhs) const { return !(rhs < *this); }
+
+			bool operator>=(const Amount &rhs) const { return !(*this < rhs); }
+
+			bool isZero() const { return _hi == 0 && _lo == 0; }
+
+			// Throws if the amount does not fit in 64 bits.
+			uint64_t getUint64() const;
+
+			void setUint64(uint64_t value) {
+				_hi = 0;
+				_lo = value;
+			}
+
+			// Minimal big endian bytes as BigInt::getHexBytes, zero is a single 0x00 byte.
+			bytes_t getHexBytes(bool littleEndian = false) const;
+
+			void setHexBytes(const bytes_t &bytes, bool littleEndian = false);
+
+			std::string getDec() const;
+
+			void setDec(const std::string &dec);
+
+			BigInt getBigInt() const;
+
+		private:
+			static void Overflow(const char *op);
+
+			// Divides in place by a divisor below 2^32 and returns the remainder.
+			uint32_t DivSmall(uint32_t divisor);
+
+		private:
+			uint64_t _hi, _lo;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_AMOUNT_H__
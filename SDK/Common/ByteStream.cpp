@@ -4,124 +4,112 @@
 
 #include "ByteStream.h"
 
+#include <cstring>
+
 namespace Elastos {
 	namespace ElaWallet {
-		ByteStream::ByteStream() : _rpos(0) {
+		ByteStreamView::ByteStreamView() : _data(nullptr), _size(0), _rpos(0) {
 
 		}
 
-		ByteStream::ByteStream(const void *buf, size_t size) : _rpos(0), _buf((const unsigned char *) buf, size) {
+		ByteStreamView::ByteStreamView(const void *buf, size_t size) :
+			_data((const uint8_t *) buf), _size(size), _rpos(0) {
 
 		}
 
-		ByteStream::ByteStream(const bytes_t &buf) : _rpos(0), _buf(buf) {
+		ByteStreamView::ByteStreamView(const bytes_t &buf) : _data(buf.data()), _size(buf.size()), _rpos(0) {
 
 		}
 
-		ByteStream::~ByteStream() {
+		ByteStreamView::ByteStreamView(const SmallBytes &buf) : _data(buf.data()), _size(buf.size()), _rpos(0) {
 
 		}
 
-		void ByteStream::Reset() {
-			_rpos = 0;
-			_buf.clear();
+		uint64_t ByteStreamView::size() const {
+			return _size;
 		}
 
-		void ByteStream::clear() {
-			_rpos = 0;
-			_buf.clear();
-		}
-
-		uint64_t ByteStream::size() const {
-			return _buf.size();
-		}
-
-		void ByteStream::Skip(size_t bytes) const {
-			if (_rpos + bytes <= _buf.size())
+		void ByteStreamView::Skip(size_t bytes) const {
+			if (_rpos + bytes <= _size)
 				_rpos += bytes;
 		}
 
-		const bytes_t &ByteStream::GetBytes() const {
-			return _buf;
-		}
-
-		bool ByteStream::ReadByte(uint8_t &val) const {
+		bool ByteStreamView::ReadByte(uint8_t &val) const {
 			return ReadBytes(&val, 1);
 		}
 
-		bool ByteStream::ReadUint8(uint8_t &val) const {
+		bool ByteStreamView::ReadUint8(uint8_t &val) const {
 			return ReadBytes(&val, 1);
 		}
 
-		bool ByteStream::ReadUint16(uint16_t &val) const {
+		bool ByteStreamView::ReadUint16(uint16_t &val) const {
 			return ReadBytes(&val, sizeof(uint16_t));
 		}
 
-		bool ByteStream::ReadUint32(uint32_t &val) const {
+		bool ByteStreamView::ReadUint32(uint32_t &val) const {
 			return ReadBytes(&val, sizeof(uint32_t));
 		}
 
-		bool ByteStream::ReadUint64(uint64_t &val) const {
+		bool ByteStreamView::ReadUint64(uint64_t &val) const {
 			return ReadBytes(&val, sizeof(uint64_t));
 		}
 
-		bool ByteStream::ReadBytes(void *buf, size_t len) const {
-			if (_rpos + len > _buf.size())
+		bool ByteStreamView::ReadBytes(void *buf, size_t len) const {
+			if (_rpos + len > _size)
 				return false;
 
-			memcpy(buf, &_buf[_rpos], len);
+			memcpy(buf, &_data[_rpos], len);
 			_rpos += len;
 
 			return true;
 		}
 
-		bool ByteStream::ReadBytes(bytes_t &bytes, size_t len) const {
-			if (_rpos + len > _buf.size())
+		bool ByteStreamView::ReadBytes(bytes_t &bytes, size_t len) const {
+			if (_rpos + len > _size)
 				return false;
 
-			bytes.assign(_buf.begin() + _rpos, _buf.begin() + _rpos + len);
+			bytes.assign(_data + _rpos, _data + _rpos + len);
 
 			_rpos += len;
 			return true;
 		}
 
-		bool ByteStream::ReadBytes(uint128 &u) const {
-			if (_rpos + u.size() > _buf.size())
+		bool ByteStreamView::ReadBytes(SmallBytes &bytes, size_t len) const {
+			if (_rpos + len > _size)
 				return false;
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
-			_rpos += u.size();
+			bytes.assign(_data + _rpos, len);
+
+			_rpos += len;
 			return true;
 		}
 
-		bool ByteStream::ReadBytes(uint160 &u) const {
-			if (_rpos + u.size() > _buf.size())
-				return false;
+		bool ByteStreamView::ReadBytes(uint128 &u) const {
+			return ReadBytes(u.begin(), u.size());
+		}
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
-			_rpos += u.size();
-			return true;
+		bool ByteStreamView::ReadBytes(uint160 &u) const {
+			return ReadBytes(u.begin(), u.size());
 		}
 
-		bool ByteStream::ReadBytes(uint168 &u) const {
-			if (_rpos + u.size() > _buf.size())
-				return false;
+		bool ByteStreamView::ReadBytes(uint168 &u) const {
+			return ReadBytes(u.begin(), u.size());
+		}
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
-			_rpos += u.size();
-			return true;
+		bool ByteStreamView::ReadBytes(uint256 &u) const {
+			return ReadBytes(u.begin(), u.size());
 		}
 
-		bool ByteStream::ReadBytes(uint256 &u) const {
-			if (_rpos + u.size() > _buf.size())
+		bool ByteStreamView::ReadVarBytes(bytes_t &bytes) const {
+			uint64_t length = 0;
+			if (!ReadVarUint(length)) {
 				return false;
+			}
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
-			_rpos += u.size();
-			return true;
+			return ReadBytes(bytes, length);
 		}
 
-		bool ByteStream::ReadVarBytes(bytes_t &bytes) const {
+		bool ByteStreamView::ReadVarBytes(SmallBytes &bytes) const {
 			uint64_t length = 0;
 			if (!ReadVarUint(length)) {
 				return false;
@@ -130,32 +118,32 @@ namespace Elastos {
 			return ReadBytes(bytes, length);
 		}
 
-		bool ByteStream::ReadVarUint(uint64_t &len) const {
-			if (_rpos + 1 > _buf.size())
+		bool ByteStreamView::ReadVarUint(uint64_t &len) const {
+			if (_rpos + 1 > _size)
 				return false;
 
-			uint8_t h = _buf[_rpos++];
+			uint8_t h = _data[_rpos++];
 
 			switch (h) {
-				case VAR_INT16_HEADER:
-					if (_rpos + 2 > _buf.size())
+				case VAR_INT16_HEADER: {
+					uint16_t v;
+					if (!ReadBytes(&v, sizeof(v)))
 						return false;
-					len = *(uint16_t *) &_buf[_rpos];
-					_rpos += 2;
+					len = v;
 					break;
+				}
 
-				case VAR_INT32_HEADER:
-					if (_rpos + 4 > _buf.size())
+				case VAR_INT32_HEADER: {
+					uint32_t v;
+					if (!ReadBytes(&v, sizeof(v)))
 						return false;
-					len = *(uint32_t *) &_buf[_rpos];
-					_rpos += 4;
+					len = v;
 					break;
+				}
 
 				case VAR_INT64_HEADER:
-					if (_rpos + 8 > _buf.size())
+					if (!ReadBytes(&len, sizeof(len)))
 						return false;
-					len = *(uint64_t *) &_buf[_rpos];
-					_rpos += 8;
 					break;
 
 				default:
@@ -166,88 +154,174 @@ namespace Elastos {
 			return true;
 		}
 
-		bool ByteStream::ReadVarString(std::string &str) const {
-			bytes_t bytes;
-			if (!ReadVarBytes(bytes)) {
+		bool ByteStreamView::ReadVarString(std::string &str) const {
+			uint64_t length = 0;
+			if (!ReadVarUint(length) || length > _size - _rpos)
 				return false;
-			}
-			str = std::string((const char *) bytes.data(), bytes.size());
+
+			str.assign((const char *) _data + _rpos, length);
+			_rpos += length;
 
 			return true;
 		}
 
+		ByteStream::ByteStream() : _mode(Store), _counted(0) {
+
+		}
+
+		ByteStream::ByteStream(Mode mode) : _mode(mode), _counted(0) {
+
+		}
+
+		ByteStream::ByteStream(const void *buf, size_t size) :
+			_buf((const unsigned char *) buf, size), _mode(Store), _counted(0) {
+			Sync();
+		}
+
+		ByteStream::ByteStream(const bytes_t &buf) : _buf(buf), _mode(Store), _counted(0) {
+			Sync();
+		}
+
+		ByteStream::ByteStream(const ByteStream &stream) :
+			ByteStreamView(), _buf(stream._buf), _mode(stream._mode), _counted(stream._counted) {
+			_rpos = stream._rpos;
+			Sync();
+		}
+
+		ByteStream &ByteStream::operator=(const ByteStream &stream) {
+			_buf = stream._buf;
+			_mode = stream._mode;
+			_counted = stream._counted;
+			_rpos = stream._rpos;
+			Sync();
+			return *this;
+		}
+
+		ByteStream::~ByteStream() {
+
+		}
+
+		void ByteStream::Reset() {
+			_rpos = 0;
+			_counted = 0;
+			_buf.clear();
+			Sync();
+		}
+
+		void ByteStream::clear() {
+			_rpos = 0;
+			_counted = 0;
+			_buf.clear();
+			Sync();
+		}
+
+		const bytes_t &ByteStream::GetBytes() const {
+			return _buf;
+		}
+
+		bytes_t ByteStream::ReleaseBytes() {
+			bytes_t bytes;
+			bytes.swap(_buf);
+			Reset();
+			return bytes;
+		}
+
+		size_t ByteStream::WrittenSize() const {
+			return _mode == CountOnly ? _counted : _buf.size();
+		}
+
+		void ByteStream::Reserve(size_t size) {
+			if (_mode == Store) {
+				_buf.reserve(size);
+				Sync();
+			}
+		}
+
 		void ByteStream::WriteByte(uint8_t val) {
-			_buf.push_back(val);
+			Append(&val, 1);
 		}
 
 		void ByteStream::WriteUint8(uint8_t val) {
-			_buf.push_back(val);
+			Append(&val, 1);
 		}
 
 		void ByteStream::WriteUint16(uint16_t val) {
-			WriteBytes(&val, sizeof(uint16_t));
+			Append(&val, sizeof(uint16_t));
 		}
 
 		void ByteStream::WriteUint32(uint32_t val) {
-			WriteBytes(&val, sizeof(uint32_t));
+			Append(&val, sizeof(uint32_t));
 		}
 
 		void ByteStream::WriteUint64(uint64_t val) {
-			WriteBytes(&val, sizeof(uint64_t));
+			Append(&val, sizeof(uint64_t));
 		}
 
 		void ByteStream::WriteBytes(const void *buf, size_t len) {
-			_buf += bytes_t(buf, len);
+			Append(buf, len);
 		}
 
 		void ByteStream::WriteBytes(const bytes_t &bytes) {
-			_buf += bytes;
+			Append(bytes.data(), bytes.size());
+		}
+
+		void ByteStream::WriteBytes(const SmallBytes &bytes) {
+			Append(bytes.data(), bytes.size());
 		}
 
 		void ByteStream::WriteBytes(const uint128 &u) {
-			_buf += u.bytes();
+			Append(u.begin(), u.size());
 		}
 
 		void ByteStream::WriteBytes(const uint160 &u) {
-			_buf += u.bytes();
+			Append(u.begin(), u.size());
 		}
 
 		void ByteStream::WriteBytes(const uint168 &u) {
-			_buf += u.bytes();
+			Append(u.begin(), u.size());
 		}
 
 		void ByteStream::WriteBytes(const uint256 &u) {
-			_buf += u.bytes();
+			Append(u.begin(), u.size());
 		}
 
 		void ByteStream::WriteVarBytes(const void *bytes, size_t len) {
 			WriteVarUint((uint64_t) len);
-			WriteBytes(bytes, len);
+			Append(bytes, len);
 		}
 
 		void ByteStream::WriteVarBytes(const bytes_t &bytes) {
 			WriteVarUint((uint64_t) bytes.size());
-			WriteBytes(bytes);
+			Append(bytes.data(), bytes.size());
+		}
+
+		void ByteStream::WriteVarBytes(const SmallBytes &bytes) {
+			WriteVarUint((uint64_t) bytes.size());
+			Append(bytes.data(), bytes.size());
+		}
+
+		size_t ByteStream::VarUintSize(uint64_t len) {
+			if (len < VAR_INT16_HEADER)
+				return 1;
+			else if (len <= UINT16_MAX)
+				return 1 + sizeof(uint16_t);
+			else if (len <= UINT32_MAX)
+				return 1 + sizeof(uint32_t);
+			return 1 + sizeof(uint64_t);
 		}
 
 		size_t ByteStream::WriteVarUint(uint64_t len) {
-			size_t count;
-			if (len < VAR_INT16_HEADER) {
-				_buf.push_back((uint8_t) len);
-				count = 1;
-			} else if (len <= UINT16_MAX) {
-				_buf.push_back(VAR_INT16_HEADER);
-				_buf += bytes_t((unsigned char *) &len, 2);
-				count = 2;
-			} else if (len <= UINT32_MAX) {
-				_buf.push_back(VAR_INT32_HEADER);
-				_buf += bytes_t((unsigned char *) &len, 4);
-				count = 4;
+			uint8_t buf[1 + sizeof(uint64_t)];
+			size_t count = VarUintSize(len);
+
+			if (count == 1) {
+				buf[0] = (uint8_t) len;
 			} else {
-				_buf.push_back(VAR_INT64_HEADER);
-				_buf += bytes_t((unsigned char *) &len, 8);
-				count = 8;
+				buf[0] = count == 3 ? VAR_INT16_HEADER : count == 5 ? VAR_INT32_HEADER : VAR_INT64_HEADER;
+				memcpy(&buf[1], &len, count - 1);
 			}
+
+			Append(buf, count);
 			return count;
 		}
 
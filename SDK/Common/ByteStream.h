@@ -6,6 +6,7 @@
 #define __ELASTOS_SDK_BYTESTREAM_H__
 
 #include "typedefs.h"
+#include "SmallBytes.h"
 #include "uint256.h"
 
 #include <iostream>
@@ -15,32 +16,29 @@
 namespace Elastos {
 	namespace ElaWallet {
 
-		class ByteStream {
-		public:
-
 #define VAR_INT16_HEADER  0xfd
 #define VAR_INT32_HEADER  0xfe
 #define VAR_INT64_HEADER  0xff
 #define MAX_SCRIPT_LENGTH 0x100 // scripts over this size will not be parsed for an address
 
-			ByteStream();
-
-			ByteStream(const void *buf, size_t size);
-
-			explicit ByteStream(const bytes_t &buf);
+		/*
+		 * Read-only cursor over borrowed memory, the memory must outlive the view. Deserialize methods take
+		 * a view, so a sqlite blob or a received message is parsed in place instead of being copied first.
+		 */
+		class ByteStreamView {
+		public:
+			ByteStreamView();
 
-			~ByteStream();
+			ByteStreamView(const void *buf, size_t size);
 
-			void Reset();
+			explicit ByteStreamView(const bytes_t &buf);
 
-			void clear();
+			explicit ByteStreamView(const SmallBytes &buf);
 
 			uint64_t size() const;
 
 			void Skip(size_t bytes = 1) const;
 
-			const bytes_t &GetBytes() const;
-
 			bool ReadByte(uint8_t &val) const;
 
 			bool ReadUint8(uint8_t &val) const;
@@ -55,6 +53,8 @@ namespace Elastos {
 
 			bool ReadBytes(bytes_t &bytes, size_t len) const;
 
+			bool ReadBytes(SmallBytes &bytes, size_t len) const;
+
 			bool ReadBytes(uint128 &u) const;
 
 			bool ReadBytes(uint160 &u) const;
@@ -65,10 +65,76 @@ namespace Elastos {
 
 			bool ReadVarBytes(bytes_t &bytes) const;
 
+			bool ReadVarBytes(SmallBytes &bytes) const;
+
 			bool ReadVarUint(uint64_t &len) const;
 
 			bool ReadVarString(std::string &str) const;
 
+		protected:
+			void Attach(const void *buf, size_t size) {
+				_data = (const uint8_t *) buf;
+				_size = size;
+			}
+
+		protected:
+			const uint8_t *_data;
+			size_t _size;
+			mutable size_t _rpos;
+		};
+
+		class ByteStream : public ByteStreamView {
+		public:
+			enum Mode {
+				Store,
+				// writes only add up their size, for sizing a buffer before the real write
+				CountOnly
+			};
+
+		public:
+			ByteStream();
+
+			explicit ByteStream(Mode mode);
+
+			ByteStream(const void *buf, size_t size);
+
+			explicit ByteStream(const bytes_t &buf);
+
+			ByteStream(const ByteStream &stream);
+
+			ByteStream &operator=(const ByteStream &stream);
+
+			~ByteStream();
+
+			void Reset();
+
+			void clear();
+
+			const bytes_t &GetBytes() const;
+
+			// Moves the written bytes out and leaves the stream empty.
+			bytes_t ReleaseBytes();
+
+			// Bytes written so far, in either mode.
+			size_t WrittenSize() const;
+
+			void Reserve(size_t size);
+
+			/*
+			 * Runs write once on a CountOnly stream to find the exact size, reserves that, then runs it
+			 * again on this stream. The output is allocated once instead of growing as it is written.
+			 */
+			template<class Writer>
+			void WriteExact(const Writer &write) {
+				ByteStream counter(CountOnly);
+				write(counter);
+				Reserve(WrittenSize() + counter.WrittenSize());
+				write(*this);
+			}
+
+			// Encoded length of a var uint, the value WriteVarUint returns.
+			static size_t VarUintSize(uint64_t len);
+
 			void WriteByte(uint8_t val);
 
 			void WriteUint8(uint8_t val);
@@ -83,6 +149,8 @@ namespace Elastos {
 
 			void WriteBytes(const bytes_t &bytes);
 
+			void WriteBytes(const SmallBytes &bytes);
+
 			void WriteBytes(const uint128 &u);
 
 			void WriteBytes(const uint160 &u);
@@ -95,13 +163,34 @@ namespace Elastos {
 
 			void WriteVarBytes(const bytes_t &bytes);
 
+			void WriteVarBytes(const SmallBytes &bytes);
+
 			size_t WriteVarUint(uint64_t len);
 
 			void WriteVarString(const std::string &str);
 
 		private:
-			mutable size_t _rpos;
+			// Inline so a CountOnly pass costs little more than the calls that feed it.
+			void Append(const void *buf, size_t len) {
+				if (_mode == CountOnly) {
+					_counted += len;
+					return;
+				}
+
+				const uint8_t *p = (const uint8_t *) buf;
+				_buf.insert(_buf.end(), p, p + len);
+				Sync();
+			}
+
+			// Points the read side at _buf again, a write may have moved it.
+			void Sync() {
+				Attach(_buf.data(), _buf.size());
+			}
+
+		private:
 			bytes_t _buf;
+			Mode _mode;
+			size_t _counted;
 		};
 
 	}
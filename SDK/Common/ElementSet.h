@@ -5,47 +5,36 @@
 #ifndef __ELASTOS_SDK_TRANSACTIONSET_H__
 #define __ELASTOS_SDK_TRANSACTIONSET_H__
 
-#include <set>
+#include <Common/FlatHashMap.h>
 #include <Common/uint256.h>
 
 namespace Elastos {
 	namespace ElaWallet {
 
+		// Elements keyed by their hash, the hash of an element must not change while it is in the set.
 		template<class T>
 		class ElementSet {
 		public:
-			typedef struct {
-				bool operator() (const T &x, const T &y) const {
-					return x->GetHash() < y->GetHash();
-				}
-			} TCompare;
+			typedef FlatHashMap<uint256, T> ElementMap;
 
 			T Get(const uint256 &hash) const {
-				typename std::set<T, TCompare>::const_iterator it;
-				it = std::find_if(_elements.begin(), _elements.end(), [&hash](const T &e) {
-					return hash == e->GetHash();
-				});
-
+				typename ElementMap::const_iterator it = _elements.find(hash);
 				if (it == _elements.end())
 					return nullptr;
 
-				return *it;
-			}
-
-			std::set<T, TCompare> &Raw() {
-				return _elements;
+				return it->second;
 			}
 
 			bool Contains(const T &e) const {
-				return _elements.find(e) != _elements.end();
+				return _elements.count(e->GetHash()) > 0;
 			}
 
 			bool Contains(const uint256 &hash) const {
-				return Get(hash) != nullptr;
+				return _elements.count(hash) > 0;
 			}
 
 			bool Insert(const T &e) {
-				return _elements.insert(e).second;
+				return _elements.insert(std::make_pair(e->GetHash(), e)).second;
 			}
 
 			size_t Size() {
@@ -53,31 +42,21 @@ namespace Elastos {
 			}
 
 			bool Remove(const T &e) {
-				return _elements.erase(e) > 0;
+				return _elements.erase(e->GetHash()) > 0;
 			}
 
 			bool RemoveMatchPrevHash(const uint256 &hash) {
-				typename std::set<T, TCompare>::const_iterator it;
-				it = std::find_if(_elements.cbegin(), _elements.cend(), [&hash](const T &e) {
-					return hash == e->GetPrevBlockHash();
-				});
-
-				if (it != _elements.end()) {
-					_elements.erase(it);
-					return true;
-				}
-
-				return false;
+				T e = GetMatchPrevHash(hash);
+				return e != nullptr && Remove(e);
 			}
 
+			// Linear, only used on the small orphan set.
 			T GetMatchPrevHash(const uint256 &hash) const {
-				typename std::set<T, TCompare>::const_iterator it;
-				it = std::find_if(_elements.cbegin(), _elements.cend(), [&hash](const T &e) {
-					return hash == e->GetPrevBlockHash();
-				});
-
-				if (it != _elements.end())
-					return *it;
+				typename ElementMap::const_iterator it;
+				for (it = _elements.begin(); it != _elements.end(); ++it) {
+					if (hash == it->second->GetPrevBlockHash())
+						return it->second;
+				}
 
 				return nullptr;
 			}
@@ -87,7 +66,7 @@ namespace Elastos {
 			}
 
 		private:
-			std::set<T, TCompare> _elements;
+			ElementMap _elements;
 		};
 
 	}
@@ -0,0 +1,247 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_FLATHASHMAP_H__
+#define __ELASTOS_SDK_FLATHASHMAP_H__
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Open addressing hash table with linear probing, the entries sit in one array so a lookup
+		 * touches a cache line or two instead of walking tree nodes. The hash is mixed with a
+		 * multiplicative step before use, so std::hash of a uint256, which is just eight of its
+		 * bytes, is good enough. Erase shifts the following entries back, there are no tombstones.
+		 * Inserting or erasing invalidates iterators, and iteration order is unspecified.
+		 */
+		template<class Key, class Value, class KeyOf, class Hash, class Equal>
+		class FlatHashTable {
+		public:
+			typedef Key key_type;
+			typedef Value value_type;
+
+			template<class V, class Table>
+			class Iterator {
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef V value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef V *pointer;
+				typedef V &reference;
+
+				Iterator() : _table(nullptr), _pos(0) {}
+
+				Iterator(Table *table, size_t pos) : _table(table), _pos(pos) { SkipEmpty(); }
+
+				// iterator converts to const_iterator
+				template<class V2, class Table2>
+				Iterator(const Iterator<V2, Table2> &it) : _table(it._table), _pos(it._pos) {}
+
+				V &operator*() const { return _table->_slots[_pos]; }
+
+				V *operator->() const { return &_table->_slots[_pos]; }
+
+				Iterator &operator++() {
+					++_pos;
+					SkipEmpty();
+					return *this;
+				}
+
+				Iterator operator++(int) {
+					Iterator it(*this);
+					++*this;
+					return it;
+				}
+
+				bool operator==(const Iterator &it) const { return _pos == it._pos; }
+
+				bool operator!=(const Iterator &it) const { return _pos != it._pos; }
+
+			private:
+				template<class, class> friend class Iterator;
+
+				void SkipEmpty() {
+					while (_pos < _table->_used.size() && !_table->_used[_pos])
+						++_pos;
+				}
+
+				Table *_table;
+				size_t _pos;
+			};
+
+			typedef Iterator<Value, FlatHashTable> iterator;
+			typedef Iterator<const Value, const FlatHashTable> const_iterator;
+
+		public:
+			FlatHashTable() : _size(0), _shift(64) {}
+
+			iterator begin() { return iterator(this, 0); }
+
+			iterator end() { return iterator(this, _used.size()); }
+
+			const_iterator begin() const { return const_iterator(this, 0); }
+
+			const_iterator end() const { return const_iterator(this, _used.size()); }
+
+			size_t size() const { return _size; }
+
+			bool empty() const { return _size == 0; }
+
+			void clear() {
+				_slots.clear();
+				_used.clear();
+				_size = 0;
+				_shift = 64;
+			}
+
+			// Makes room for count entries without growing again.
+			void reserve(size_t count) {
+				size_t capacity = 16;
+				while (capacity - capacity / 4 < count)
+					capacity *= 2;
+				if (capacity > _used.size())
+					Rehash(capacity);
+			}
+
+			iterator find(const Key &key) {
+				return iterator(this, Find(key));
+			}
+
+			const_iterator find(const Key &key) const {
+				return const_iterator(this, Find(key));
+			}
+
+			size_t count(const Key &key) const {
+				return Find(key) != _used.size() ? 1 : 0;
+			}
+
+			std::pair<iterator, bool> insert(const Value &value) {
+				if (_size + 1 > _used.size() - _used.size() / 4)
+					reserve(_size + 1);
+
+				size_t pos = Home(KeyOf()(value));
+				while (_used[pos]) {
+					if (Equal()(KeyOf()(_slots[pos]), KeyOf()(value)))
+						return std::make_pair(iterator(this, pos), false);
+					pos = (pos + 1) & (_used.size() - 1);
+				}
+
+				_slots[pos] = value;
+				_used[pos] = 1;
+				++_size;
+				return std::make_pair(iterator(this, pos), true);
+			}
+
+			size_t erase(const Key &key) {
+				size_t pos = Find(key);
+				if (pos == _used.size())
+					return 0;
+
+				// pull back every following entry whose home is not between the hole and itself
+				size_t mask = _used.size() - 1;
+				size_t hole = pos;
+				for (size_t next = (hole + 1) & mask; _used[next]; next = (next + 1) & mask) {
+					size_t home = Home(KeyOf()(_slots[next]));
+					bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+					if (!stays) {
+						_slots[hole] = std::move(_slots[next]);
+						hole = next;
+					}
+				}
+
+				_slots[hole] = Value();
+				_used[hole] = 0;
+				--_size;
+				return 1;
+			}
+
+		protected:
+			size_t Home(const Key &key) const {
+				// Fibonacci hashing, the top bits of the product are well mixed
+				return (size_t) (((uint64_t) Hash()(key) * 0x9E3779B97F4A7C15ull) >> _shift);
+			}
+
+			size_t Find(const Key &key) const {
+				if (_size == 0)
+					return _used.size();
+
+				size_t pos = Home(key);
+				while (_used[pos]) {
+					if (Equal()(KeyOf()(_slots[pos]), key))
+						return pos;
+					pos = (pos + 1) & (_used.size() - 1);
+				}
+				return _used.size();
+			}
+
+			void Rehash(size_t capacity) {
+				std::vector<Value> slots(capacity);
+				std::vector<uint8_t> used(capacity, 0);
+				slots.swap(_slots);
+				used.swap(_used);
+
+				_shift = 64;
+				for (size_t c = capacity; c > 1; c >>= 1)
+					--_shift;
+
+				for (size_t i = 0; i < used.size(); ++i) {
+					if (used[i]) {
+						size_t pos = Home(KeyOf()(slots[i]));
+						while (_used[pos])
+							pos = (pos + 1) & (capacity - 1);
+						_slots[pos] = std::move(slots[i]);
+						_used[pos] = 1;
+					}
+				}
+			}
+
+		protected:
+			std::vector<Value> _slots;
+			std::vector<uint8_t> _used;
+			size_t _size;
+			unsigned _shift;
+		};
+
+		template<class Key, class T>
+		struct FlatMapKeyOf {
+			const Key &operator()(const std::pair<Key, T> &value) const { return value.first; }
+		};
+
+		template<class Key>
+		struct FlatSetKeyOf {
+			const Key &operator()(const Key &value) const { return value; }
+		};
+
+		/*
+		 * Map on top of FlatHashTable. The value type is std::pair<Key, T> rather than pair<const Key, T>
+		 * so slots can be moved around, the key must not be changed through an iterator.
+		 */
+		template<class Key, class T, class Hash = std::hash<Key>, class Equal = std::equal_to<Key> >
+		class FlatHashMap : public FlatHashTable<Key, std::pair<Key, T>, FlatMapKeyOf<Key, T>, Hash, Equal> {
+		public:
+			typedef T mapped_type;
+
+			T &operator[](const Key &key) {
+				typename FlatHashMap::iterator it = this->find(key);
+				if (it == this->end())
+					it = this->insert(std::make_pair(key, T())).first;
+				return it->second;
+			}
+		};
+
+		template<class Key, class Hash = std::hash<Key>, class Equal = std::equal_to<Key> >
+		class FlatHashSet : public FlatHashTable<Key, Key, FlatSetKeyOf<Key>, Hash, Equal> {
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_FLATHASHMAP_H__
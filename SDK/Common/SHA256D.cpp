@@ -0,0 +1,321 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "SHA256D.h"
+#include "hash.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SHA256D_MULTI_BUFFER
+#endif
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		namespace {
+
+			void HashPairsOpenSSL(uint256 *out, const uint256 *in, size_t count) {
+				for (size_t i = 0; i < count; ++i)
+					sha256_2(in[2 * i], in[2 * i + 1], out[i]);
+			}
+
+			void HashOpenSSL(uint256 *out, const bytes_t *messages, size_t count) {
+				for (size_t i = 0; i < count; ++i)
+					sha256_2(messages[i].data(), messages[i].size(), out[i]);
+			}
+
+#ifdef SHA256D_MULTI_BUFFER
+
+			const uint32_t K[64] = {
+				0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+				0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+				0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+				0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+				0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+				0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+				0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+				0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+			};
+
+			const uint32_t IV[8] = {
+				0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+			};
+
+			typedef uint32_t v4u32 __attribute__((vector_size(16)));
+			typedef uint32_t v8u32 __attribute__((vector_size(32)));
+
+			inline uint32_t ReadBE32(const uint8_t *p) {
+				return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+			}
+
+			inline void WriteBE32(uint8_t *p, uint32_t x) {
+				p[0] = (uint8_t) (x >> 24);
+				p[1] = (uint8_t) (x >> 16);
+				p[2] = (uint8_t) (x >> 8);
+				p[3] = (uint8_t) x;
+			}
+
+			// The kernels below are written once over a generic vector type V of N uint32 lanes and instantiated
+			// from functions carrying the matching target attribute, so the compiler emits SSE4.1 or AVX2 code.
+
+			// macros rather than helpers: a function passing V by value would change the ABI outside the target
+#define ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define SPLAT(x) (V{} + (uint32_t) (x))
+
+			// one sha256 compression of a 64-byte block per lane
+			template<typename V>
+			__attribute__((always_inline)) inline void Transform(V s[8], V w[16]) {
+				V a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+				for (int i = 0; i < 64; ++i) {
+					V wi;
+					if (i < 16) {
+						wi = w[i];
+					} else {
+						V w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+						V s0 = ROR(w15, 7) ^ ROR(w15, 18) ^ (w15 >> 3);
+						V s1 = ROR(w2, 17) ^ ROR(w2, 19) ^ (w2 >> 10);
+						wi = w[i & 15] = w[i & 15] + s0 + w[(i - 7) & 15] + s1;
+					}
+
+					V t1 = h + (ROR(e, 6) ^ ROR(e, 11) ^ ROR(e, 25)) + ((e & f) ^ (~e & g)) + SPLAT(K[i]) + wi;
+					V t2 = (ROR(a, 2) ^ ROR(a, 13) ^ ROR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+					h = g;
+					g = f;
+					f = e;
+					e = d + t1;
+					d = c;
+					c = b;
+					b = a;
+					a = t1 + t2;
+				}
+
+				s[0] += a;
+				s[1] += b;
+				s[2] += c;
+				s[3] += d;
+				s[4] += e;
+				s[5] += f;
+				s[6] += g;
+				s[7] += h;
+			}
+
+			template<typename V>
+			__attribute__((always_inline)) inline void Init(V s[8]) {
+				for (int i = 0; i < 8; ++i)
+					s[i] = SPLAT(IV[i]);
+			}
+
+			// second round of sha256d: hash the 32-byte digest held in s, leaving the result in s
+			template<typename V>
+			__attribute__((always_inline)) inline void Rehash(V s[8]) {
+				V w[16];
+
+				for (int i = 0; i < 8; ++i)
+					w[i] = s[i];
+				w[8] = SPLAT(0x80000000);
+				for (int i = 9; i < 15; ++i)
+					w[i] = SPLAT(0);
+				w[15] = SPLAT(256);
+
+				Init(s);
+				Transform(s, w);
+			}
+
+			template<typename V>
+			__attribute__((always_inline)) inline void Store(uint256 *out, const V s[8]) {
+				const size_t lanes = sizeof(V) / sizeof(uint32_t);
+
+				for (size_t l = 0; l < lanes; ++l)
+					for (int i = 0; i < 8; ++i)
+						WriteBE32(out[l].begin() + 4 * i, s[i][l]);
+			}
+
+			template<typename V>
+			__attribute__((always_inline)) inline void HashPairsN(uint256 *out, const uint256 *in) {
+				const size_t lanes = sizeof(V) / sizeof(uint32_t);
+				V s[8], w[16];
+
+				for (int i = 0; i < 16; ++i)
+					for (size_t l = 0; l < lanes; ++l)
+						w[i][l] = ReadBE32(in[2 * l + i / 8].begin() + 4 * (i % 8));
+
+				Init(s);
+				Transform(s, w);
+
+				// the padding block of a 64-byte message is the same for every lane
+				w[0] = SPLAT(0x80000000);
+				for (int i = 1; i < 15; ++i)
+					w[i] = SPLAT(0);
+				w[15] = SPLAT(512);
+				Transform(s, w);
+
+				Rehash(s);
+				Store(out, s);
+			}
+
+			// all messages must have the same length, given padded into blocks * 64 bytes each
+			template<typename V>
+			__attribute__((always_inline)) inline void HashN(uint256 *out, const uint8_t *const *padded, size_t blocks) {
+				const size_t lanes = sizeof(V) / sizeof(uint32_t);
+				V s[8], w[16];
+
+				Init(s);
+				for (size_t b = 0; b < blocks; ++b) {
+					for (int i = 0; i < 16; ++i)
+						for (size_t l = 0; l < lanes; ++l)
+							w[i][l] = ReadBE32(padded[l] + 64 * b + 4 * i);
+					Transform(s, w);
+				}
+
+				Rehash(s);
+				Store(out, s);
+			}
+
+			__attribute__((target("sse4.1"))) void HashPairs4(uint256 *out, const uint256 *in) {
+				HashPairsN<v4u32>(out, in);
+			}
+
+			__attribute__((target("sse4.1"))) void Hash4(uint256 *out, const uint8_t *const *padded, size_t blocks) {
+				HashN<v4u32>(out, padded, blocks);
+			}
+
+			__attribute__((target("avx2"))) void HashPairs8(uint256 *out, const uint256 *in) {
+				HashPairsN<v8u32>(out, in);
+			}
+
+			__attribute__((target("avx2"))) void Hash8(uint256 *out, const uint8_t *const *padded, size_t blocks) {
+				HashN<v8u32>(out, padded, blocks);
+			}
+
+			struct Kernel {
+				const char *name;
+				size_t lanes;
+				void (*hashPairs)(uint256 *out, const uint256 *in);
+				void (*hash)(uint256 *out, const uint8_t *const *padded, size_t blocks);
+			};
+
+			const Kernel OpenSSLKernel = {"openssl", 0, nullptr, nullptr};
+			const Kernel SSE41Kernel = {"sse4.1", 4, HashPairs4, Hash4};
+			const Kernel AVX2Kernel = {"avx2", 8, HashPairs8, Hash8};
+
+			bool Supports(const Kernel &k) {
+				__builtin_cpu_init();
+				if (k.hashPairs == HashPairs8)
+					return __builtin_cpu_supports("avx2");
+				if (k.hashPairs == HashPairs4)
+					return __builtin_cpu_supports("sse4.1");
+				return true;
+			}
+
+			Kernel Detect() {
+				if (Supports(AVX2Kernel))
+					return AVX2Kernel;
+				if (Supports(SSE41Kernel))
+					return SSE41Kernel;
+
+				return OpenSSLKernel;
+			}
+
+			Kernel &SelectedKernel() {
+				static Kernel kernel = Detect();
+				return kernel;
+			}
+
+			// append sha256 padding to msg so it spans a whole number of 64-byte blocks
+			size_t Pad(bytes_t &padded, const bytes_t &msg) {
+				size_t blocks = (msg.size() + 8) / 64 + 1;
+				uint64_t bits = (uint64_t) msg.size() * 8;
+
+				padded.resize(blocks * 64);
+				memcpy(padded.data(), msg.data(), msg.size());
+				memset(padded.data() + msg.size(), 0, padded.size() - msg.size());
+				padded[msg.size()] = 0x80;
+				for (int i = 0; i < 8; ++i)
+					padded[padded.size() - 1 - i] = (uint8_t) (bits >> (8 * i));
+
+				return blocks;
+			}
+
+#undef ROR
+#undef SPLAT
+
+#endif
+
+		}
+
+		void SHA256D::HashPairs(uint256 *out, const uint256 *in, size_t count) {
+#ifdef SHA256D_MULTI_BUFFER
+			const Kernel &k = SelectedKernel();
+
+			if (k.lanes != 0) {
+				for (; count >= k.lanes; count -= k.lanes, out += k.lanes, in += 2 * k.lanes)
+					k.hashPairs(out, in);
+			}
+#endif
+			HashPairsOpenSSL(out, in, count);
+		}
+
+		void SHA256D::Hash(uint256 *out, const bytes_t *messages, size_t count) {
+#ifdef SHA256D_MULTI_BUFFER
+			const Kernel &k = SelectedKernel();
+
+			if (k.lanes != 0) {
+				std::vector<bytes_t> padded(k.lanes);
+				std::vector<const uint8_t *> lanes(k.lanes);
+
+				while (count >= k.lanes) {
+					size_t l = 1;
+					while (l < k.lanes && messages[l].size() == messages[0].size())
+						++l;
+
+					// lanes only share a schedule when the messages have the same length
+					if (l < k.lanes) {
+						HashOpenSSL(out, messages, l);
+					} else {
+						size_t blocks = 0;
+						for (l = 0; l < k.lanes; ++l) {
+							blocks = Pad(padded[l], messages[l]);
+							lanes[l] = padded[l].data();
+						}
+						k.hash(out, lanes.data(), blocks);
+					}
+
+					count -= l;
+					out += l;
+					messages += l;
+				}
+			}
+#endif
+			HashOpenSSL(out, messages, count);
+		}
+
+		std::string SHA256D::Implementation() {
+#ifdef SHA256D_MULTI_BUFFER
+			return SelectedKernel().name;
+#else
+			return "openssl";
+#endif
+		}
+
+		bool SHA256D::SetImplementation(const std::string &name) {
+#ifdef SHA256D_MULTI_BUFFER
+			const Kernel *kernels[] = {&OpenSSLKernel, &SSE41Kernel, &AVX2Kernel};
+
+			for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); ++i) {
+				if (name == kernels[i]->name && Supports(*kernels[i])) {
+					SelectedKernel() = *kernels[i];
+					return true;
+				}
+			}
+
+			return false;
+#else
+			return name == "openssl";
+#endif
+		}
+
+	}
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_SHA256D_H__
+#define __ELASTOS_SDK_SHA256D_H__
+
+#include "uint256.h"
+#include "typedefs.h"
+
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Double sha256 of many independent messages at once.
+		 *
+		 * On x86 the messages are hashed in 8 (AVX2) or 4 (SSE4.1) lanes, selected at runtime. Other
+		 * architectures and batches too small to fill the lanes use OpenSSL instead.
+		 */
+		class SHA256D {
+		public:
+			// out[i] = sha256d(in[2i] || in[2i+1]) for i in [0, count), one level of a merkle tree
+			static void HashPairs(uint256 *out, const uint256 *in, size_t count);
+
+			// out[i] = sha256d(messages[i]) for i in [0, count)
+			static void Hash(uint256 *out, const bytes_t *messages, size_t count);
+
+			// name of the kernel selected for this cpu: "avx2", "sse4.1" or "openssl"
+			static std::string Implementation();
+
+			// force a kernel by name, false if this cpu can't run it. Not thread safe, meant for tests and benchmarks
+			static bool SetImplementation(const std::string &name);
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_SHA256D_H__
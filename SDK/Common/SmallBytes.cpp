@@ -0,0 +1,122 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "SmallBytes.h"
+
+#include <cstring>
+#include <utility>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		SmallBytes::SmallBytes(const void *buf, size_t size) : _size(0), _cap(SMALL_BYTES_INLINE) {
+			assign(buf, size);
+		}
+
+		SmallBytes::SmallBytes(const bytes_t &bytes) : _size(0), _cap(SMALL_BYTES_INLINE) {
+			assign(bytes.data(), bytes.size());
+		}
+
+		SmallBytes::SmallBytes(const SmallBytes &other) : _size(0), _cap(SMALL_BYTES_INLINE) {
+			assign(other.data(), other.size());
+		}
+
+		SmallBytes::SmallBytes(SmallBytes &&other) : _size(0), _cap(SMALL_BYTES_INLINE) {
+			operator=(std::move(other));
+		}
+
+		SmallBytes &SmallBytes::operator=(const SmallBytes &other) {
+			if (this != &other)
+				assign(other.data(), other.size());
+			return *this;
+		}
+
+		SmallBytes &SmallBytes::operator=(SmallBytes &&other) {
+			if (this == &other)
+				return *this;
+
+			if (other.IsInline()) {
+				assign(other._inline, other._size);
+			} else {
+				// steal the heap buffer
+				if (!IsInline())
+					delete[] _heap;
+				_heap = other._heap;
+				_size = other._size;
+				_cap = other._cap;
+				other._cap = SMALL_BYTES_INLINE;
+			}
+
+			other._size = 0;
+			return *this;
+		}
+
+		SmallBytes &SmallBytes::operator=(const bytes_t &bytes) {
+			assign(bytes.data(), bytes.size());
+			return *this;
+		}
+
+		void SmallBytes::reserve(size_t size) {
+			if (size <= _cap)
+				return;
+
+			uint8_t *buf = new uint8_t[size];
+			if (_size > 0)
+				memcpy(buf, data(), _size);
+			if (!IsInline())
+				delete[] _heap;
+			_heap = buf;
+			_cap = (uint32_t) size;
+		}
+
+		void SmallBytes::resize(size_t size, uint8_t value) {
+			reserve(size);
+			if (size > _size)
+				memset(data() + _size, value, size - _size);
+			_size = (uint32_t) size;
+		}
+
+		void SmallBytes::assign(const void *buf, size_t size) {
+			_size = 0;
+			append(buf, size);
+		}
+
+		void SmallBytes::append(const void *buf, size_t size) {
+			const uint8_t *src = (const uint8_t *) buf;
+			if (_size + size > _cap) {
+				// the source may be our own bytes, which reserve is about to move
+				size_t offset = src - data();
+				bool self = src >= data() && src < data() + _size;
+				reserve(_size + size > _cap * 2 ? _size + size : _cap * 2);
+				if (self)
+					src = data() + offset;
+			}
+			if (size > 0)
+				memmove(data() + _size, src, size);
+			_size += (uint32_t) size;
+		}
+
+		std::string SmallBytes::getHex() const {
+			std::string hex;
+			hex.reserve(_size * 2);
+			const uint8_t *p = data();
+			for (size_t i = 0; i < _size; ++i)
+				hex += g_hexBytes[p[i]];
+			return hex;
+		}
+
+		void SmallBytes::setHex(const std::string &hex) {
+			bytes_t bytes;
+			bytes.setHex(hex);
+			assign(bytes.data(), bytes.size());
+		}
+
+		int CompareBytes(const uint8_t *a, size_t aSize, const uint8_t *b, size_t bSize) {
+			if (aSize != bSize)
+				return aSize < bSize ? -1 : 1;
+			return aSize == 0 ? 0 : memcmp(a, b, aSize);
+		}
+
+	}
+}
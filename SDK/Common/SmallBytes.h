@@ -0,0 +1,153 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_SMALLBYTES_H__
+#define __ELASTOS_SDK_SMALLBYTES_H__
+
+#include "typedefs.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+// fits a 65 byte signature parameter, a 33 byte pubkey and a standard redeem script
+#define SMALL_BYTES_INLINE 72
+
+		/*
+		 * Byte string that keeps up to SMALL_BYTES_INLINE bytes inside the object and only goes to the heap
+		 * beyond that, so pubkeys, signatures and standard scripts cost no allocation of their own.
+		 * Converts to and from bytes_t implicitly, the conversion copies.
+		 */
+		class SmallBytes {
+		public:
+			typedef uint8_t value_type;
+			typedef uint8_t *iterator;
+			typedef const uint8_t *const_iterator;
+
+		public:
+			SmallBytes() : _size(0), _cap(SMALL_BYTES_INLINE) {}
+
+			SmallBytes(const void *buf, size_t size);
+
+			SmallBytes(const bytes_t &bytes);
+
+			SmallBytes(const SmallBytes &other);
+
+			SmallBytes(SmallBytes &&other);
+
+			~SmallBytes() {
+				if (!IsInline())
+					delete[] _heap;
+			}
+
+			SmallBytes &operator=(const SmallBytes &other);
+
+			SmallBytes &operator=(SmallBytes &&other);
+
+			SmallBytes &operator=(const bytes_t &bytes);
+
+			operator bytes_t() const { return bytes_t(data(), (unsigned int) _size); }
+
+			bool IsInline() const { return _cap == SMALL_BYTES_INLINE; }
+
+			uint8_t *data() { return IsInline() ? _inline : _heap; }
+
+			const uint8_t *data() const { return IsInline() ? _inline : _heap; }
+
+			size_t size() const { return _size; }
+
+			bool empty() const { return _size == 0; }
+
+			size_t capacity() const { return _cap; }
+
+			uint8_t &operator[](size_t i) { return data()[i]; }
+
+			const uint8_t &operator[](size_t i) const { return data()[i]; }
+
+			uint8_t back() const { return data()[_size - 1]; }
+
+			iterator begin() { return data(); }
+
+			iterator end() { return data() + _size; }
+
+			const_iterator begin() const { return data(); }
+
+			const_iterator end() const { return data() + _size; }
+
+			void clear() { _size = 0; }
+
+			void reserve(size_t size);
+
+			void resize(size_t size, uint8_t value = 0);
+
+			void assign(const void *buf, size_t size);
+
+			void append(const void *buf, size_t size);
+
+			void push_back(uint8_t b) {
+				if (_size == _cap)
+					reserve(_cap * 2);
+				data()[_size++] = b;
+			}
+
+			SmallBytes &operator+=(const bytes_t &bytes) {
+				append(bytes.data(), bytes.size());
+				return *this;
+			}
+
+			SmallBytes &operator+=(const SmallBytes &bytes) {
+				append(bytes.data(), bytes.size());
+				return *this;
+			}
+
+			std::string getHex() const;
+
+			void setHex(const std::string &hex);
+
+		private:
+			union {
+				uint8_t _inline[SMALL_BYTES_INLINE];
+				uint8_t *_heap;
+			};
+			uint32_t _size;
+			uint32_t _cap;
+		};
+
+		// Same order as uchar_vector: shorter first, then bytewise.
+		int CompareBytes(const uint8_t *a, size_t aSize, const uint8_t *b, size_t bSize);
+
+		inline bool operator==(const SmallBytes &a, const SmallBytes &b) {
+			return CompareBytes(a.data(), a.size(), b.data(), b.size()) == 0;
+		}
+
+		inline bool operator==(const SmallBytes &a, const bytes_t &b) {
+			return CompareBytes(a.data(), a.size(), b.data(), b.size()) == 0;
+		}
+
+		inline bool operator==(const bytes_t &a, const SmallBytes &b) {
+			return CompareBytes(a.data(), a.size(), b.data(), b.size()) == 0;
+		}
+
+		inline bool operator!=(const SmallBytes &a, const SmallBytes &b) {
+			return !(a == b);
+		}
+
+		inline bool operator!=(const SmallBytes &a, const bytes_t &b) {
+			return !(a == b);
+		}
+
+		inline bool operator!=(const bytes_t &a, const SmallBytes &b) {
+			return !(a == b);
+		}
+
+		inline bool operator<(const SmallBytes &a, const SmallBytes &b) {
+			return CompareBytes(a.data(), a.size(), b.data(), b.size()) < 0;
+		}
+
+	}
+}
+
+#endif //__ELASTOS_SDK_SMALLBYTES_H__
@@ -17,6 +17,7 @@
 #include <openssl/hmac.h>
 
 #include <Common/uchar_vector.h>
+#include <Common/uint256.h>
 
 //#include "hashblock.h" // for Hash9
 //#include "scrypt/scrypt.h" // for scrypt_1024_1_1_256
@@ -92,6 +93,97 @@ inline uchar_vector hmac_sha512(const uchar_vector& key, const uchar_vector& dat
     return uchar_vector(digest, 64);
 }
 
+// Allocation-free variants, the digest is written into a fixed-size integer
+
+inline void sha256(const void* data, size_t len, uint256& md)
+{
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+    SHA256_Update(&sha256, data, len);
+    SHA256_Final(md.begin(), &sha256);
+}
+
+inline void sha256_2(const void* data, size_t len, uint256& md)
+{
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+    SHA256_Update(&sha256, data, len);
+    SHA256_Final(md.begin(), &sha256);
+    SHA256_Init(&sha256);
+    SHA256_Update(&sha256, md.begin(), md.size());
+    SHA256_Final(md.begin(), &sha256);
+}
+
+// double sha256 of the concatenation left + right, as used by merkle tree nodes
+inline void sha256_2(const uint256& left, const uint256& right, uint256& md)
+{
+    SHA256_CTX sha256;
+    SHA256_Init(&sha256);
+    SHA256_Update(&sha256, left.begin(), left.size());
+    SHA256_Update(&sha256, right.begin(), right.size());
+    SHA256_Final(md.begin(), &sha256);
+    SHA256_Init(&sha256);
+    SHA256_Update(&sha256, md.begin(), md.size());
+    SHA256_Final(md.begin(), &sha256);
+}
+
+inline void ripemd160(const void* data, size_t len, uint160& md)
+{
+    RIPEMD160_CTX ripemd160;
+    RIPEMD160_Init(&ripemd160);
+    RIPEMD160_Update(&ripemd160, data, len);
+    RIPEMD160_Final(md.begin(), &ripemd160);
+}
+
+inline void hash160(const void* data, size_t len, uint160& md)
+{
+    uint256 hash;
+    sha256(data, len, hash);
+    ripemd160(hash.begin(), hash.size(), md);
+}
+
+// Incremental sha256, lets callers hash scattered fields without concatenating them first
+class SHA256Hasher
+{
+public:
+    SHA256Hasher() { Reset(); }
+
+    SHA256Hasher& Reset()
+    {
+        SHA256_Init(&_ctx);
+        return *this;
+    }
+
+    SHA256Hasher& Write(const void* data, size_t len)
+    {
+        SHA256_Update(&_ctx, data, len);
+        return *this;
+    }
+
+    SHA256Hasher& Write(const uchar_vector& data)
+    {
+        return Write(data.data(), data.size());
+    }
+
+    // single sha256, the hasher must be Reset() before reuse
+    void Finalize(uint256& md)
+    {
+        SHA256_Final(md.begin(), &_ctx);
+    }
+
+    // double sha256, the hasher must be Reset() before reuse
+    void Finalize2(uint256& md)
+    {
+        SHA256_Final(md.begin(), &_ctx);
+        SHA256_Init(&_ctx);
+        SHA256_Update(&_ctx, md.begin(), md.size());
+        SHA256_Final(md.begin(), &_ctx);
+    }
+
+private:
+    SHA256_CTX _ctx;
+};
+
 //inline uchar_vector hash9(const uchar_vector& data)
 //{
 //    uint256 hash = Hash9((unsigned char*)&data[0], (unsigned char*)&data[0] + data.size());
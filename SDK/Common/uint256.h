@@ -12,6 +12,7 @@
 #include <inttypes.h>
 #include <string>
 #include <vector>
+#include <functional>
 #include "typedefs.h"
 
 inline int Testuint256AdHoc(std::vector<std::string> vArg);
@@ -785,6 +786,43 @@ inline const uint512 operator+(const uint512& a, const uint512& b)      { return
 inline const uint512 operator-(const uint512& a, const uint512& b)      { return (base_uint512)a -  (base_uint512)b; }
 
 
+//////////////////////////////////////////////////////////////////////////////
+//
+// std::hash
+//
+
+/** Tx, block and program hashes are already uniformly random, so hashing one
+ * is just reading eight of its bytes. Hash tables should still mix the value
+ * before masking it, uint128 and uint160 may hold plain numbers.
+ */
+namespace std {
+    template<>
+    struct hash<uint128> {
+        size_t operator()(const uint128 &u) const { return (size_t)u.Get64(0); }
+    };
+
+    template<>
+    struct hash<uint160> {
+        size_t operator()(const uint160 &u) const { return (size_t)u.Get64(0); }
+    };
+
+    template<>
+    struct hash<uint256> {
+        size_t operator()(const uint256 &u) const { return (size_t)u.Get64(0); }
+    };
+
+    template<>
+    struct hash<uint168> {
+        // skip the prefix byte, the rest is a hash160
+        size_t operator()(const uint168 &u) const {
+            uint64_t v;
+            memcpy(&v, u.begin() + 1, sizeof(v));
+            return (size_t)v;
+        }
+    };
+}
+
+
 
 #ifdef TEST_UINT256
 
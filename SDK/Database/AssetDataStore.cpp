@@ -46,7 +46,7 @@ namespace Elastos {
 				sql = "DELETE FROM " + ASSET_TABLE_NAME + " WHERE " + ASSET_COLUMN_ID + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("Prepare sql {}", sql);
 					return false;
 				}
@@ -90,6 +90,16 @@ namespace Elastos {
 		std::vector<AssetEntity> AssetDataStore::GetAllAssets() const {
 			std::vector<AssetEntity> assets;
 
+			if (!ForEachAsset([&assets](const AssetEntity &entity) {
+				assets.push_back(entity);
+				return true;
+			}))
+				return {};
+
+			return assets;
+		}
+
+		bool AssetDataStore::ForEachAsset(const boost::function<bool(const AssetEntity &)> &visitor) const {
 			AssetEntity asset;
 			std::string sql;
 
@@ -97,9 +107,9 @@ namespace Elastos {
 				  ASSET_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
-				return {};
+				return false;
 			}
 
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
@@ -112,15 +122,16 @@ namespace Elastos {
 
 				asset.Asset.assign(pdata, pdata + len);
 
-				assets.push_back(asset);
+				if (!visitor(asset))
+					break;
 			}
 
 			if (!_sqlite->Finalize(stmt)) {
-				Log::error("Asset get all finalize");
-				return {};
+				Log::error("Asset for each finalize");
+				return false;
 			}
 
-			return assets;
+			return true;
 		}
 
 		void AssetDataStore::flush() {
@@ -135,7 +146,7 @@ namespace Elastos {
 				  ASSET_COLUMN_ID + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return false;
 			}
@@ -171,7 +182,7 @@ namespace Elastos {
 				  ASSET_AMOUNT + "," + ASSET_BUFF + "," + ASSET_ISO + ") VALUES (?, ?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return false;
 			}
@@ -205,7 +216,7 @@ namespace Elastos {
 				  + " WHERE " + ASSET_COLUMN_ID + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
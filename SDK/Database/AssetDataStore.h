@@ -46,6 +46,9 @@ namespace Elastos {
 
 			std::vector<AssetEntity> GetAllAssets() const;
 
+			// Visits the rows one at a time, until visitor returns false.
+			bool ForEachAsset(const boost::function<bool(const AssetEntity &)> &visitor) const;
+
 			void flush();
 		private:
 			bool SelectAsset(const std::string &assetID, AssetEntity &asset) const;
@@ -9,14 +9,18 @@
 #include <Wallet/UTXO.h>
 #include <WalletCore/Address.h>
 #include <Plugin/Transaction/TransactionOutput.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <cstdint>
+#include <map>
 
 namespace Elastos {
 	namespace ElaWallet {
 
 		CoinBaseUTXODataStore::CoinBaseUTXODataStore(Sqlite *sqlite) :
 			TableBase(sqlite) {
-			InitializeTable(_databaseCreate);
+			InitializeTable(_databaseCreate + _indexCreate);
 		}
 
 		CoinBaseUTXODataStore::~CoinBaseUTXODataStore() {
@@ -58,6 +62,95 @@ namespace Elastos {
 			});
 		}
 
+		bool CoinBaseUTXODataStore::Sync(const UTXOArray &entitys, TableSyncResult &result) {
+			result = TableSyncResult();
+
+			return DoTransaction([&entitys, &result, this]() {
+				struct Row {
+					uint32_t blockHeight;
+					time_t timestamp;
+					bytes_t programHash;
+					bytes_t assetID;
+					uint32_t outputLock;
+					std::string amount;
+					bool spent;
+					bool seen;
+				};
+				std::map<std::pair<uint256, uint16_t>, Row> rows;
+				std::string sql;
+
+				sql = "SELECT " + _txHash + ", " + _index + ", " + _blockHeight + ", " + _timestamp + ", " +
+					  _programHash + ", " + _assetID + ", " + _outputLock + ", " + _amount + ", " + _spent +
+					  " FROM " + _tableName + ";";
+
+				sqlite3_stmt *stmt;
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
+					Log::error("prepare sql: {}", sql);
+					return false;
+				}
+
+				while (SQLITE_ROW == _sqlite->Step(stmt)) {
+					Row &row = rows[std::make_pair(uint256(*_sqlite->ColumnBlobBytes(stmt, 0)), (uint16_t) _sqlite->ColumnInt(stmt, 1))];
+					row.blockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 2);
+					row.timestamp = _sqlite->ColumnInt64(stmt, 3);
+					const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 4);
+					row.programHash.assign(pdata, pdata + _sqlite->ColumnBytes(stmt, 4));
+					pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 5);
+					row.assetID.assign(pdata, pdata + _sqlite->ColumnBytes(stmt, 5));
+					row.outputLock = _sqlite->ColumnInt(stmt, 6);
+					row.amount = _sqlite->ColumnText(stmt, 7);
+					row.spent = _sqlite->ColumnInt(stmt, 8) != 0;
+					row.seen = false;
+				}
+
+				if (!_sqlite->Finalize(stmt)) {
+					Log::error("Coinbase sync select finalize");
+					return false;
+				}
+
+				for (size_t i = 0; i < entitys.size(); ++i) {
+					const UTXOPtr &u = entitys[i];
+					std::map<std::pair<uint256, uint16_t>, Row>::iterator it =
+						rows.find(std::make_pair(u->Hash(), u->Index()));
+					if (it == rows.end()) {
+						if (!this->PutInternal(u))
+							return false;
+						result.Inserted++;
+						continue;
+					}
+
+					if (it->second.seen)
+						continue;
+					it->second.seen = true;
+
+					const uint256 &assetID = u->Output()->AssetID();
+					if (it->second.blockHeight == u->BlockHeight() && it->second.timestamp == u->Timestamp() &&
+						it->second.programHash == u->Output()->Addr()->ProgramHash().bytes() &&
+						it->second.assetID == bytes_t(assetID.begin(), assetID.size()) &&
+						it->second.outputLock == u->Output()->OutputLock() &&
+						it->second.amount == u->Output()->Amount().getDec() && it->second.spent == u->Spent()) {
+						result.Unchanged++;
+						continue;
+					}
+
+					if (!this->UpdateInternal(u))
+						return false;
+					result.Updated++;
+				}
+
+				for (std::map<std::pair<uint256, uint16_t>, Row>::iterator it = rows.begin(); it != rows.end(); ++it) {
+					if (it->second.seen)
+						continue;
+
+					if (!this->DeleteInternal(it->first.first, it->first.second))
+						return false;
+					result.Deleted++;
+				}
+
+				return true;
+			});
+		}
+
 		size_t CoinBaseUTXODataStore::GetTotalCount() const {
 			size_t count = 0;
 
@@ -67,7 +160,7 @@ namespace Elastos {
 				sql = "SELECT COUNT(" + _txHash + ") AS nums FROM " + _tableName + ";";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("prepare sql: {}", sql);
 					return false;
 				}
@@ -90,27 +183,45 @@ namespace Elastos {
 		std::vector<UTXOPtr> CoinBaseUTXODataStore::GetAll() const {
 			std::vector<UTXOPtr> entitys;
 
+			if (!ForEach(HeightRange(), [&entitys](const UTXOPtr &entity) {
+				entitys.push_back(entity);
+				return true;
+			}))
+				return {};
+
+			return entitys;
+		}
+
+		bool CoinBaseUTXODataStore::ForEach(const HeightRange &range,
+											const boost::function<bool(const UTXOPtr &)> &visitor) const {
 			std::string sql;
 
 			sql = "SELECT " + _txHash + ", " + _blockHeight + ", " + _timestamp + ", " + _index + ", " +
 				  _programHash + ", " + _assetID + ", " + _outputLock + ", " + _amount + ", " +
-				  _payload + ", " + _spent + " FROM " + _tableName + /*" ORDER BY " + _blockHeight + " ASC*/";";
+				  _payload + ", " + _spent + " FROM " + _tableName;
+			if (!range.IsAll())
+				sql += " WHERE " + _blockHeight + " BETWEEN ? AND ?";
+			sql += ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
-				return {};
+				return false;
+			}
+
+			if (!range.IsAll() && (!_sqlite->BindInt64(stmt, 1, range.From) || !_sqlite->BindInt64(stmt, 2, range.To))) {
+				Log::error("bind args");
 			}
 
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
-				uint256 txHash(_sqlite->ColumnText(stmt, 0));
-				uint32_t blockHeight = _sqlite->ColumnInt(stmt, 1);
+				uint256 txHash(*_sqlite->ColumnBlobBytes(stmt, 0));
+				uint32_t blockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 1);
 				time_t timestamp = _sqlite->ColumnInt64(stmt, 2);
 				uint16_t index = (uint16_t) _sqlite->ColumnInt(stmt, 3);
 				uint168 programHash(*_sqlite->ColumnBlobBytes(stmt, 4));
 				uint256 assetID(*_sqlite->ColumnBlobBytes(stmt, 5));
 				uint32_t outputLock = _sqlite->ColumnInt(stmt, 6);
-				BigInt amount;
+				Amount amount;
 				amount.setDec(_sqlite->ColumnText(stmt, 7));
 				_sqlite->ColumnBlobBytes(stmt, 8);
 				bool spent = _sqlite->ColumnInt(stmt, 9) != 0;
@@ -121,15 +232,16 @@ namespace Elastos {
 
 				UTXOPtr entity(new UTXO(txHash, index, timestamp, blockHeight, o));
 				entity->SetSpent(spent);
-				entitys.push_back(entity);
+				if (!visitor(entity))
+					break;
 			}
 
 			if (!_sqlite->Finalize(stmt)) {
-				Log::error("Coinbase get all finalize");
-				return {};
+				Log::error("Coinbase for each finalize");
+				return false;
 			}
 
-			return entitys;
+			return true;
 		}
 
 		bool CoinBaseUTXODataStore::Update(const std::vector<uint256> &txHashes, uint32_t blockHeight,
@@ -138,22 +250,21 @@ namespace Elastos {
 				return true;
 
 			return DoTransaction([&txHashes, &blockHeight, &timestamp, this]() {
-				std::string sql, hash;
+				std::string sql;
 
 				for (size_t i = 0; i < txHashes.size(); ++i) {
-					hash = txHashes[i].GetHex();
 					sql = "UPDATE " + _tableName + " SET " + _blockHeight + " = ?, " +
 						  _timestamp + " = ? WHERE " + _txHash + " = ?;";
 
 					sqlite3_stmt *stmt;
-					if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+					if (!_sqlite->PrepareCached(sql, &stmt)) {
 						Log::error("prepare sql: {}", sql);
 						return false;
 					}
 
-					if (!_sqlite->BindInt(stmt, 1, blockHeight) ||
+					if (!_sqlite->BindInt64(stmt, 1, blockHeight) ||
 						!_sqlite->BindInt64(stmt, 2, timestamp) ||
-						!_sqlite->BindText(stmt, 3, hash, nullptr)) {
+						!_sqlite->BindBlob(stmt, 3, txHashes[i].begin(), txHashes[i].size(), nullptr)) {
 						Log::error("bind args");
 					}
 
@@ -175,21 +286,21 @@ namespace Elastos {
 				return true;
 
 			return DoTransaction([&spentUTXO, this]() {
-				std::string sql, hash;
+				std::string sql;
 
 				for (size_t i = 0; i < spentUTXO.size(); ++i) {
-					hash = spentUTXO[i]->Hash().GetHex();
+					const uint256 &hash = spentUTXO[i]->Hash();
 					uint16_t index = spentUTXO[i]->Index();
 					sql = "UPDATE " + _tableName + " SET " + _spent + " = ? WHERE " + _txHash + " = ? AND " + _index + " = ?;";
 
 					sqlite3_stmt *stmt;
-					if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+					if (!_sqlite->PrepareCached(sql, &stmt)) {
 						Log::error("prepare sql: {}", sql);
 						return false;
 					}
 
 					if (!_sqlite->BindInt(stmt, 1, spentUTXO[i]->Spent() ? 1 : 0) ||
-						!_sqlite->BindText(stmt, 2, hash, nullptr) ||
+						!_sqlite->BindBlob(stmt, 2, hash.begin(), hash.size(), nullptr) ||
 						!_sqlite->BindInt(stmt, 3, index)) {
 						Log::error("bind args");
 					}
@@ -209,17 +320,17 @@ namespace Elastos {
 
 		bool CoinBaseUTXODataStore::Delete(const uint256 &hash) {
 			return DoTransaction([&hash, this]() {
-				std::string sql, hashString = hash.GetHex();
+				std::string sql;
 
 				sql = "DELETE FROM " + _tableName + " WHERE " + _txHash + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("prepare sql: {}", sql);
 					return false;
 				}
 
-				if (!_sqlite->BindText(stmt, 1, hashString, nullptr)) {
+				if (!_sqlite->BindBlob(stmt, 1, hash.begin(), hash.size(), nullptr)) {
 					Log::error("bind args");
 				}
 
@@ -240,21 +351,86 @@ namespace Elastos {
 			_sqlite->flush();
 		}
 
+		bool CoinBaseUTXODataStore::MigrateUnsignedHeights() {
+			return UnsignInt32Column(_tableName, _blockHeight);
+		}
+
+		bool CoinBaseUTXODataStore::MigrateBinaryKeys(size_t batchSize) {
+			std::string legacyTable = _tableName + "Legacy";
+			// a legacy table left behind means an earlier migration stopped half way, it holds the rows not moved yet
+			if (ColumnType(legacyTable, _txHash).empty()) {
+				if (!boost::iequals(ColumnType(_tableName, _txHash), "text"))
+					return true;
+
+				bool renamed = DoAtomicTransaction([&legacyTable, this]() {
+					std::string sql = "ALTER TABLE " + _tableName + " RENAME TO " + legacyTable + ";" + _databaseCreate;
+					if (!_sqlite->exec(sql, nullptr, nullptr)) {
+						Log::error("exec sql: {}", sql);
+						return false;
+					}
+					return true;
+				});
+
+				if (!renamed)
+					return false;
+			}
+
+			std::string columns = _txHash + ", " + _blockHeight + ", " + _timestamp + ", " + _index + ", " +
+								  _programHash + ", " + _assetID + ", " + _outputLock + ", " + _amount + ", " +
+								  _payload + ", " + _spent;
+
+			std::string insertSql = "INSERT INTO " + _tableName + "(" + columns +
+									") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+
+			size_t count = 0;
+			bool result = MoveLegacyRows(legacyTable, columns, insertSql, [this](sqlite3_stmt *select, sqlite3_stmt *stmt) {
+				uint256 txHash(_sqlite->ColumnText(select, 1));
+				return _sqlite->BindBlob(stmt, 1, txHash.begin(), txHash.size(), SQLITE_TRANSIENT) &&
+					   _sqlite->BindInt64(stmt, 2, _sqlite->ColumnInt64(select, 2)) &&
+					   _sqlite->BindInt64(stmt, 3, _sqlite->ColumnInt64(select, 3)) &&
+					   _sqlite->BindInt(stmt, 4, _sqlite->ColumnInt(select, 4)) &&
+					   _sqlite->BindBlob(stmt, 5, _sqlite->ColumnBlob(select, 5), _sqlite->ColumnBytes(select, 5),
+										 nullptr) &&
+					   _sqlite->BindBlob(stmt, 6, _sqlite->ColumnBlob(select, 6), _sqlite->ColumnBytes(select, 6),
+										 nullptr) &&
+					   _sqlite->BindInt64(stmt, 7, _sqlite->ColumnInt64(select, 7)) &&
+					   _sqlite->BindText(stmt, 8, _sqlite->ColumnText(select, 8), SQLITE_TRANSIENT) &&
+					   _sqlite->BindBlob(stmt, 9, _sqlite->ColumnBlob(select, 9), _sqlite->ColumnBytes(select, 9),
+										 nullptr) &&
+					   _sqlite->BindInt(stmt, 10, _sqlite->ColumnInt(select, 10));
+			}, batchSize, count);
+
+			result = result && DoAtomicTransaction([&legacyTable, this]() {
+				std::string sql = "DROP TABLE " + legacyTable + ";" + _indexCreate;
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+				return true;
+			});
+
+			if (result)
+				Log::info("migrated {} rows of {} to binary keys", count, _tableName);
+
+			return result;
+		}
+
 		bool CoinBaseUTXODataStore::PutInternal(const UTXOPtr &entity) {
-			std::string sql, hash = entity->Hash().GetHex();
+			std::string sql;
+			const uint256 &hash = entity->Hash();
 
 			sql = "INSERT INTO " + _tableName + "(" + _txHash + "," + _blockHeight + "," + _timestamp + "," +
 				  _index + "," + _programHash + "," + _assetID + "," + _outputLock + "," + _amount + "," +
 				  _payload + "," + _spent + ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return false;
 			}
 
-			if (!_sqlite->BindText(stmt, 1, hash, nullptr) ||
-				!_sqlite->BindInt(stmt, 2, entity->BlockHeight()) ||
+			if (!_sqlite->BindBlob(stmt, 1, hash.begin(), hash.size(), nullptr) ||
+				!_sqlite->BindInt64(stmt, 2, entity->BlockHeight()) ||
 				!_sqlite->BindInt64(stmt, 3, entity->Timestamp()) ||
 				!_sqlite->BindInt(stmt, 4, entity->Index()) ||
 				!_sqlite->BindBlob(stmt, 5, entity->Output()->Addr()->ProgramHash().bytes(), nullptr) ||
@@ -279,5 +455,72 @@ namespace Elastos {
 			return true;
 		}
 
+		bool CoinBaseUTXODataStore::UpdateInternal(const UTXOPtr &entity) {
+			std::string sql;
+			const uint256 &hash = entity->Hash();
+
+			sql = "UPDATE " + _tableName + " SET " + _blockHeight + " = ?, " + _timestamp + " = ?, " +
+				  _programHash + " = ?, " + _assetID + " = ?, " + _outputLock + " = ?, " + _amount + " = ?, " +
+				  _spent + " = ? WHERE " + _txHash + " = ? AND " + _index + " = ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			if (!_sqlite->BindInt64(stmt, 1, entity->BlockHeight()) ||
+				!_sqlite->BindInt64(stmt, 2, entity->Timestamp()) ||
+				!_sqlite->BindBlob(stmt, 3, entity->Output()->Addr()->ProgramHash().bytes(), nullptr) ||
+				!_sqlite->BindBlob(stmt, 4, entity->Output()->AssetID().begin(), entity->Output()->AssetID().size(),
+								   nullptr) ||
+				!_sqlite->BindInt(stmt, 5, entity->Output()->OutputLock()) ||
+				!_sqlite->BindText(stmt, 6, entity->Output()->Amount().getDec(), SQLITE_TRANSIENT) ||
+				!_sqlite->BindInt(stmt, 7, entity->Spent()) ||
+				!_sqlite->BindBlob(stmt, 8, hash.begin(), hash.size(), nullptr) ||
+				!_sqlite->BindInt(stmt, 9, entity->Index())) {
+				Log::error("bind args");
+			}
+
+			if (SQLITE_DONE != _sqlite->Step(stmt)) {
+				Log::error("step");
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Coinbase sync update finalize");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool CoinBaseUTXODataStore::DeleteInternal(const uint256 &hash, uint16_t index) {
+			std::string sql;
+
+			sql = "DELETE FROM " + _tableName + " WHERE " + _txHash + " = ? AND " + _index + " = ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			if (!_sqlite->BindBlob(stmt, 1, hash.begin(), hash.size(), nullptr) ||
+				!_sqlite->BindInt(stmt, 2, index)) {
+				Log::error("bind args");
+			}
+
+			if (SQLITE_DONE != _sqlite->Step(stmt)) {
+				Log::error("step");
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Coinbase sync delete finalize");
+				return false;
+			}
+
+			return true;
+		}
+
 	}
 }
\ No newline at end of file
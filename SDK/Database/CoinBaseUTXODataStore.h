@@ -9,7 +9,7 @@
 #include "TableBase.h"
 
 #include <Common/uint256.h>
-#include <Common/BigInt.h>
+#include <Common/Amount.h>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -30,10 +30,16 @@ namespace Elastos {
 
 			bool DeleteAll();
 
+			// Makes the table match entitys, writing only rows that are new, changed or gone.
+			bool Sync(const UTXOArray &entitys, TableSyncResult &result);
+
 			size_t GetTotalCount() const;
 
 			std::vector<UTXOPtr> GetAll() const;
 
+			// Visits the rows in range one at a time, until visitor returns false.
+			bool ForEach(const HeightRange &range, const boost::function<bool(const UTXOPtr &)> &visitor) const;
+
 			bool Update(const std::vector<uint256> &txHashes, uint32_t blockHeight, time_t timestamp);
 
 			bool UpdateSpent(const UTXOArray &spentUTXO);
@@ -41,9 +47,21 @@ namespace Elastos {
 			bool Delete(const uint256 &hash);
 
 			void flush();
+
+			// Rebuilds a table created before DATABASE_SCHEMA_VERSION 1, which keyed rows by hex text, moving
+			// batchSize rows per transaction.
+			bool MigrateBinaryKeys(size_t batchSize = LEGACY_MOVE_BATCH_SIZE);
+
+			// Rewrites the heights above INT32_MAX stored as negative values before DATABASE_SCHEMA_VERSION 3.
+			bool MigrateUnsignedHeights();
+
 		private:
 			bool PutInternal(const UTXOPtr &entity);
 
+			bool UpdateInternal(const UTXOPtr &entity);
+
+			bool DeleteInternal(const uint256 &hash, uint16_t index);
+
 		private:
 			/*
 			 * coin base utxo table
@@ -64,7 +82,7 @@ namespace Elastos {
 			const std::string _spent = "spent";
 
 			const std::string _databaseCreate = "create table if not exists " + _tableName + " (" +
-												_txHash + " text not null, " +
+												_txHash + " BLOB not null, " +
 												_blockHeight + " INTEGER, " +
 												_timestamp + " INTEGER, " +
 												_index + " INTEGER, " +
@@ -74,6 +92,11 @@ namespace Elastos {
 												_amount + " TEXT DEFAULT '0', " +
 												_payload + " BLOB, " +
 												_spent + " INTEGER);";
+
+			const std::string _indexCreate = "create index if not exists coinBaseOutpointIndex on " + _tableName +
+											 " (" + _txHash + ", " + _index + ");" +
+											 "create index if not exists coinBaseBlockHeightIndex on " + _tableName +
+											 " (" + _blockHeight + ");";
 		};
 
 	}
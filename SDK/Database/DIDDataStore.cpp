@@ -45,12 +45,12 @@ namespace Elastos {
 					      " WHERE " + TX_HASH + " = ?;";
 
 					sqlite3_stmt *stmt;
-					if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+					if (!_sqlite->PrepareCached(sql, &stmt)) {
 						Log::error("prepare sql: {}", sql);
 						return false;
 					}
 
-					if (!_sqlite->BindInt(stmt, 1, blockHeight) ||
+					if (!_sqlite->BindInt64(stmt, 1, blockHeight) ||
 					    !_sqlite->BindInt64(stmt, 2, timestamp) ||
 					    !_sqlite->BindText(stmt, 3, hash, nullptr)) {
 						Log::error("bind args");
@@ -76,7 +76,7 @@ namespace Elastos {
 				sql = "DELETE FROM " + DID_TABLE_NAME + " WHERE " + DID_COLUMN_ID + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("Prepare sql {}", sql);
 					return false;
 				}
@@ -105,7 +105,7 @@ namespace Elastos {
 				sql = "DELETE FROM " + DID_TABLE_NAME + " WHERE " + TX_HASH + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("Prepare sql {}", sql);
 					return false;
 				}
@@ -145,6 +145,16 @@ namespace Elastos {
 		std::vector<DIDEntity> DIDDataStore::GetAllDID() const {
 			std::vector<DIDEntity> didEntitys;
 
+			if (!ForEachDID([&didEntitys](const DIDEntity &entity) {
+				didEntitys.push_back(entity);
+				return true;
+			}))
+				return {};
+
+			return didEntitys;
+		}
+
+		bool DIDDataStore::ForEachDID(const boost::function<bool(const DIDEntity &)> &visitor) const {
 			DIDEntity didEntity;
 			std::string sql;
 
@@ -152,9 +162,9 @@ namespace Elastos {
 				  + ", " + TIME_STAMP + ", " + TX_HASH + " FROM " + DID_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
-				return {};
+				return false;
 			}
 
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
@@ -166,19 +176,20 @@ namespace Elastos {
 				didEntity.PayloadInfo.assign(pdata, pdata + len);
 
 				didEntity.CreateTime = _sqlite->ColumnInt64(stmt, 2);
-				didEntity.BlockHeight = _sqlite->ColumnInt(stmt, 3);
+				didEntity.BlockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 3);
 				didEntity.TimeStamp = _sqlite->ColumnInt64(stmt, 4);
 				didEntity.TxHash = _sqlite->ColumnText(stmt, 5);
 
-				didEntitys.push_back(didEntity);
+				if (!visitor(didEntity))
+					break;
 			}
 
 			if (!_sqlite->Finalize(stmt)) {
-				Log::error("DID get all finalize");
-				return {};
+				Log::error("DID for each finalize");
+				return false;
 			}
 
-			return didEntitys;
+			return true;
 		}
 
 		std::string DIDDataStore::GetDIDByTxHash(const std::string &txHash) const {
@@ -189,7 +200,7 @@ namespace Elastos {
 			sql = "SELECT " + DID_COLUMN_ID + " FROM " + DID_TABLE_NAME + " WHERE " + TX_HASH + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return "";
 			}
@@ -222,7 +233,7 @@ namespace Elastos {
 					TIME_STAMP + "," + TX_HASH + "," + DID_RESERVE + ") VALUES (?, ?, ?, ?, ?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return false;
 			}
@@ -230,7 +241,7 @@ namespace Elastos {
 			if (!_sqlite->BindText(stmt, 1, didEntity.DID, nullptr) ||
 			    !_sqlite->BindBlob(stmt, 2, didEntity.PayloadInfo, nullptr) ||
 			    !_sqlite->BindInt64(stmt, 3, didEntity.CreateTime) ||
-			    !_sqlite->BindInt(stmt, 4, didEntity.BlockHeight) ||
+			    !_sqlite->BindInt64(stmt, 4, didEntity.BlockHeight) ||
 			    !_sqlite->BindInt64(stmt, 5, didEntity.TimeStamp) ||
 			    !_sqlite->BindText(stmt, 6, didEntity.TxHash, nullptr) ||
 			    !_sqlite->BindText(stmt, 7, "", nullptr)) {
@@ -261,13 +272,13 @@ namespace Elastos {
 			      + " WHERE " + DID_COLUMN_ID + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
 
 			if (!_sqlite->BindBlob(stmt, 1, didEntity.PayloadInfo, nullptr) ||
-			    !_sqlite->BindInt(stmt, 2, didEntity.BlockHeight) ||
+			    !_sqlite->BindInt64(stmt, 2, didEntity.BlockHeight) ||
 			    !_sqlite->BindInt64(stmt, 3, didEntity.TimeStamp) ||
 			    !_sqlite->BindText(stmt, 4, didEntity.TxHash, nullptr) ||
 			    !_sqlite->BindText(stmt, 5, "", nullptr) ||
@@ -295,7 +306,7 @@ namespace Elastos {
 				+ TX_HASH + " FROM " + DID_TABLE_NAME + " WHERE " + DID_COLUMN_ID + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return false;
 			}
@@ -314,7 +325,7 @@ namespace Elastos {
 				didEntity.PayloadInfo.assign(pdata, pdata + len);
 
 				didEntity.CreateTime = _sqlite->ColumnInt64(stmt, 1);
-				didEntity.BlockHeight = (uint32_t) _sqlite->ColumnInt(stmt, 2);
+				didEntity.BlockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 2);
 				didEntity.TimeStamp = (time_t) _sqlite->ColumnInt64(stmt, 3);
 				didEntity.TxHash = _sqlite->ColumnText(stmt, 4);
 			}
@@ -343,7 +354,7 @@ namespace Elastos {
 				  " WHERE " + TX_HASH + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
@@ -54,6 +54,9 @@ namespace Elastos {
 
 			std::vector<DIDEntity> GetAllDID() const;
 
+			// Visits the rows one at a time, until visitor returns false.
+			bool ForEachDID(const boost::function<bool(const DIDEntity &)> &visitor) const;
+
 			std::string GetDIDByTxHash(const std::string &txHash) const;
 
 			bool GetDIDDetails(const std::string &did, DIDEntity &didEntity) const;
@@ -4,19 +4,30 @@
 
 #include "DatabaseManager.h"
 
+#include <Common/Log.h>
+
 namespace Elastos {
 	namespace ElaWallet {
 
-		DatabaseManager::DatabaseManager(const boost::filesystem::path &path) :
+		DatabaseManager::DatabaseManager(const boost::filesystem::path &path, const DurabilityProfile &profile) :
 			_path(path),
 			_sqlite(path),
+			_profile(profile),
+			_bulkSync(false),
 			_peerDataSource(&_sqlite),
 			_peerBlackList(&_sqlite),
 			_coinbaseDataStore(&_sqlite),
 			_transactionDataStore(&_sqlite),
 			_assetDataStore(&_sqlite),
 			_merkleBlockDataSource(&_sqlite),
-			_didDataStore(&_sqlite){}
+			_headerStore(boost::filesystem::path(path).replace_extension(".headers")),
+			_didDataStore(&_sqlite) {
+			if (!_sqlite.SetDurability(_profile))
+				Log::error("apply durability profile to {} failed", _path.string());
+
+			if (!MigrateSchema())
+				Log::error("migrate {} to schema version {} failed", _path.string(), DATABASE_SCHEMA_VERSION);
+		}
 
 		DatabaseManager::DatabaseManager() : DatabaseManager("spv_wallet.db") {}
 
@@ -34,6 +45,18 @@ namespace Elastos {
 			return _coinbaseDataStore.DeleteAll();
 		}
 
+		bool DatabaseManager::SyncCoinBase(const std::vector<UTXOPtr> &entitys) {
+			TableSyncResult result;
+			if (!_coinbaseDataStore.Sync(entitys, result)) {
+				Log::error("sync coinbase failed");
+				return false;
+			}
+
+			Log::info("sync coinbase: {} inserted, {} updated, {} deleted, {} unchanged",
+					  result.Inserted, result.Updated, result.Deleted, result.Unchanged);
+			return true;
+		}
+
 		size_t DatabaseManager::GetCoinBaseTotalCount() const {
 			return _coinbaseDataStore.GetTotalCount();
 		}
@@ -42,6 +65,11 @@ namespace Elastos {
 			return _coinbaseDataStore.GetAll();
 		}
 
+		bool DatabaseManager::ForEachCoinBase(const HeightRange &range,
+											  const boost::function<bool(const UTXOPtr &)> &visitor) const {
+			return _coinbaseDataStore.ForEach(range, visitor);
+		}
+
 		bool DatabaseManager::UpdateCoinBase(const std::vector<uint256> &txHashes, uint32_t blockHeight,
 											 time_t timestamp) {
 			return _coinbaseDataStore.Update(txHashes, blockHeight, timestamp);
@@ -59,6 +87,14 @@ namespace Elastos {
 			return _transactionDataStore.PutTransaction(iso, tx);
 		}
 
+		bool DatabaseManager::PutTransaction(const std::string &iso, const TransactionEntity &tx) {
+			return _transactionDataStore.PutTransaction(iso, tx);
+		}
+
+		bool DatabaseManager::ReplaceTransaction(const std::string &iso, const TransactionEntity &tx) {
+			return _transactionDataStore.ReplaceTransaction(iso, tx);
+		}
+
 		bool DatabaseManager::PutTransactions(const std::string &iso, const std::vector<TransactionPtr> &txns) {
 			return _transactionDataStore.PutTransactions(iso, txns);
 		}
@@ -67,6 +103,27 @@ namespace Elastos {
 			return _transactionDataStore.DeleteAllTransactions();
 		}
 
+		bool DatabaseManager::SyncTransactions(const std::string &iso, const std::vector<TransactionPtr> &txns) {
+			std::vector<TransactionEntity> entities;
+			entities.reserve(txns.size());
+			for (size_t i = 0; i < txns.size(); ++i)
+				entities.push_back(TransactionEntity(*txns[i]));
+
+			return SyncTransactions(iso, entities);
+		}
+
+		bool DatabaseManager::SyncTransactions(const std::string &iso, const std::vector<TransactionEntity> &txns) {
+			TableSyncResult result;
+			if (!_transactionDataStore.SyncTransactions(iso, txns, result)) {
+				Log::error("sync transactions failed");
+				return false;
+			}
+
+			Log::info("sync transactions: {} inserted, {} updated, {} deleted, {} unchanged",
+					  result.Inserted, result.Updated, result.Deleted, result.Unchanged);
+			return true;
+		}
+
 		size_t DatabaseManager::GetAllTransactionsCount() const {
 			return _transactionDataStore.GetAllTransactionsCount();
 		}
@@ -79,6 +136,28 @@ namespace Elastos {
 			return _transactionDataStore.GetAllTransactions(chainID);
 		}
 
+		bool DatabaseManager::ForEachTransaction(const std::string &chainID, const HeightRange &range,
+												 const boost::function<bool(const TransactionPtr &)> &visitor) const {
+			return _transactionDataStore.ForEachTransaction(chainID, range, visitor);
+		}
+
+		std::vector<uint256> DatabaseManager::GetTransactionsWithoutSummary() const {
+			return _transactionDataStore.GetHashesWithoutSummary();
+		}
+
+		bool DatabaseManager::UpdateTransactionSummaries(const std::vector<TransactionSummary> &summaries) {
+			return _transactionDataStore.UpdateSummaries(summaries);
+		}
+
+		std::vector<TransactionSummary> DatabaseManager::GetTransactionSummaries(const bytes_t &types, size_t start,
+																				 size_t count) const {
+			return _transactionDataStore.GetSummaries(types, start, count);
+		}
+
+		size_t DatabaseManager::GetTransactionSummaryCount(const bytes_t &types) const {
+			return _transactionDataStore.GetSummaryCount(types);
+		}
+
 		bool DatabaseManager::UpdateTransaction(const std::vector<uint256> &hashes, uint32_t blockHeight,
 												time_t timestamp) {
 			return _transactionDataStore.UpdateTransaction(hashes, blockHeight, timestamp);
@@ -112,6 +191,10 @@ namespace Elastos {
 			return _peerDataSource.GetAllPeers();
 		}
 
+		bool DatabaseManager::ForEachPeer(const boost::function<bool(const PeerEntity &)> &visitor) const {
+			return _peerDataSource.ForEachPeer(visitor);
+		}
+
 		bool DatabaseManager::DeleteBlackPeer(const PeerEntity &entity) {
 			return _peerBlackList.DeletePeer(entity);
 		}
@@ -124,6 +207,10 @@ namespace Elastos {
 			return _peerBlackList.GetAllPeers();
 		}
 
+		bool DatabaseManager::ForEachBlackPeer(const boost::function<bool(const PeerEntity &)> &visitor) const {
+			return _peerBlackList.ForEachPeer(visitor);
+		}
+
 		bool DatabaseManager::PutBlackPeer(const PeerEntity &entity) {
 			return _peerBlackList.PutPeer(entity);
 		}
@@ -137,24 +224,97 @@ namespace Elastos {
 		}
 
 		bool DatabaseManager::PutMerkleBlock(const std::string &iso, const MerkleBlockPtr &blockPtr) {
-			return _merkleBlockDataSource.PutMerkleBlock(iso, blockPtr);
+			return _headerStore.Append(iso, std::vector<MerkleBlockPtr>(1, blockPtr));
 		}
 
 		bool DatabaseManager::PutMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks) {
-			return _merkleBlockDataSource.PutMerkleBlocks(iso, blocks);
+			return _headerStore.Append(iso, blocks);
+		}
+
+		bool DatabaseManager::PutMerkleBlocks(const std::string &iso, const std::vector<HeaderRecord> &records) {
+			return _headerStore.Append(iso, records);
 		}
 
 		bool DatabaseManager::DeleteMerkleBlock(const std::string &iso, long id) {
-			return _merkleBlockDataSource.DeleteMerkleBlock(iso, id);
+			return _headerStore.Delete((uint64_t) id);
 		}
 
 		bool DatabaseManager::DeleteAllBlocks(const std::string &iso) {
-			return _merkleBlockDataSource.DeleteAllBlocks(iso);
+			return _headerStore.DeleteAll(iso);
+		}
+
+		bool DatabaseManager::SyncMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks) {
+			std::vector<HeaderRecord> records;
+			for (size_t i = 0; i < blocks.size(); ++i)
+				records.push_back(HeaderRecord(*blocks[i]));
+
+			return SyncMerkleBlocks(iso, records);
+		}
+
+		bool DatabaseManager::SyncMerkleBlocks(const std::string &iso, const std::vector<HeaderRecord> &records) {
+			TableSyncResult result;
+			if (!_headerStore.Sync(iso, records, result)) {
+				Log::error("sync merkle blocks failed");
+				return false;
+			}
+
+			Log::info("sync merkle blocks: {} inserted, {} updated, {} deleted, {} unchanged",
+					  result.Inserted, result.Updated, result.Deleted, result.Unchanged);
+			return true;
 		}
 
 		std::vector<MerkleBlockPtr> DatabaseManager::GetAllMerkleBlocks(const std::string &iso,
-																		const std::string &chainID) const {
-			return _merkleBlockDataSource.GetAllMerkleBlocks(iso, chainID);
+																		const std::string &chainID) {
+			return _headerStore.GetAll(iso, chainID);
+		}
+
+		bool DatabaseManager::ForEachMerkleBlock(const std::string &iso, const std::string &chainID,
+												 const HeightRange &range,
+												 const boost::function<bool(const MerkleBlockPtr &)> &visitor) {
+			return _headerStore.ForEach(iso, chainID, range, visitor);
+		}
+
+		// blocks saved to merkleBlockTable before the header store existed, blocks stored already are skipped so a
+		// migration that stopped half way can run again
+		bool DatabaseManager::ImportLegacyMerkleBlocks() {
+			std::map<std::string, std::vector<HeaderRecord>> headers;
+			if (!_merkleBlockDataSource.GetAllHeaders(headers))
+				return false;
+
+			if (headers.empty())
+				return true;
+
+			for (std::map<std::string, std::vector<HeaderRecord>>::iterator it = headers.begin(); it != headers.end(); ++it) {
+				size_t inserted;
+				if (!_headerStore.Import(it->first, it->second, inserted)) {
+					Log::error("move merkle blocks to {} failed", _headerStore.GetPath().string());
+					return false;
+				}
+
+				Log::info("moved {} of {} {} merkle blocks to {}", inserted, it->second.size(), it->first,
+						  _headerStore.GetPath().string());
+			}
+
+			return _merkleBlockDataSource.DeleteAllBlocks("");
+		}
+
+		int DatabaseManager::GetSchemaVersion() {
+			return _sqlite.GetUserVersion();
+		}
+
+		bool DatabaseManager::MigrateSchema() {
+			int version = _sqlite.GetUserVersion();
+			if (version >= DATABASE_SCHEMA_VERSION)
+				return true;
+
+			Log::info("migrate {} from schema version {} to {}", _path.string(), version, DATABASE_SCHEMA_VERSION);
+			// each step checks the table itself, so a database created by this version passes through untouched
+			if (!_transactionDataStore.MigrateBinaryKeys() || !_coinbaseDataStore.MigrateBinaryKeys() ||
+				!_transactionDataStore.AddSummaryColumns() || !_transactionDataStore.MigrateUnsignedHeights() ||
+				!_coinbaseDataStore.MigrateUnsignedHeights() || !ImportLegacyMerkleBlocks())
+				return false;
+
+			return _sqlite.SetUserVersion(DATABASE_SCHEMA_VERSION);
 		}
 
 		const boost::filesystem::path &DatabaseManager::GetPath() const {
@@ -181,6 +341,10 @@ namespace Elastos {
 			return _assetDataStore.GetAllAssets();
 		}
 
+		bool DatabaseManager::ForEachAsset(const boost::function<bool(const AssetEntity &)> &visitor) const {
+			return _assetDataStore.ForEachAsset(visitor);
+		}
+
 		bool DatabaseManager::PutDID(const std::string &iso, const DIDEntity &didEntity) {
 			return _didDataStore.PutDID(iso, didEntity);
 		}
@@ -209,6 +373,10 @@ namespace Elastos {
 			return _didDataStore.GetAllDID();
 		}
 
+		bool DatabaseManager::ForEachDID(const boost::function<bool(const DIDEntity &)> &visitor) const {
+			return _didDataStore.ForEachDID(visitor);
+		}
+
 		bool DatabaseManager::DeleteAllDID() {
 			return _didDataStore.DeleteAllDID();
 		}
@@ -217,10 +385,56 @@ namespace Elastos {
 			_transactionDataStore.flush();
 			_coinbaseDataStore.flush();
 			_merkleBlockDataSource.flush();
+			_headerStore.flush();
 			_peerDataSource.flush();
 			_assetDataStore.flush();
 			_didDataStore.flush();
 		}
 
+		bool DatabaseManager::BeginBatch() {
+			return _sqlite.BeginTransaction(IMMEDIATE);
+		}
+
+		bool DatabaseManager::EndBatch() {
+			return _sqlite.EndTransaction();
+		}
+
+		bool DatabaseManager::SetDurabilityProfile(const DurabilityProfile &profile) {
+			boost::mutex::scoped_lock scopedLock(_durabilityLock);
+			_profile = profile;
+			return _bulkSync || _sqlite.SetDurability(_profile);
+		}
+
+		const DurabilityProfile &DatabaseManager::GetDurabilityProfile() const {
+			return _profile;
+		}
+
+		bool DatabaseManager::BeginBulkSync(const DurabilityProfile &profile) {
+			boost::mutex::scoped_lock scopedLock(_durabilityLock);
+			if (!_sqlite.SetDurability(profile))
+				return false;
+
+			_bulkSync = true;
+			return true;
+		}
+
+		bool DatabaseManager::EndBulkSync() {
+			boost::mutex::scoped_lock scopedLock(_durabilityLock);
+			if (!_bulkSync)
+				return true;
+
+			_bulkSync = false;
+			bool restored = _sqlite.SetDurability(_profile);
+			if (_profile.JournalMode == "WAL" && !_sqlite.Checkpoint())
+				restored = false;
+
+			return restored;
+		}
+
+		bool DatabaseManager::IsBulkSync() const {
+			boost::mutex::scoped_lock scopedLock(_durabilityLock);
+			return _bulkSync;
+		}
+
 	} // namespace ElaWallet
 } // namespace Elastos
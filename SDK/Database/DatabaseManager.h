@@ -6,6 +6,7 @@
 #define __ELASTOS_SDK_DATABASEMANAGER_H__
 
 #include "MerkleBlockDataSource.h"
+#include "HeaderStore.h"
 #include "TransactionDataStore.h"
 #include "PeerDataSource.h"
 #include "PeerBlackList.h"
@@ -14,6 +15,12 @@
 #include "DIDDataStore.h"
 #include "Sqlite.h"
 
+// 1: transaction and coinbase hashes stored as 32-byte blobs, indexed by hash and block height
+// 2: transaction summary columns for history listings
+// 3: block heights stored as unsigned values, so range queries and ordering see heights above INT32_MAX
+// 4: merkle blocks moved from merkleBlockTable to the header store
+#define DATABASE_SCHEMA_VERSION 4
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -22,7 +29,8 @@ namespace Elastos {
 
 		class DatabaseManager {
 		public:
-			DatabaseManager(const boost::filesystem::path &path);
+			DatabaseManager(const boost::filesystem::path &path,
+							const DurabilityProfile &profile = DurabilityProfile::Normal());
 			DatabaseManager();
 			~DatabaseManager();
 
@@ -30,22 +38,38 @@ namespace Elastos {
 			bool PutCoinBase(const std::vector<UTXOPtr> &entitys);
 			bool PutCoinBase(const UTXOPtr &entity);
 			bool DeleteAllCoinBase();
+			// Upserts changed rows and deletes rows missing from entitys instead of rewriting the table.
+			bool SyncCoinBase(const std::vector<UTXOPtr> &entitys);
 			size_t GetCoinBaseTotalCount() const;
 			std::vector<UTXOPtr> GetAllCoinBase() const;
+			bool ForEachCoinBase(const HeightRange &range, const boost::function<bool(const UTXOPtr &)> &visitor) const;
 			bool UpdateCoinBase(const std::vector<uint256> &txHashes, uint32_t blockHeight, time_t timestamp);
 			bool UpdateSpentCoinBase(const UTXOArray &spentUTXO);
 			bool DeleteCoinBase(const uint256 &hash);
 
 			// Transaction's database interface
 			bool PutTransaction(const std::string &iso, const TransactionPtr &tx);
+			bool PutTransaction(const std::string &iso, const TransactionEntity &tx);
+			bool ReplaceTransaction(const std::string &iso, const TransactionEntity &tx);
 			bool PutTransactions(const std::string &iso, const std::vector<TransactionPtr> &txns);
 			bool DeleteAllTransactions();
+			bool SyncTransactions(const std::string &iso, const std::vector<TransactionPtr> &txns);
+			bool SyncTransactions(const std::string &iso, const std::vector<TransactionEntity> &txns);
 			size_t GetAllTransactionsCount() const;
 			TransactionPtr GetTransaction(const uint256& hash, const std::string &chainID);
 			std::vector<TransactionPtr> GetAllTransactions(const std::string &chainID) const;
+			// Streams rows instead of materializing them, visitor returns false to stop.
+			bool ForEachTransaction(const std::string &chainID, const HeightRange &range,
+									const boost::function<bool(const TransactionPtr &)> &visitor) const;
 			bool UpdateTransaction(const std::vector<uint256> &hashes, uint32_t blockHeight, time_t timestamp);
 			bool DeleteTxByHash(const uint256 &hash);
 			bool DeleteTxByHashes(const std::vector<uint256> &hashes);
+			// Rows stored without a summary, summarized once when the wallet is loaded.
+			std::vector<uint256> GetTransactionsWithoutSummary() const;
+			bool UpdateTransactionSummaries(const std::vector<TransactionSummary> &summaries);
+			// Newest first, filtered by tx type unless types is empty, count TX_SUMMARY_NO_LIMIT lists every row.
+			std::vector<TransactionSummary> GetTransactionSummaries(const bytes_t &types, size_t start, size_t count) const;
+			size_t GetTransactionSummaryCount(const bytes_t &types) const;
 
 			// Peer's database interface
 			bool PutPeer(const PeerEntity &peerEntity);
@@ -54,19 +78,26 @@ namespace Elastos {
 			bool DeleteAllPeers();
 			size_t GetAllPeersCount() const;
 			std::vector<PeerEntity> GetAllPeers() const;
+			bool ForEachPeer(const boost::function<bool(const PeerEntity &)> &visitor) const;
 			// Peer's black list
 			bool PutBlackPeer(const PeerEntity &entity);
 			bool PutBlackPeers(const std::vector<PeerEntity> &entitys);
 			bool DeleteBlackPeer(const PeerEntity &entity);
 			bool DeleteAllBlackPeers();
 			std::vector<PeerEntity> GetAllBlackPeers() const;
+			bool ForEachBlackPeer(const boost::function<bool(const PeerEntity &)> &visitor) const;
 
-			// MerkleBlock's database interface
+			// MerkleBlock's database interface, blocks live in the header store next to the database
 			bool PutMerkleBlock(const std::string &iso, const MerkleBlockPtr &blockPtr);
 			bool PutMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks);
+			bool PutMerkleBlocks(const std::string &iso, const std::vector<HeaderRecord> &records);
 			bool DeleteMerkleBlock(const std::string &iso, long id);
 			bool DeleteAllBlocks(const std::string &iso);
-			std::vector<MerkleBlockPtr> GetAllMerkleBlocks(const std::string &iso, const std::string &chainID) const;
+			bool SyncMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks);
+			bool SyncMerkleBlocks(const std::string &iso, const std::vector<HeaderRecord> &records);
+			std::vector<MerkleBlockPtr> GetAllMerkleBlocks(const std::string &iso, const std::string &chainID);
+			bool ForEachMerkleBlock(const std::string &iso, const std::string &chainID, const HeightRange &range,
+									const boost::function<bool(const MerkleBlockPtr &)> &visitor);
 
 			// Asset's database interface
 			bool PutAsset(const std::string &iso, const AssetEntity &asset);
@@ -74,6 +105,7 @@ namespace Elastos {
 			bool DeleteAllAssets();
 			bool GetAssetDetails(const std::string &assetID, AssetEntity &asset) const;
 			std::vector<AssetEntity> GetAllAssets() const;
+			bool ForEachAsset(const boost::function<bool(const AssetEntity &)> &visitor) const;
 
 			// DID's database interface
 			bool PutDID(const std::string &iso, const DIDEntity &didEntity);
@@ -83,20 +115,45 @@ namespace Elastos {
 			bool GetDIDDetails(const std::string &did, DIDEntity &didEntity) const;
 			std::string GetDIDByTxHash(const std::string &txHash) const;
 			std::vector<DIDEntity> GetAllDID() const;
+			bool ForEachDID(const boost::function<bool(const DIDEntity &)> &visitor) const;
 			bool DeleteAllDID();
 
 			const boost::filesystem::path &GetPath() const;
 
 			void flush();
 
+			// Group every write until EndBatch() into a single transaction.
+			bool BeginBatch();
+			bool EndBatch();
+
+			// Durability
+			bool SetDurabilityProfile(const DurabilityProfile &profile);
+			const DurabilityProfile &GetDurabilityProfile() const;
+			// Switches to the bulk profile until EndBulkSync(), which restores the configured profile and checkpoints the WAL.
+			bool BeginBulkSync(const DurabilityProfile &profile = DurabilityProfile::BulkSync());
+			bool EndBulkSync();
+			bool IsBulkSync() const;
+
+			// PRAGMA user_version of the open database, DATABASE_SCHEMA_VERSION once migrated.
+			int GetSchemaVersion();
+
+		private:
+			bool MigrateSchema();
+
+			bool ImportLegacyMerkleBlocks();
+
 		private:
 			boost::filesystem::path _path;
 			Sqlite                	_sqlite;
+			DurabilityProfile       _profile;
+			bool                    _bulkSync;
+			mutable boost::mutex    _durabilityLock;
 			PeerDataSource        	_peerDataSource;
 			PeerBlackList           _peerBlackList;
 			CoinBaseUTXODataStore   _coinbaseDataStore;
 			TransactionDataStore  	_transactionDataStore;
 			MerkleBlockDataSource 	_merkleBlockDataSource;
+			HeaderStore             _headerStore;
 			AssetDataStore          _assetDataStore;
 			DIDDataStore            _didDataStore;
 		};
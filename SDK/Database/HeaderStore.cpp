@@ -0,0 +1,739 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "HeaderStore.h"
+
+#include <Common/ByteStream.h>
+#include <Common/FlatHashMap.h>
+#include <Common/Log.h>
+#include <Plugin/Registry.h>
+#include <Plugin/Interface/IMerkleBlock.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define HEADER_STORE_MAGIC 0x48414c45 // "ELAH"
+#define HEADER_STORE_VERSION 3
+// magic, version and the next record id
+#define HEADER_STORE_FILE_HEADER_SIZE 16
+#define HEADER_STORE_ISO_SIZE 12
+// flags, a checksum of the rest, id, hash, prev hash, chain work, height, timestamp, target and the iso
+#define HEADER_STORE_RECORD_SIZE (4 + 4 + 8 + 32 * 3 + 4 * 3 + HEADER_STORE_ISO_SIZE)
+#define HEADER_STORE_CHECKSUM_OFFSET 8
+#define HEADER_STORE_RECORD_DELETED 1
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		namespace {
+
+			// FNV-1a, only guards against torn writes
+			uint32_t Checksum(const uint8_t *data, size_t len) {
+				uint32_t h = 2166136261u;
+				for (size_t i = 0; i < len; ++i) {
+					h ^= data[i];
+					h *= 16777619u;
+				}
+				return h;
+			}
+
+			struct RecordView {
+				uint32_t Flags;
+				uint64_t Id;
+				uint256 Hash;
+				uint256 PrevHash;
+				uint256 ChainWork;
+				uint32_t Height;
+				uint32_t Timestamp;
+				uint32_t Target;
+				const uint8_t *Iso;
+
+				bool IsLive(const std::string &iso) const {
+					return (Flags & HEADER_STORE_RECORD_DELETED) == 0 && IsIso(iso);
+				}
+
+				bool IsIso(const std::string &iso) const {
+					return iso.size() <= HEADER_STORE_ISO_SIZE && memcmp(Iso, iso.data(), iso.size()) == 0 &&
+						   (iso.size() == HEADER_STORE_ISO_SIZE || Iso[iso.size()] == 0);
+				}
+
+				bool Matches(const HeaderRecord &record) const {
+					return Hash == record.Hash && PrevHash == record.PrevHash && Height == record.Height &&
+						   Timestamp == record.Timestamp && Target == record.Target;
+				}
+			};
+
+			void ParseRecord(const uint8_t *record, RecordView &view) {
+				ByteStreamView stream(record, HEADER_STORE_RECORD_SIZE);
+				uint32_t checksum;
+
+				stream.ReadUint32(view.Flags);
+				stream.ReadUint32(checksum);
+				stream.ReadUint64(view.Id);
+				stream.ReadBytes(view.Hash);
+				stream.ReadBytes(view.PrevHash);
+				stream.ReadBytes(view.ChainWork);
+				stream.ReadUint32(view.Height);
+				stream.ReadUint32(view.Timestamp);
+				stream.ReadUint32(view.Target);
+				view.Iso = record + HEADER_STORE_RECORD_SIZE - HEADER_STORE_ISO_SIZE;
+			}
+
+			bool IsIntact(const uint8_t *record) {
+				uint32_t checksum = 0;
+				ByteStreamView(record + 4, 4).ReadUint32(checksum);
+				return checksum == Checksum(record + HEADER_STORE_CHECKSUM_OFFSET,
+											HEADER_STORE_RECORD_SIZE - HEADER_STORE_CHECKSUM_OFFSET);
+			}
+
+			int Bits(const uint256 &u) {
+				for (int i = 7; i >= 0; --i) {
+					for (int bit = 31; u.Get32(i) != 0 && bit >= 0; --bit) {
+						if (u.Get32(i) & (1u << bit))
+							return i * 32 + bit + 1;
+					}
+				}
+				return 0;
+			}
+
+			// expected number of hashes for a block with the compact target, ~target / (target + 1) + 1
+			uint256 BlockWork(uint32_t compact) {
+				uint32_t size = compact >> 24, word = compact & 0x007fffff;
+				if (word == 0 || (compact & 0x00800000) != 0 || size > 34 || (word > 0xff && size > 33) ||
+					(word > 0xffff && size > 32))
+					return uint256();
+
+				uint256 target(word);
+				if (size <= 3)
+					target >>= 8 * (3 - size);
+				else
+					target <<= 8 * (size - 3);
+				if (target == 0)
+					return uint256();
+
+				// shift and subtract long division
+				uint256 dividend = ~target, divisor = target + uint256(1), quotient;
+				int shift = Bits(dividend) - Bits(divisor);
+				if (shift < 0)
+					return uint256(1);
+
+				divisor <<= shift;
+				for (; shift >= 0; --shift) {
+					if (dividend >= divisor) {
+						dividend -= divisor;
+						quotient |= uint256(1) << shift;
+					}
+					divisor >>= 1;
+				}
+
+				return quotient + uint256(1);
+			}
+
+			// Read-only view of the first size bytes of the file, valid until the file is written again.
+			class MappedFile {
+			public:
+				MappedFile(const boost::filesystem::path &path, size_t size) : _data(nullptr) {
+					if (size <= HEADER_STORE_FILE_HEADER_SIZE)
+						return;
+
+					_mapping = boost::interprocess::file_mapping(path.string().c_str(), boost::interprocess::read_only);
+					_region = boost::interprocess::mapped_region(_mapping, boost::interprocess::read_only, 0, size);
+					_data = (const uint8_t *) _region.get_address();
+				}
+
+				const uint8_t *Record(size_t slot) const {
+					return _data + HEADER_STORE_FILE_HEADER_SIZE + slot * HEADER_STORE_RECORD_SIZE;
+				}
+
+			private:
+				boost::interprocess::file_mapping _mapping;
+				boost::interprocess::mapped_region _region;
+				const uint8_t *_data;
+			};
+
+			size_t FileSize(size_t count) {
+				return HEADER_STORE_FILE_HEADER_SIZE + count * HEADER_STORE_RECORD_SIZE;
+			}
+
+			bool CheckIso(const std::string &iso) {
+				if (iso.size() <= HEADER_STORE_ISO_SIZE)
+					return true;
+
+				Log::error("header store iso {} is longer than {} bytes", iso, HEADER_STORE_ISO_SIZE);
+				return false;
+			}
+
+			// records in chain order, so the chain work of a parent is known before its children
+			std::vector<const HeaderRecord *> ByHeight(const std::vector<const HeaderRecord *> &records) {
+				std::vector<const HeaderRecord *> sorted(records);
+				std::stable_sort(sorted.begin(), sorted.end(), [](const HeaderRecord *a, const HeaderRecord *b) {
+					return a->Height < b->Height;
+				});
+				return sorted;
+			}
+
+		}
+
+		HeaderRecord::HeaderRecord() :
+			Height(0),
+			Timestamp(0),
+			Target(0) {
+		}
+
+		HeaderRecord::HeaderRecord(const IMerkleBlock &block) :
+			Hash(block.GetHash()),
+			PrevHash(block.GetPrevBlockHash()),
+			Height(block.GetHeight()),
+			Timestamp(block.GetTimestamp()),
+			Target(block.GetTarget()) {
+		}
+
+		HeaderStore::HeaderStore(const boost::filesystem::path &path) :
+			_path(path),
+			_file(nullptr),
+			_count(0),
+			_nextId(1) {
+			if (!Open())
+				Log::error("open header store {} failed", _path.string());
+		}
+
+		HeaderStore::~HeaderStore() {
+			Close();
+		}
+
+		bool HeaderStore::Append(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks) {
+			std::vector<HeaderRecord> records;
+			for (size_t i = 0; i < blocks.size(); ++i)
+				records.push_back(HeaderRecord(*blocks[i]));
+
+			return Append(iso, records);
+		}
+
+		bool HeaderStore::Append(const std::string &iso, const std::vector<HeaderRecord> &blockRecords) {
+			std::vector<const HeaderRecord *> records;
+			if (!CheckIso(iso))
+				return false;
+
+			for (size_t i = 0; i < blockRecords.size(); ++i) {
+				if (blockRecords[i].Height > 0)
+					records.push_back(&blockRecords[i]);
+			}
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return AppendRecords(iso, records);
+		}
+
+		bool HeaderStore::Import(const std::string &iso, const std::vector<HeaderRecord> &blockRecords,
+								 size_t &inserted) {
+			FlatHashSet<uint256> stored;
+			std::vector<const HeaderRecord *> records;
+			inserted = 0;
+			if (!CheckIso(iso))
+				return false;
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			try {
+				MappedFile mapped(_path, FileSize(_count));
+				RecordView view;
+				for (size_t i = 0; i < _count; ++i) {
+					ParseRecord(mapped.Record(i), view);
+					if (view.IsLive(iso))
+						stored.insert(view.Hash);
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			for (size_t i = 0; i < blockRecords.size(); ++i) {
+				if (blockRecords[i].Height > 0 && stored.insert(blockRecords[i].Hash).second)
+					records.push_back(&blockRecords[i]);
+			}
+
+			inserted = records.size();
+			return AppendRecords(iso, records);
+		}
+
+		bool HeaderStore::Sync(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks,
+							   TableSyncResult &result) {
+			std::vector<HeaderRecord> records;
+			for (size_t i = 0; i < blocks.size(); ++i)
+				records.push_back(HeaderRecord(*blocks[i]));
+
+			return Sync(iso, records, result);
+		}
+
+		bool HeaderStore::Sync(const std::string &iso, const std::vector<HeaderRecord> &blockRecords,
+							   TableSyncResult &result) {
+			FlatHashMap<uint256, size_t> wanted;
+			std::vector<const HeaderRecord *> records;
+			result = TableSyncResult();
+			if (!CheckIso(iso))
+				return false;
+
+			for (size_t i = 0; i < blockRecords.size(); ++i) {
+				if (blockRecords[i].Height > 0 && wanted.insert(std::make_pair(blockRecords[i].Hash, records.size())).second)
+					records.push_back(&blockRecords[i]);
+			}
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			FlatHashMap<uint256, uint256> chainWork;
+			std::vector<bool> stored(records.size(), false);
+			std::vector<size_t> stale;
+			bytes_t data;
+			size_t dead = 0;
+			try {
+				MappedFile mapped(_path, FileSize(_count));
+				RecordView view;
+
+				for (size_t i = 0; i < _count; ++i) {
+					ParseRecord(mapped.Record(i), view);
+					if (view.Flags & HEADER_STORE_RECORD_DELETED) {
+						dead++;
+						continue;
+					}
+
+					if (view.IsIso(iso)) {
+						FlatHashMap<uint256, size_t>::iterator it = wanted.find(view.Hash);
+						if (it == wanted.end() || stored[it->second] || !view.Matches(*records[it->second])) {
+							stale.push_back(i);
+							continue;
+						}
+
+						stored[it->second] = true;
+						chainWork[view.Hash] = view.ChainWork;
+					}
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			std::vector<const HeaderRecord *> missing;
+			for (size_t i = 0; i < records.size(); ++i) {
+				if (!stored[i])
+					missing.push_back(records[i]);
+			}
+			missing = ByHeight(missing);
+
+			for (size_t i = 0; i < missing.size(); ++i) {
+				const HeaderRecord &record = *missing[i];
+				FlatHashMap<uint256, uint256>::iterator prev = chainWork.find(record.PrevHash);
+				uint256 work = prev != chainWork.end() ? prev->second : uint256();
+
+				work += BlockWork(record.Target);
+				chainWork[record.Hash] = work;
+				EncodeRecord(data, iso, record, work);
+			}
+
+			result.Deleted = stale.size();
+			result.Inserted = missing.size();
+			result.Unchanged = records.size() - missing.size();
+
+			// once most of the file is dead it is replaced by the live records
+			dead += stale.size();
+			if (dead > 0 && dead > _count - dead + missing.size()) {
+				bytes_t kept;
+				try {
+					MappedFile mapped(_path, FileSize(_count));
+					uint32_t flags;
+					for (size_t i = 0, s = 0; i < _count; ++i) {
+						if (s < stale.size() && stale[s] == i) {
+							s++;
+							continue;
+						}
+
+						ByteStreamView(mapped.Record(i), 4).ReadUint32(flags);
+						if ((flags & HEADER_STORE_RECORD_DELETED) == 0)
+							kept.insert(kept.end(), mapped.Record(i), mapped.Record(i) + HEADER_STORE_RECORD_SIZE);
+					}
+				} catch (const std::exception &e) {
+					Log::error("map header store {}: {}", _path.string(), e.what());
+					return false;
+				}
+
+				kept.insert(kept.end(), data.begin(), data.end());
+				return Rewrite(kept);
+			}
+
+			// appended first, a crash in between leaves the stale records to the next sync
+			return (data.empty() || Write(data)) && MarkDeleted(stale);
+		}
+
+		bool HeaderStore::Delete(uint64_t id) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			size_t lo = 0, hi = _count;
+
+			try {
+				// ids grow in file order, a rewrite keeps the order
+				MappedFile mapped(_path, FileSize(_count));
+				RecordView view;
+				while (lo < hi) {
+					size_t mid = lo + (hi - lo) / 2;
+					ParseRecord(mapped.Record(mid), view);
+					if (view.Id == id)
+						return (view.Flags & HEADER_STORE_RECORD_DELETED) != 0 ||
+							   MarkDeleted(std::vector<size_t>(1, mid));
+
+					if (view.Id < id)
+						lo = mid + 1;
+					else
+						hi = mid;
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			return true;
+		}
+
+		bool HeaderStore::DeleteAll(const std::string &iso) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			std::vector<size_t> slots;
+			bool others = false;
+
+			try {
+				MappedFile mapped(_path, FileSize(_count));
+				RecordView view;
+				for (size_t i = 0; i < _count; ++i) {
+					ParseRecord(mapped.Record(i), view);
+					if (view.Flags & HEADER_STORE_RECORD_DELETED)
+						continue;
+
+					if (view.IsIso(iso))
+						slots.push_back(i);
+					else
+						others = true;
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			if (!others && _count > 0)
+				return Truncate(0);
+
+			return MarkDeleted(slots);
+		}
+
+		std::vector<MerkleBlockPtr> HeaderStore::GetAll(const std::string &iso, const std::string &chainID) const {
+			std::vector<MerkleBlockPtr> blocks;
+
+			if (!ForEach(iso, chainID, HeightRange(), [&blocks](const MerkleBlockPtr &block) {
+				blocks.push_back(block);
+				return true;
+			}))
+				return {};
+
+			return blocks;
+		}
+
+		bool HeaderStore::ForEach(const std::string &iso, const std::string &chainID, const HeightRange &range,
+								  const boost::function<bool(const MerkleBlockPtr &)> &visitor) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			try {
+				MappedFile mapped(_path, FileSize(_count));
+				RecordView view;
+				for (size_t i = 0; i < _count; ++i) {
+					ParseRecord(mapped.Record(i), view);
+					if (!view.IsLive(iso) || !range.Contains(view.Height))
+						continue;
+
+					// a compact block, the stored hash stands in for hashing the header again
+					MerkleBlockPtr block(Registry::Instance()->CreateMerkleBlock(chainID));
+					if (block == nullptr) {
+						Log::error("header store {}: no merkle block for chain {}", _path.string(), chainID);
+						return false;
+					}
+					block->SetHash(view.Hash);
+					block->SetPrevBlockHash(view.PrevHash);
+					block->SetHeight(view.Height);
+					block->SetTimestamp(view.Timestamp);
+					block->SetTarget(view.Target);
+
+					if (!visitor(block))
+						break;
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			return true;
+		}
+
+		const boost::filesystem::path &HeaderStore::GetPath() const {
+			return _path;
+		}
+
+		void HeaderStore::flush() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			if (_file != nullptr) {
+				fflush(_file);
+				fsync(fileno(_file));
+			}
+		}
+
+		bool HeaderStore::Open() {
+			boost::system::error_code ec;
+			bool exists = boost::filesystem::exists(_path, ec);
+			uintmax_t size = exists ? boost::filesystem::file_size(_path, ec) : 0;
+			if (exists && ec) {
+				Log::error("header store {}: {}", _path.string(), ec.message());
+				return false;
+			}
+
+			if (size == 0)
+				return Rewrite(bytes_t());
+
+			FILE *file = fopen(_path.string().c_str(), "rb");
+			uint8_t header[HEADER_STORE_FILE_HEADER_SIZE];
+			uint32_t magic = 0, version = 0;
+
+			ByteStreamView stream(header, sizeof(header));
+			bool valid = file != nullptr && fread(header, sizeof(header), 1, file) == 1 &&
+						 stream.ReadUint32(magic) && stream.ReadUint32(version) && stream.ReadUint64(_nextId) &&
+						 magic == HEADER_STORE_MAGIC && version == HEADER_STORE_VERSION;
+			if (file != nullptr)
+				fclose(file);
+
+			if (!valid) {
+				// kept for whoever can read it, the headers are downloaded again
+				boost::filesystem::path aside = _path.string() + ".bak";
+				if (boost::filesystem::exists(aside, ec)) {
+					Log::error("header store {} has an unknown format and {} already exists", _path.string(),
+							   aside.string());
+					return false;
+				}
+
+				boost::filesystem::rename(_path, aside, ec);
+				if (ec) {
+					Log::error("move header store {} aside: {}", _path.string(), ec.message());
+					return false;
+				}
+
+				Log::warn("header store {} has an unknown format, moved to {}", _path.string(), aside.string());
+				_nextId = 1;
+				return Rewrite(bytes_t());
+			}
+
+			// records are never written in the middle, only the tail can be torn
+			_count = (size - HEADER_STORE_FILE_HEADER_SIZE) / HEADER_STORE_RECORD_SIZE;
+			try {
+				MappedFile mapped(_path, FileSize(_count));
+				while (_count > 0 && !IsIntact(mapped.Record(_count - 1)))
+					_count--;
+
+				if (_count > 0) {
+					RecordView view;
+					ParseRecord(mapped.Record(_count - 1), view);
+					_nextId = std::max(_nextId, view.Id + 1);
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			if (FileSize(_count) != size) {
+				Log::warn("header store {} has a torn tail, keep {} records", _path.string(), _count);
+				boost::filesystem::resize_file(_path, FileSize(_count), ec);
+				if (ec) {
+					Log::error("truncate header store {}: {}", _path.string(), ec.message());
+					return false;
+				}
+			}
+
+			_file = fopen(_path.string().c_str(), "ab");
+			return _file != nullptr;
+		}
+
+		void HeaderStore::Close() {
+			if (_file != nullptr) {
+				fflush(_file);
+				fsync(fileno(_file));
+				fclose(_file);
+				_file = nullptr;
+			}
+		}
+
+		void HeaderStore::EncodeRecord(bytes_t &data, const std::string &iso, const HeaderRecord &record,
+									   const uint256 &chainWork) {
+			uint8_t isoField[HEADER_STORE_ISO_SIZE] = {0};
+			memcpy(isoField, iso.data(), iso.size());
+
+			ByteStream body;
+			body.WriteUint64(_nextId++);
+			body.WriteBytes(record.Hash);
+			body.WriteBytes(record.PrevHash);
+			body.WriteBytes(chainWork);
+			body.WriteUint32(record.Height);
+			body.WriteUint32(record.Timestamp);
+			body.WriteUint32(record.Target);
+			body.WriteBytes(isoField, sizeof(isoField));
+
+			const bytes_t &bytes = body.GetBytes();
+			ByteStream stream;
+			stream.WriteUint32(0);
+			stream.WriteUint32(Checksum(bytes.data(), bytes.size()));
+			stream.WriteBytes(bytes);
+
+			data.insert(data.end(), stream.GetBytes().begin(), stream.GetBytes().end());
+		}
+
+		bool HeaderStore::AppendRecords(const std::string &iso, const std::vector<const HeaderRecord *> &unsorted) {
+			std::vector<const HeaderRecord *> records = ByHeight(unsorted);
+			FlatHashMap<uint256, uint256> chainWork;
+			bytes_t data;
+
+			try {
+				for (size_t i = 0; i < records.size(); ++i) {
+					const HeaderRecord &record = *records[i];
+					uint256 work;
+					FlatHashMap<uint256, uint256>::iterator prev = chainWork.find(record.PrevHash);
+					if (prev != chainWork.end())
+						work = prev->second;
+					else
+						FindChainWork(iso, record.PrevHash, work);
+
+					work += BlockWork(record.Target);
+					chainWork[record.Hash] = work;
+					EncodeRecord(data, iso, record, work);
+				}
+			} catch (const std::exception &e) {
+				Log::error("map header store {}: {}", _path.string(), e.what());
+				return false;
+			}
+
+			return data.empty() || Write(data);
+		}
+
+		bool HeaderStore::FindChainWork(const std::string &iso, const uint256 &hash, uint256 &chainWork) const {
+			MappedFile mapped(_path, FileSize(_count));
+			RecordView view;
+
+			// the parent of a new block is almost always the last one stored
+			for (size_t i = _count; i > 0; --i) {
+				ParseRecord(mapped.Record(i - 1), view);
+				if (view.Hash == hash && view.IsLive(iso)) {
+					chainWork = view.ChainWork;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool HeaderStore::Write(const bytes_t &data) {
+			if (_file == nullptr) {
+				Log::error("header store {} is not open", _path.string());
+				return false;
+			}
+
+			// the file is opened for append, a crash part way leaves a tail that Open() truncates
+			if (fwrite(data.data(), data.size(), 1, _file) != 1 || fflush(_file) != 0) {
+				Log::error("write header store {} failed", _path.string());
+				return false;
+			}
+			fsync(fileno(_file));
+
+			_count += data.size() / HEADER_STORE_RECORD_SIZE;
+			return true;
+		}
+
+		bool HeaderStore::MarkDeleted(const std::vector<size_t> &slots) {
+			if (slots.empty())
+				return true;
+
+			// the flags are outside the checksum, so setting them in place can't tear a record
+			ByteStream flags;
+			flags.WriteUint32(HEADER_STORE_RECORD_DELETED);
+
+			int fd = open(_path.string().c_str(), O_WRONLY);
+			if (fd < 0) {
+				Log::error("open header store {} failed", _path.string());
+				return false;
+			}
+
+			bool ok = true;
+			for (size_t i = 0; i < slots.size() && ok; ++i)
+				ok = pwrite(fd, flags.GetBytes().data(), 4, FileSize(slots[i])) == 4;
+			ok = ok && fsync(fd) == 0;
+			close(fd);
+
+			if (!ok)
+				Log::error("delete from header store {} failed", _path.string());
+			return ok;
+		}
+
+		bool HeaderStore::Truncate(size_t count) {
+			// the next id goes to the header first, so ids of the dropped records are not handed out again
+			ByteStream nextId;
+			nextId.WriteUint64(_nextId);
+
+			int fd = open(_path.string().c_str(), O_WRONLY);
+			if (fd < 0) {
+				Log::error("open header store {} failed", _path.string());
+				return false;
+			}
+
+			bool ok = pwrite(fd, nextId.GetBytes().data(), 8, 8) == 8 && ftruncate(fd, FileSize(count)) == 0 &&
+					  fsync(fd) == 0;
+			close(fd);
+
+			if (!ok) {
+				Log::error("truncate header store {} failed", _path.string());
+				return false;
+			}
+
+			_count = count;
+			return true;
+		}
+
+		bool HeaderStore::Rewrite(const bytes_t &data) {
+			boost::filesystem::path tmpPath = _path.string() + ".tmp";
+
+			// the next id is kept here, so ids of deleted records are not handed out again
+			ByteStream header;
+			header.WriteUint32(HEADER_STORE_MAGIC);
+			header.WriteUint32(HEADER_STORE_VERSION);
+			header.WriteUint64(_nextId);
+
+			FILE *file = fopen(tmpPath.string().c_str(), "wb");
+			if (file == nullptr) {
+				Log::error("create header store {} failed", tmpPath.string());
+				return false;
+			}
+
+			bool ok = fwrite(header.GetBytes().data(), header.GetBytes().size(), 1, file) == 1 &&
+					  (data.empty() || fwrite(data.data(), data.size(), 1, file) == 1) &&
+					  fflush(file) == 0 && fsync(fileno(file)) == 0;
+			fclose(file);
+
+			if (!ok) {
+				Log::error("write header store {} failed", tmpPath.string());
+				return false;
+			}
+
+			// the rename replaces the old file in one step, a crash leaves either one or the other
+			Close();
+			boost::system::error_code ec;
+			boost::filesystem::rename(tmpPath, _path, ec);
+			if (ec) {
+				Log::error("replace header store {}: {}", _path.string(), ec.message());
+				return false;
+			}
+
+			_count = data.size() / HEADER_STORE_RECORD_SIZE;
+			_file = fopen(_path.string().c_str(), "ab");
+			return _file != nullptr;
+		}
+
+	}
+}
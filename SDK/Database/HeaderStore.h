@@ -0,0 +1,113 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_HEADERSTORE_H__
+#define __ELASTOS_SDK_HEADERSTORE_H__
+
+#include "TableBase.h"
+
+#include <Common/typedefs.h>
+#include <Common/uint256.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <cstdio>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		class IMerkleBlock;
+		typedef boost::shared_ptr<IMerkleBlock> MerkleBlockPtr;
+
+		// The header fields of a block that are stored, copied when constructed so the block can change afterwards.
+		struct HeaderRecord {
+			HeaderRecord();
+
+			explicit HeaderRecord(const IMerkleBlock &block);
+
+			uint256 Hash;
+			uint256 PrevHash;
+			uint32_t Height;
+			uint32_t Timestamp;
+			uint32_t Target;
+		};
+
+		/*
+		 * Append-only file of fixed size header records (hash, prev hash, height, timestamp, target and chain
+		 * work), read back through a read-only memory map. Loading builds compact blocks straight from the
+		 * mapped fields, nothing is deserialized or hashed. Chain work is summed from the first stored block
+		 * of a chain. A record is deleted by setting a flag in place, and only a Sync that leaves more dead
+		 * than live records replaces the file, through a temp file and a rename. Each record carries a
+		 * checksum, a torn tail left by a crash is truncated on open. A file of another format is moved
+		 * aside to <path>.bak instead of being overwritten.
+		 */
+		class HeaderStore {
+		public:
+			explicit HeaderStore(const boost::filesystem::path &path);
+
+			~HeaderStore();
+
+			bool Append(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks);
+
+			bool Append(const std::string &iso, const std::vector<HeaderRecord> &records);
+
+			// Appends the records whose hash is not stored for iso yet, blocks moved in from merkleBlockTable.
+			bool Import(const std::string &iso, const std::vector<HeaderRecord> &records, size_t &inserted);
+
+			// Makes the records of iso the given ones, matched by hash, so the order does not matter.
+			bool Sync(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks, TableSyncResult &result);
+
+			bool Sync(const std::string &iso, const std::vector<HeaderRecord> &records, TableSyncResult &result);
+
+			// id is assigned on append and never reused, like merkleBlockTable's row id.
+			bool Delete(uint64_t id);
+
+			bool DeleteAll(const std::string &iso);
+
+			std::vector<MerkleBlockPtr> GetAll(const std::string &iso, const std::string &chainID) const;
+
+			// Visits the records of iso in range in file order until visitor returns false, the store is locked meanwhile.
+			bool ForEach(const std::string &iso, const std::string &chainID, const HeightRange &range,
+						 const boost::function<bool(const MerkleBlockPtr &)> &visitor) const;
+
+			const boost::filesystem::path &GetPath() const;
+
+			void flush();
+
+		private:
+			bool Open();
+
+			void Close();
+
+			void EncodeRecord(bytes_t &data, const std::string &iso, const HeaderRecord &record,
+							  const uint256 &chainWork);
+
+			// the caller holds _lock
+			bool AppendRecords(const std::string &iso, const std::vector<const HeaderRecord *> &records);
+
+			// chain work of the live record of iso with this hash, searched from the end of the file
+			bool FindChainWork(const std::string &iso, const uint256 &hash, uint256 &chainWork) const;
+
+			bool Write(const bytes_t &data);
+
+			bool MarkDeleted(const std::vector<size_t> &slots);
+
+			bool Truncate(size_t count);
+
+			bool Rewrite(const bytes_t &data);
+
+		private:
+			boost::filesystem::path _path;
+			FILE *_file;
+			// records in the file, deleted ones included
+			size_t _count;
+			uint64_t _nextId;
+			mutable boost::mutex _lock;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_HEADERSTORE_H__
@@ -8,6 +8,7 @@
 #include <Plugin/Registry.h>
 #include <Common/ByteStream.h>
 #include <Common/ErrorChecker.h>
+#include <Common/SHA256D.h>
 #include <Plugin/Interface/IMerkleBlock.h>
 
 #include <sstream>
@@ -59,13 +60,13 @@ namespace Elastos {
 				  MB_ISO + ") VALUES (?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return false;
 			}
 
 			ByteStream stream;
-			blockPtr->Serialize(stream);
+			stream.WriteExact([&blockPtr](ByteStream &s) { blockPtr->Serialize(s); });
 			if (!_sqlite->BindBlob(stmt, 1, stream.GetBytes(), nullptr) ||
 				!_sqlite->BindInt(stmt, 2, blockPtr->GetHeight()) ||
 				!_sqlite->BindText(stmt, 3, iso, nullptr)) {
@@ -85,32 +86,36 @@ namespace Elastos {
 		}
 
 		bool MerkleBlockDataSource::DeleteMerkleBlock(const std::string &iso, long id) {
-			return DoTransaction([&iso, &id, this]() {
-				std::string sql;
+			return DoTransaction([&id, this]() {
+				return this->DeleteMerkleBlockInternal(id);
+			});
+		}
 
-				sql = "DELETE FROM " + MB_TABLE_NAME + " WHERE " + MB_COLUMN_ID + " = ?;";
+		bool MerkleBlockDataSource::DeleteMerkleBlockInternal(long id) {
+			std::string sql;
 
-				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
-					Log::error("prepare sql: {}", sql);
-					return false;
-				}
+			sql = "DELETE FROM " + MB_TABLE_NAME + " WHERE " + MB_COLUMN_ID + " = ?;";
 
-				if (!_sqlite->BindInt64(stmt, 1, id)) {
-					Log::error("bind args");
-				}
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
 
-				if (SQLITE_DONE != _sqlite->Step(stmt)) {
-					Log::error("step");
-				}
+			if (!_sqlite->BindInt64(stmt, 1, id)) {
+				Log::error("bind args");
+			}
 
-				if (!_sqlite->Finalize(stmt)) {
-					Log::error("mb delete finalize");
-					return false;
-				}
+			if (SQLITE_DONE != _sqlite->Step(stmt)) {
+				Log::error("step");
+			}
 
-				return true;
-			});
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("mb delete finalize");
+				return false;
+			}
+
+			return true;
 		}
 
 		bool MerkleBlockDataSource::DeleteAllBlocks(const std::string &iso) {
@@ -128,15 +133,117 @@ namespace Elastos {
 			});
 		}
 
+		bool MerkleBlockDataSource::SyncMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks,
+													 TableSyncResult &result) {
+			result = TableSyncResult();
+
+			return DoTransaction([&iso, &blocks, &result, this]() {
+				struct Row {
+					long id;
+					bytes_t buff;
+					std::string iso;
+				};
+				// duplicated heights are left in the multimap and deleted below
+				std::multimap<uint32_t, Row> rows;
+				std::string sql;
+
+				sql = "SELECT " + MB_COLUMN_ID + ", " + MB_BUFF + ", " + MB_HEIGHT + ", " + MB_ISO +
+					  " FROM " + MB_TABLE_NAME + ";";
+
+				sqlite3_stmt *stmt;
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
+					Log::error("prepare sql: {}", sql);
+					return false;
+				}
+
+				while (SQLITE_ROW == _sqlite->Step(stmt)) {
+					Row row;
+					row.id = (long) _sqlite->ColumnInt64(stmt, 0);
+					const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
+					row.buff.assign(pdata, pdata + _sqlite->ColumnBytes(stmt, 1));
+					row.iso = _sqlite->ColumnText(stmt, 3);
+					rows.insert(std::make_pair((uint32_t) _sqlite->ColumnInt(stmt, 2), row));
+				}
+
+				if (!_sqlite->Finalize(stmt)) {
+					Log::error("mb sync select finalize");
+					return false;
+				}
+
+				for (size_t i = 0; i < blocks.size(); ++i) {
+					if (blocks[i]->GetHeight() == 0)
+						continue;
+
+					std::multimap<uint32_t, Row>::iterator it = rows.find(blocks[i]->GetHeight());
+					if (it == rows.end()) {
+						if (!this->PutMerkleBlockInternal(iso, blocks[i]))
+							return false;
+						result.Inserted++;
+						continue;
+					}
+
+					ByteStream stream;
+					stream.WriteExact([&](ByteStream &s) { blocks[i]->Serialize(s); });
+					if (it->second.buff == stream.GetBytes() && it->second.iso == iso) {
+						result.Unchanged++;
+					} else {
+						if (!this->UpdateMerkleBlockInternal(it->second.id, iso, stream.GetBytes()))
+							return false;
+						result.Updated++;
+					}
+					rows.erase(it);
+				}
+
+				for (std::multimap<uint32_t, Row>::iterator it = rows.begin(); it != rows.end(); ++it) {
+					if (!this->DeleteMerkleBlockInternal(it->second.id))
+						return false;
+					result.Deleted++;
+				}
+
+				return true;
+			});
+		}
+
+		bool MerkleBlockDataSource::UpdateMerkleBlockInternal(long id, const std::string &iso, const bytes_t &buff) {
+			std::string sql;
+
+			sql = "UPDATE " + MB_TABLE_NAME + " SET " + MB_BUFF + " = ?, " + MB_ISO + " = ? WHERE " +
+				  MB_COLUMN_ID + " = ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			if (!_sqlite->BindBlob(stmt, 1, buff, nullptr) ||
+				!_sqlite->BindText(stmt, 2, iso, nullptr) ||
+				!_sqlite->BindInt64(stmt, 3, id)) {
+				Log::error("bind args");
+			}
+
+			if (SQLITE_DONE != _sqlite->Step(stmt)) {
+				Log::error("step");
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("mb sync update finalize");
+				return false;
+			}
+
+			return true;
+		}
+
 		std::vector<MerkleBlockPtr> MerkleBlockDataSource::GetAllMerkleBlocks(const std::string &iso,
 																			  const std::string &chainID) const {
 			std::vector<MerkleBlockPtr> merkleBlocks;
+			std::vector<bytes_t> headers;
 
 			std::string sql;
 			sql = "SELECT " + MB_COLUMN_ID + ", " + MB_BUFF + ", " + MB_HEIGHT + " FROM " + MB_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return {};
 			}
@@ -146,8 +253,13 @@ namespace Elastos {
 				// blockBytes
 				const uint8_t *pblob = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
 				size_t len = _sqlite->ColumnBytes(stmt, 1);
-				ByteStream stream(pblob, len);
-				merkleBlock->Deserialize(stream);
+				ByteStreamView stream(pblob, len);
+				merkleBlock->DeserializeUnhashed(stream);
+
+				// hashed below with the stored height, before it is overwritten by the column
+				ByteStream header;
+				merkleBlock->SerializeHeader(header);
+				headers.push_back(header.GetBytes());
 
 				// blockHeight
 				uint32_t blockHeight = _sqlite->ColumnInt(stmt, 2);
@@ -161,9 +273,66 @@ namespace Elastos {
 				return {};
 			}
 
+			std::vector<uint256> hashes(headers.size());
+			SHA256D::Hash(hashes.data(), headers.data(), headers.size());
+			for (size_t i = 0; i < merkleBlocks.size(); ++i)
+				merkleBlocks[i]->SetHash(hashes[i]);
+
 			return merkleBlocks;
 		}
 
+		bool MerkleBlockDataSource::GetAllHeaders(std::map<std::string, std::vector<HeaderRecord>> &headers) const {
+			std::vector<std::string> isos;
+			std::vector<HeaderRecord> records;
+			std::vector<bytes_t> prefixes;
+
+			std::string sql;
+			sql = "SELECT " + MB_BUFF + ", " + MB_HEIGHT + ", " + MB_ISO + " FROM " + MB_TABLE_NAME + ";";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			while (SQLITE_ROW == _sqlite->Step(stmt)) {
+				const uint8_t *pblob = (const uint8_t *) _sqlite->ColumnBlob(stmt, 0);
+				size_t len = _sqlite->ColumnBytes(stmt, 0);
+				ByteStreamView stream(pblob, len);
+
+				// version, prev hash, merkle root, timestamp, target, nonce and height, the part that is hashed
+				HeaderRecord record;
+				uint32_t version, nonce, height;
+				uint256 merkleRoot;
+				if (!stream.ReadUint32(version) || !stream.ReadBytes(record.PrevHash) ||
+					!stream.ReadBytes(merkleRoot) || !stream.ReadUint32(record.Timestamp) ||
+					!stream.ReadUint32(record.Target) || !stream.ReadUint32(nonce) || !stream.ReadUint32(height)) {
+					Log::error("merkle block row of {} bytes has no header", len);
+					continue;
+				}
+				prefixes.push_back(bytes_t(pblob, pblob + MB_HEADER_SIZE));
+
+				// the stored height, as GetAllMerkleBlocks does
+				record.Height = _sqlite->ColumnInt(stmt, 1);
+				records.push_back(record);
+				isos.push_back(_sqlite->ColumnText(stmt, 2));
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("mb get all headers finalize");
+				return false;
+			}
+
+			std::vector<uint256> hashes(prefixes.size());
+			SHA256D::Hash(hashes.data(), prefixes.data(), prefixes.size());
+			for (size_t i = 0; i < records.size(); ++i) {
+				records[i].Hash = hashes[i];
+				headers[isos[i]].push_back(records[i]);
+			}
+
+			return true;
+		}
+
 		void MerkleBlockDataSource::flush() {
 			_sqlite->flush();
 		}
@@ -7,6 +7,7 @@
 
 #include "Sqlite.h"
 #include "TableBase.h"
+#include "HeaderStore.h"
 
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/shared_mutex.hpp>
@@ -28,11 +29,18 @@ namespace Elastos {
 			bool PutMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks);
 			bool DeleteMerkleBlock(const std::string &iso, long id);
 			bool DeleteAllBlocks(const std::string &iso);
+			// Makes the table match blocks, keyed by height, writing only rows that are new, changed or gone.
+			bool SyncMerkleBlocks(const std::string &iso, const std::vector<MerkleBlockPtr> &blocks,
+								  TableSyncResult &result);
 			std::vector<MerkleBlockPtr> GetAllMerkleBlocks(const std::string &iso, const std::string &chainID) const;
+			// Header fields of every row grouped by iso, read from the header every block type starts with.
+			bool GetAllHeaders(std::map<std::string, std::vector<HeaderRecord>> &headers) const;
 
 			void flush();
 		private:
 			bool PutMerkleBlockInternal(const std::string &iso, const MerkleBlockPtr &blockPtr);
+			bool UpdateMerkleBlockInternal(long id, const std::string &iso, const bytes_t &buff);
+			bool DeleteMerkleBlockInternal(long id);
 
 
 		private:
@@ -44,6 +52,8 @@ namespace Elastos {
 			const std::string MB_BUFF = "merkleBlockBuff";
 			const std::string MB_HEIGHT = "merkleBlockHeight";
 			const std::string MB_ISO = "merkleBlockISO";
+			// bytes of the header at the start of every row
+			const size_t MB_HEADER_SIZE = 4 + 32 + 32 + 4 + 4 + 4 + 4;
 
 			const std::string MB_DATABASE_CREATE = "create table if not exists " + MB_TABLE_NAME + " (" +
 				MB_COLUMN_ID + " integer primary key autoincrement, " +
@@ -8,18 +8,23 @@
 #include <Common/ErrorChecker.h>
 #include <Common/Log.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 namespace Elastos {
 	namespace ElaWallet {
 		NotifyQueue::NotifyQueue(const boost::filesystem::path &path)
 			: TableBase(new Sqlite(path)) {
-			InitializeTable(NOTIFY_QUEUE_TABLE_CREATE);
+			InitializeTable(NOTIFY_QUEUE_TABLE_CREATE + NOTIFY_QUEUE_INDEX_CREATE);
+			if (!MigrateBinaryKeys())
+				Log::error("migrate {} failed", NOTIFY_QUEUE_TABLE);
 		}
 
 		NotifyQueue::~NotifyQueue() {}
 
 		bool NotifyQueue::Upsert(const RecordPtr &record) {
 			return DoTransaction([&record, this]() {
-				std::string sql, tx_hash = record->tx_hash.GetHex();
+				std::string sql;
+				const uint256 &tx_hash = record->tx_hash;
 
 				sql = "REPLACE INTO " + NOTIFY_QUEUE_TABLE + "(" +
 					  NOTIFY_QUEUE_COLUMN_TX_HASH + "," +
@@ -27,12 +32,12 @@ namespace Elastos {
 					  NOTIFY_QUEUE_COLUMN_LAST_NOTIFY_TIME + ") VALUES(?,?,?);";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("prepare sql: {}", sql);
 					return false;
 				}
 
-				if (!_sqlite->BindText(stmt, 1, tx_hash, nullptr) ||
+				if (!_sqlite->BindBlob(stmt, 1, tx_hash.begin(), tx_hash.size(), nullptr) ||
 					!_sqlite->BindInt(stmt, 2, record->height) ||
 					!_sqlite->BindInt64(stmt, 3, record->last_notify_time)) {
 					Log::error("bind args");
@@ -63,7 +68,7 @@ namespace Elastos {
 				  " WHERE " + NOTIFY_QUEUE_COLUMN_HEIGHT + " != 0 AND " + NOTIFY_QUEUE_COLUMN_HEIGHT + " <= ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return {};
 			}
@@ -73,7 +78,7 @@ namespace Elastos {
 			}
 
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
-				RecordPtr row(new Record(uint256(_sqlite->ColumnText(stmt, 0)),
+				RecordPtr row(new Record(uint256(*_sqlite->ColumnBlobBytes(stmt, 0)),
 										 (uint32_t) _sqlite->ColumnInt(stmt, 1),
 										 (time_t) _sqlite->ColumnInt(stmt, 2)));
 				rows.push_back(row);
@@ -89,18 +94,18 @@ namespace Elastos {
 
 		bool NotifyQueue::Delete(const uint256 &tx_hash) {
 			return DoTransaction([&tx_hash, this]() {
-				std::string sql, hash = tx_hash.GetHex();
+				std::string sql;
 
 				sql = "DELETE FROM " + NOTIFY_QUEUE_TABLE +
 					  " WHERE " + NOTIFY_QUEUE_COLUMN_TX_HASH + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("prepare sql: {}", sql);
 					return false;
 				}
 
-				if (!_sqlite->BindText(stmt, 1, hash, nullptr)) {
+				if (!_sqlite->BindBlob(stmt, 1, tx_hash.begin(), tx_hash.size(), nullptr)) {
 					Log::error("bind args");
 				}
 
@@ -117,5 +122,68 @@ namespace Elastos {
 			});
 		}
 
+		bool NotifyQueue::MigrateBinaryKeys() {
+			if (!boost::iequals(ColumnType(NOTIFY_QUEUE_TABLE, NOTIFY_QUEUE_COLUMN_TX_HASH), "text"))
+				return true;
+
+			// the queue only holds unconfirmed notifications, read it into memory and write it back in one go, a
+			// failed run leaves the old table in place for the next open
+			return DoAtomicTransaction([this]() {
+				std::string sql, legacyTable = NOTIFY_QUEUE_TABLE + "_LEGACY";
+				Records rows;
+
+				sql = "DROP TABLE IF EXISTS " + legacyTable + ";" +
+					  "ALTER TABLE " + NOTIFY_QUEUE_TABLE + " RENAME TO " + legacyTable + ";";
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+
+				sql = "SELECT " +
+					  NOTIFY_QUEUE_COLUMN_TX_HASH + "," +
+					  NOTIFY_QUEUE_COLUMN_HEIGHT + "," +
+					  NOTIFY_QUEUE_COLUMN_LAST_NOTIFY_TIME +
+					  " FROM " + legacyTable + ";";
+
+				sqlite3_stmt *stmt;
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
+					Log::error("prepare sql: {}", sql);
+					return false;
+				}
+
+				while (SQLITE_ROW == _sqlite->Step(stmt)) {
+					RecordPtr row(new Record(uint256(_sqlite->ColumnText(stmt, 0)),
+											 (uint32_t) _sqlite->ColumnInt(stmt, 1),
+											 (time_t) _sqlite->ColumnInt64(stmt, 2)));
+					rows.push_back(row);
+				}
+
+				if (!_sqlite->Finalize(stmt)) {
+					Log::error("NotifyQueue migrate finalize");
+					return false;
+				}
+
+				sql = NOTIFY_QUEUE_TABLE_CREATE;
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+
+				for (size_t i = 0; i < rows.size(); ++i) {
+					if (!Upsert(rows[i]))
+						return false;
+				}
+
+				sql = "DROP TABLE " + legacyTable + ";" + NOTIFY_QUEUE_INDEX_CREATE;
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+
+				Log::info("migrated {} rows of {} to binary keys", rows.size(), NOTIFY_QUEUE_TABLE);
+				return true;
+			});
+		}
+
 	} // namespace ElaWallet
 } // namespace Elastos
@@ -52,6 +52,10 @@ namespace Elastos {
 			 */
 			bool Delete(const uint256 &tx_hash);
 
+		private:
+			// Rebuilds a queue created before hashes were stored as 32-byte blobs.
+			bool MigrateBinaryKeys();
+
 		private:
 			// NotifyQueue table
 			const std::string NOTIFY_QUEUE_TABLE = "NOTIFY_QUEUE";
@@ -61,9 +65,13 @@ namespace Elastos {
 
 			const std::string NOTIFY_QUEUE_TABLE_CREATE = "CREATE TABLE IF NOT EXISTS " +
 														  NOTIFY_QUEUE_TABLE + "(" +
-														  NOTIFY_QUEUE_COLUMN_TX_HASH + " TEXT PRIMARY KEY, " +
+														  NOTIFY_QUEUE_COLUMN_TX_HASH + " BLOB PRIMARY KEY, " +
 														  NOTIFY_QUEUE_COLUMN_HEIGHT + " INTEGER, " +
 														  NOTIFY_QUEUE_COLUMN_LAST_NOTIFY_TIME + " INTEGER);";
+
+			const std::string NOTIFY_QUEUE_INDEX_CREATE = "CREATE INDEX IF NOT EXISTS NOTIFY_QUEUE_HEIGHT_INDEX ON " +
+														  NOTIFY_QUEUE_TABLE + "(" +
+														  NOTIFY_QUEUE_COLUMN_HEIGHT + ");";
 		};
 
 	} // namespace ElaWallet
@@ -53,7 +53,7 @@ namespace Elastos {
 				  _timestamp + ") VALUES (?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
@@ -83,7 +83,7 @@ namespace Elastos {
 				sql = "DELETE FROM " + _peerBlackListTable + " WHERE " + _address + " = ? AND " + _port + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("prepare sql: {}", sql);
 					return false;
 				}
@@ -132,7 +132,7 @@ namespace Elastos {
 				  " WHERE " + _address + " = ? AND " + _port + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
@@ -157,6 +157,16 @@ namespace Elastos {
 		std::vector<PeerEntity> PeerBlackList::GetAllPeers() const {
 			std::vector<PeerEntity> peers;
 
+			if (!ForEachPeer([&peers](const PeerEntity &entity) {
+				peers.push_back(entity);
+				return true;
+			}))
+				return {};
+
+			return peers;
+		}
+
+		bool PeerBlackList::ForEachPeer(const boost::function<bool(const PeerEntity &)> &visitor) const {
 			PeerEntity peer;
 			std::string sql;
 
@@ -164,9 +174,9 @@ namespace Elastos {
 				  _timestamp + " FROM " + _peerBlackListTable + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
-				return {};
+				return false;
 			}
 
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
@@ -186,15 +196,16 @@ namespace Elastos {
 				// timestamp
 				peer.timeStamp = _sqlite->ColumnInt64(stmt, 3);
 
-				peers.push_back(peer);
+				if (!visitor(peer))
+					break;
 			}
 
 			if (!_sqlite->Finalize(stmt)) {
-				Log::error("Peer bl get all finalize");
-				return {};
+				Log::error("Peer bl for each finalize");
+				return false;
 			}
 
-			return peers;
+			return true;
 		}
 
 		void PeerBlackList::flush() {
@@ -209,7 +220,7 @@ namespace Elastos {
 			sql = "SELECT COUNT(" + _columnID + ") AS nums FROM " + _peerBlackListTable + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return 0;
 			}
@@ -34,6 +34,9 @@ namespace Elastos {
 
 			std::vector<PeerEntity> GetAllPeers() const;
 
+			// Visits the rows one at a time, until visitor returns false.
+			bool ForEachPeer(const boost::function<bool(const PeerEntity &)> &visitor) const;
+
 			void flush();
 
 		private:
@@ -52,7 +52,7 @@ namespace Elastos {
 				  PEER_TIMESTAMP + "," + PEER_ISO + ") VALUES (?, ?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
@@ -83,7 +83,7 @@ namespace Elastos {
 				sql = "DELETE FROM " + PEER_TABLE_NAME + " WHERE " + PEER_ADDRESS + " = ? AND " + PEER_PORT + " = ?;";
 
 				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
 					Log::error("prepare sql: {}", sql);
 					return false;
 				}
@@ -132,7 +132,7 @@ namespace Elastos {
 				  " WHERE " + PEER_ADDRESS + " = ? AND " + PEER_PORT + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
@@ -157,6 +157,16 @@ namespace Elastos {
 		std::vector<PeerEntity> PeerDataSource::GetAllPeers() const {
 			std::vector<PeerEntity> peers;
 
+			if (!ForEachPeer([&peers](const PeerEntity &entity) {
+				peers.push_back(entity);
+				return true;
+			}))
+				return {};
+
+			return peers;
+		}
+
+		bool PeerDataSource::ForEachPeer(const boost::function<bool(const PeerEntity &)> &visitor) const {
 			PeerEntity peer;
 			std::string sql;
 
@@ -164,9 +174,9 @@ namespace Elastos {
 				  PEER_TIMESTAMP + " FROM " + PEER_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
-				return {};
+				return false;
 			}
 
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
@@ -186,15 +196,16 @@ namespace Elastos {
 				// timestamp
 				peer.timeStamp = _sqlite->ColumnInt64(stmt, 3);
 
-				peers.push_back(peer);
+				if (!visitor(peer))
+					break;
 			}
 
 			if (!_sqlite->Finalize(stmt)) {
-				Log::error("Peer get all finalize");
-				return {};
+				Log::error("Peer for each finalize");
+				return false;
 			}
 
-			return peers;
+			return true;
 		}
 
 		void PeerDataSource::flush() {
@@ -209,7 +220,7 @@ namespace Elastos {
 			sql = "SELECT COUNT(" + PEER_COLUMN_ID + ") AS nums FROM " + PEER_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return 0;
 			}
@@ -49,6 +49,9 @@ namespace Elastos {
 			size_t GetAllPeersCount() const;
 			std::vector<PeerEntity> GetAllPeers() const;
 
+			// Visits the rows one at a time, until visitor returns false.
+			bool ForEachPeer(const boost::function<bool(const PeerEntity &)> &visitor) const;
+
 			void flush();
 		private:
 			bool Contain(const PeerEntity &entity) const;
@@ -8,11 +8,56 @@
 #include <Common/typedefs.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <cstdlib>
 
 namespace Elastos {
 	namespace ElaWallet {
 
-		Sqlite::Sqlite(const boost::filesystem::path &path) {
+		DurabilityProfile DurabilityProfile::Normal() {
+			DurabilityProfile profile;
+			profile.JournalMode = "WAL";
+			profile.Synchronous = "NORMAL";
+			profile.CacheSize = -8192;
+			profile.MmapSize = 64 * 1024 * 1024;
+			profile.AutoCheckpoint = 1000;
+			return profile;
+		}
+
+		DurabilityProfile DurabilityProfile::Safe() {
+			DurabilityProfile profile = Normal();
+			profile.Synchronous = "FULL";
+			return profile;
+		}
+
+		DurabilityProfile DurabilityProfile::BulkSync() {
+			DurabilityProfile profile = Normal();
+			profile.Synchronous = "OFF";
+			profile.CacheSize = -32768;
+			profile.MmapSize = 256 * 1024 * 1024;
+			profile.AutoCheckpoint = 0;
+			return profile;
+		}
+
+		bool DurabilityProfile::FromName(const std::string &name, DurabilityProfile &profile) {
+			if (name == "Normal") {
+				profile = Normal();
+			} else if (name == "Safe") {
+				profile = Safe();
+			} else if (name == "BulkSync") {
+				profile = BulkSync();
+			} else {
+				return false;
+			}
+
+			return true;
+		}
+
+		Sqlite::Sqlite(const boost::filesystem::path &path) :
+			_dataBasePtr(NULL),
+			_transactionDepth(0) {
 			open(path);
 		}
 
@@ -46,11 +91,16 @@ namespace Elastos {
 
 		bool Sqlite::BeginTransaction(SqliteTransactionType type) {
 			_lockMutex.lock();
+			if (_transactionDepth++ > 0)
+				return true;
+
 			return exec("BEGIN " + GetTxTypeString(type) + " TRANSACTION;", nullptr, nullptr);
 		}
 
 		bool Sqlite::EndTransaction() {
-			bool result = exec("COMMIT;", nullptr, nullptr);
+			bool result = true;
+			if (--_transactionDepth == 0)
+				result = exec("COMMIT;", nullptr, nullptr);
 			_lockMutex.unlock();
 			return result;
 		}
@@ -75,12 +125,68 @@ namespace Elastos {
 			return true;
 		}
 
+		bool Sqlite::PrepareCached(const std::string &sql, sqlite3_stmt **ppStmt) {
+			if (!IsValid()) {
+				Log::error("sqlite is invalid");
+				return false;
+			}
+
+			boost::mutex::scoped_lock scopedLock(_statementLock);
+			std::map<std::string, CachedStatement>::iterator it = _statements.find(sql);
+			if (it != _statements.end()) {
+				if (it->second.inUse) {
+					scopedLock.unlock();
+					return Prepare(sql, ppStmt, nullptr);
+				}
+
+				it->second.inUse = true;
+				*ppStmt = it->second.stmt;
+				return true;
+			}
+
+			sqlite3_stmt *stmt = nullptr;
+			int r = sqlite3_prepare_v3(_dataBasePtr, sql.c_str(), sql.length(), SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);
+			if (r != SQLITE_OK) {
+				Log::error("sqlite prepare error");
+				if (stmt)
+					sqlite3_finalize(stmt);
+				return false;
+			}
+
+			CachedStatement &cached = _statements[sql];
+			cached.stmt = stmt;
+			cached.inUse = true;
+			_cachedStatements[stmt] = &cached;
+			*ppStmt = stmt;
+
+			return true;
+		}
+
 		int Sqlite::Step(sqlite3_stmt *pStmt) {
 			return sqlite3_step(pStmt);
 		}
 
 		bool Sqlite::Finalize(sqlite3_stmt *pStmt) {
-			return IsValid() && SQLITE_OK == sqlite3_finalize(pStmt);
+			if (!IsValid())
+				return false;
+
+			{
+				boost::mutex::scoped_lock scopedLock(_statementLock);
+				std::map<sqlite3_stmt *, CachedStatement *>::iterator it = _cachedStatements.find(pStmt);
+				if (it != _cachedStatements.end()) {
+					int r = sqlite3_reset(pStmt);
+					sqlite3_clear_bindings(pStmt);
+					it->second->inUse = false;
+					return SQLITE_OK == r;
+				}
+			}
+
+			return SQLITE_OK == sqlite3_finalize(pStmt);
+		}
+
+		size_t Sqlite::CachedStatementCount() const {
+			boost::mutex::scoped_lock scopedLock(_statementLock);
+			return _statements.size();
 		}
 
 		bool Sqlite::BindBlob(sqlite3_stmt *pStmt, int idx, const void *blob, size_t size, BindCallBack callBack) {
@@ -117,6 +223,67 @@ namespace Elastos {
 			}
 		}
 
+		static int JournalModeCallBack(void *arg, int count, char **values, char **) {
+			if (count > 0 && values[0])
+				*(std::string *)arg = values[0];
+			return 0;
+		}
+
+		bool Sqlite::SetDurability(const DurabilityProfile &profile) {
+			const std::vector<std::string> journalModes = {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL"};
+			const std::vector<std::string> synchronousLevels = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+			if (std::find(journalModes.begin(), journalModes.end(), profile.JournalMode) == journalModes.end() ||
+				std::find(synchronousLevels.begin(), synchronousLevels.end(), profile.Synchronous) == synchronousLevels.end()) {
+				Log::error("invalid durability profile: journal mode {}, synchronous {}",
+						   profile.JournalMode, profile.Synchronous);
+				return false;
+			}
+
+			// pragmas can not change the journal mode or synchronous level inside a transaction
+			boost::recursive_mutex::scoped_lock scopedLock(_lockMutex);
+			if (_transactionDepth > 0) {
+				Log::error("can not change durability inside a transaction");
+				return false;
+			}
+
+			std::string journalMode;
+			if (!exec("PRAGMA journal_mode = " + profile.JournalMode + ";", JournalModeCallBack, &journalMode))
+				return false;
+
+			if (!boost::iequals(journalMode, profile.JournalMode))
+				Log::warn("sqlite journal mode is {}, requested {}", journalMode, profile.JournalMode);
+
+			return exec("PRAGMA synchronous = " + profile.Synchronous + ";"
+						"PRAGMA cache_size = " + std::to_string(profile.CacheSize) + ";"
+						"PRAGMA mmap_size = " + std::to_string(profile.MmapSize) + ";"
+						"PRAGMA wal_autocheckpoint = " + std::to_string(profile.AutoCheckpoint) + ";", nullptr, nullptr);
+		}
+
+		bool Sqlite::Checkpoint() {
+			boost::recursive_mutex::scoped_lock scopedLock(_lockMutex);
+			return exec("PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr);
+		}
+
+		static int UserVersionCallBack(void *arg, int count, char **values, char **) {
+			if (count > 0 && values[0])
+				*(int *)arg = std::atoi(values[0]);
+			return 0;
+		}
+
+		int Sqlite::GetUserVersion() {
+			int version = 0;
+			boost::recursive_mutex::scoped_lock scopedLock(_lockMutex);
+			if (!exec("PRAGMA user_version;", UserVersionCallBack, &version))
+				return 0;
+			return version;
+		}
+
+		bool Sqlite::SetUserVersion(int version) {
+			boost::recursive_mutex::scoped_lock scopedLock(_lockMutex);
+			return exec("PRAGMA user_version = " + std::to_string(version) + ";", nullptr, nullptr);
+		}
+
 		bytes_ptr Sqlite::ColumnBlobBytes(sqlite3_stmt *pStmt, int iCol) {
 			uint8_t *data = (uint8_t *)ColumnBlob(pStmt, iCol);
 			size_t len = (size_t) ColumnBytes(pStmt, iCol);
@@ -154,6 +321,10 @@ namespace Elastos {
 			return sqlite3_column_bytes(pStmt, iCol);
 		}
 
+		int Sqlite::ColumnType(sqlite3_stmt *pStmt, int iCol) {
+			return sqlite3_column_type(pStmt, iCol);
+		}
+
 		std::string Sqlite::GetTxTypeString(SqliteTransactionType type) {
 			if (type == DEFERRED) {
 				return "DEFERRED";
@@ -190,7 +361,16 @@ namespace Elastos {
 			return true;
 		}
 
+		void Sqlite::clearStatementCache() {
+			boost::mutex::scoped_lock scopedLock(_statementLock);
+			for (std::map<std::string, CachedStatement>::iterator it = _statements.begin(); it != _statements.end(); ++it)
+				sqlite3_finalize(it->second.stmt);
+			_statements.clear();
+			_cachedStatements.clear();
+		}
+
 		void Sqlite::close() {
+			clearStatementCache();
 			if (_dataBasePtr != NULL) {
 				sqlite3_close_v2(_dataBasePtr);
 				_dataBasePtr = NULL;
@@ -10,6 +10,9 @@
 #include <sqlite3.h>
 #include <boost/filesystem.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+
+#include <map>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -23,6 +26,27 @@ namespace Elastos {
 			EXCLUSIVE
 		} SqliteTransactionType;
 
+		/*
+		 * Connection pragmas trading durability for write throughput. CacheSize follows the sqlite
+		 * convention (negative values are KiB, positive values are pages). AutoCheckpoint is the WAL
+		 * size in pages that triggers a checkpoint, 0 leaves checkpointing to Sqlite::Checkpoint().
+		 */
+		struct DurabilityProfile {
+			std::string JournalMode;
+			std::string Synchronous;
+			int64_t CacheSize;
+			int64_t MmapSize;
+			int AutoCheckpoint;
+
+			// WAL with synchronous NORMAL: a crash can not corrupt the database, a power loss may drop the last commits.
+			static DurabilityProfile Normal();
+			// WAL with synchronous FULL: every commit is on disk before it returns.
+			static DurabilityProfile Safe();
+			// No fsync and no automatic checkpoints, meant for the initial catch-up only.
+			static DurabilityProfile BulkSync();
+			static bool FromName(const std::string &name, DurabilityProfile &profile);
+		};
+
 		class Sqlite {
 		public:
 			Sqlite(const boost::filesystem::path &path);
@@ -36,12 +60,20 @@ namespace Elastos {
 			 */
 			bool exec(const std::string &sql, ExecCallBack callBack, void *arg);
 
+			// Transactions nest on the thread that began them, only the outermost one is committed.
 			bool BeginTransaction(SqliteTransactionType type);
 			bool EndTransaction();
 
 			bool Prepare(const std::string &sql, sqlite3_stmt **ppStmt, const char **pzTail);
+			/*
+			 * Returns the statement cached under the id sql, compiling it on first use. Hand it back
+			 * with Finalize(), which keeps it compiled and only resets it and clears its bindings.
+			 * If the cached statement is still held by another caller a private one is prepared.
+			 */
+			bool PrepareCached(const std::string &sql, sqlite3_stmt **ppStmt);
 			int Step(sqlite3_stmt *pStmt);
 			bool Finalize(sqlite3_stmt *pStmt);
+			size_t CachedStatementCount() const;
 			bool BindBlob(sqlite3_stmt *pStmt, int idx, const bytes_t &blob, BindCallBack callBack);
 			bool BindBlob(sqlite3_stmt *pStmt, int idx, const void *blob, size_t size, BindCallBack callBack);
 			bool BindDouble(sqlite3_stmt *pStmt, int idx, double d);
@@ -52,6 +84,13 @@ namespace Elastos {
 
 			void flush();
 
+			bool SetDurability(const DurabilityProfile &profile);
+			bool Checkpoint();
+
+			// PRAGMA user_version, the schema version DatabaseManager migrates from.
+			int GetUserVersion();
+			bool SetUserVersion(int version);
+
 			bytes_ptr ColumnBlobBytes(sqlite3_stmt *pStmt, int iCol);
 			const void *ColumnBlob(sqlite3_stmt *pStmt, int iCol);
 			double ColumnDouble(sqlite3_stmt *pStmt, int iCol);
@@ -59,15 +98,27 @@ namespace Elastos {
 			int64_t ColumnInt64(sqlite3_stmt *pStmt, int iCol);
 			std::string ColumnText(sqlite3_stmt *pStmt, int iCol);
 			int ColumnBytes(sqlite3_stmt *pStmt, int iCol);
+			// SQLITE_NULL for a NULL column, which ColumnText can't read.
+			int ColumnType(sqlite3_stmt *pStmt, int iCol);
 
 		private:
 			std::string GetTxTypeString(SqliteTransactionType type);
 			bool open(const boost::filesystem::path &path);
 			void close();
+			void clearStatementCache();
 
 		private:
+			struct CachedStatement {
+				sqlite3_stmt *stmt;
+				bool inUse;
+			};
+
 			sqlite3 *_dataBasePtr;
-			mutable boost::mutex _lockMutex;
+			mutable boost::recursive_mutex _lockMutex;
+			int _transactionDepth;
+			mutable boost::mutex _statementLock;
+			std::map<std::string, CachedStatement> _statements;
+			std::map<sqlite3_stmt *, CachedStatement *> _cachedStatements;
 		};
 
 	}
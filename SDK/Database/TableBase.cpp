@@ -41,6 +41,143 @@ namespace Elastos {
 			return result;
 		}
 
+		bool TableBase::DoAtomicTransaction(const boost::function<bool()> &fun) const {
+			return DoTransaction([&fun, this]() {
+				if (!_sqlite->exec("SAVEPOINT atomicTransaction;", nullptr, nullptr))
+					return false;
+
+				bool result = false;
+				try {
+					result = fun();
+				} catch (...) {
+					_sqlite->exec("ROLLBACK TO atomicTransaction; RELEASE atomicTransaction;", nullptr, nullptr);
+					throw;
+				}
+
+				if (!result) {
+					_sqlite->exec("ROLLBACK TO atomicTransaction; RELEASE atomicTransaction;", nullptr, nullptr);
+					return false;
+				}
+
+				return _sqlite->exec("RELEASE atomicTransaction;", nullptr, nullptr);
+			});
+		}
+
+		bool TableBase::MoveLegacyRows(const std::string &legacyTable, const std::string &columns,
+									   const std::string &insertSql,
+									   const boost::function<bool(sqlite3_stmt *, sqlite3_stmt *)> &bindRow,
+									   size_t batchSize, size_t &count) const {
+			std::string selectSql = "SELECT rowid, " + columns + " FROM " + legacyTable + " ORDER BY rowid LIMIT ?;";
+			std::string deleteSql = "DELETE FROM " + legacyTable + " WHERE rowid <= ?;";
+			size_t rows;
+
+			do {
+				rows = 0;
+				bool result = DoAtomicTransaction([&]() {
+					sqlite3_stmt *select;
+					if (!_sqlite->PrepareCached(selectSql, &select)) {
+						Log::error("prepare sql: {}", selectSql);
+						return false;
+					}
+
+					if (!_sqlite->BindInt64(select, 1, batchSize)) {
+						Log::error("bind args");
+						_sqlite->Finalize(select);
+						return false;
+					}
+
+					int64_t lastRowid = 0;
+					while (SQLITE_ROW == _sqlite->Step(select)) {
+						sqlite3_stmt *insert;
+						if (!_sqlite->PrepareCached(insertSql, &insert)) {
+							Log::error("prepare sql: {}", insertSql);
+							_sqlite->Finalize(select);
+							return false;
+						}
+
+						bool inserted = bindRow(select, insert) && SQLITE_DONE == _sqlite->Step(insert);
+						if (!_sqlite->Finalize(insert) || !inserted) {
+							Log::error("move {} row", legacyTable);
+							_sqlite->Finalize(select);
+							return false;
+						}
+
+						lastRowid = _sqlite->ColumnInt64(select, 0);
+						rows++;
+					}
+
+					if (!_sqlite->Finalize(select)) {
+						Log::error("move {} select finalize", legacyTable);
+						return false;
+					}
+
+					if (rows == 0)
+						return true;
+
+					sqlite3_stmt *stmt;
+					if (!_sqlite->PrepareCached(deleteSql, &stmt)) {
+						Log::error("prepare sql: {}", deleteSql);
+						return false;
+					}
+
+					bool deleted = _sqlite->BindInt64(stmt, 1, lastRowid) && SQLITE_DONE == _sqlite->Step(stmt);
+					if (!_sqlite->Finalize(stmt) || !deleted) {
+						Log::error("delete moved {} rows", legacyTable);
+						return false;
+					}
+
+					return true;
+				});
+
+				if (!result)
+					return false;
+
+				count += rows;
+			} while (rows == batchSize);
+
+			return true;
+		}
+
+		bool TableBase::UnsignInt32Column(const std::string &table, const std::string &column) const {
+			return DoTransaction([&table, &column, this]() {
+				std::string sql = "UPDATE " + table + " SET " + column + " = " + column + " + 4294967296 WHERE " +
+								  column + " < 0;";
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+				return true;
+			});
+		}
+
+		std::string TableBase::ColumnType(const std::string &table, const std::string &column) const {
+			std::string type, sql;
+
+			sql = "SELECT type FROM pragma_table_info(?) WHERE name = ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return "";
+			}
+
+			if (!_sqlite->BindText(stmt, 1, table, nullptr) ||
+				!_sqlite->BindText(stmt, 2, column, nullptr)) {
+				Log::error("bind args");
+			}
+
+			if (SQLITE_ROW == _sqlite->Step(stmt)) {
+				type = _sqlite->ColumnText(stmt, 0);
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("column type finalize");
+				return "";
+			}
+
+			return type;
+		}
+
 		void TableBase::InitializeTable(const std::string &constructScript) {
 			_sqlite->BeginTransaction(_txType);
 			_sqlite->exec(constructScript, nullptr, nullptr);
@@ -10,10 +10,34 @@
 
 #include <boost/function.hpp>
 
+// Rows MoveLegacyRows copies per transaction.
+#define LEGACY_MOVE_BATCH_SIZE 1000
 
 namespace Elastos {
 	namespace ElaWallet {
 
+		// Rows touched when a whole table is synced against an in-memory snapshot.
+		struct TableSyncResult {
+			TableSyncResult() : Inserted(0), Updated(0), Deleted(0), Unchanged(0) {}
+
+			size_t Inserted;
+			size_t Updated;
+			size_t Deleted;
+			size_t Unchanged;
+		};
+
+		// Inclusive block height range visited by a cursor, the default visits every row.
+		struct HeightRange {
+			HeightRange(uint32_t from = 0, uint32_t to = UINT32_MAX) : From(from), To(to) {}
+
+			bool IsAll() const { return From == 0 && To == UINT32_MAX; }
+
+			bool Contains(uint32_t height) const { return height >= From && height <= To; }
+
+			uint32_t From;
+			uint32_t To;
+		};
+
 		class TableBase {
 		public:
 			TableBase(Sqlite *sqlite);
@@ -27,6 +51,25 @@ namespace Elastos {
 
 			bool DoTransaction(const boost::function<bool()> &fun) const;
 
+			// Like DoTransaction, but nothing fun wrote is kept when it fails.
+			bool DoAtomicTransaction(const boost::function<bool()> &fun) const;
+
+			/*
+			 * Copies the rows of legacyTable with insertSql and deletes them from legacyTable, batchSize rows per
+			 * transaction, so a migration stopped half way continues with the rows it hadn't copied yet. The
+			 * select on columns passed to bindRow has the rowid in front, the first column is at index 1. The
+			 * insert is stepped after bindRow returns, temporaries it binds need SQLITE_TRANSIENT.
+			 */
+			bool MoveLegacyRows(const std::string &legacyTable, const std::string &columns, const std::string &insertSql,
+								const boost::function<bool(sqlite3_stmt *select, sqlite3_stmt *insert)> &bindRow,
+								size_t batchSize, size_t &count) const;
+
+			// Rewrites the negative values a uint32 column got when it was bound as a signed 32-bit int.
+			bool UnsignInt32Column(const std::string &table, const std::string &column) const;
+
+			// Declared type of column in table, empty if either does not exist.
+			std::string ColumnType(const std::string &table, const std::string &column) const;
+
 		protected:
 			Sqlite *_sqlite;
 			SqliteTransactionType _txType;
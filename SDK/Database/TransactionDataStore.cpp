@@ -11,24 +11,91 @@
 #include <Plugin/Transaction/IDTransaction.h>
 #include <Plugin/Registry.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <string>
 
+#define TX_DESERIALIZE_BATCH 256 // rows per extra deserialization thread
+
 namespace Elastos {
 	namespace ElaWallet {
 
+		namespace {
+
+			// rows with iso "ela" predate the extended serialization and are checked against their stored hash
+			TransactionPtr DecodeTx(const std::string &chainID, const uint256 &hash, const uint8_t *data, size_t len,
+									uint32_t blockHeight, uint32_t timeStamp, bool legacy) {
+				TransactionPtr tx;
+				if (chainID == CHAINID_MAINCHAIN) {
+					tx = TransactionPtr(new Transaction());
+				} else if (chainID == CHAINID_IDCHAIN || chainID == CHAINID_TOKENCHAIN) {
+					tx = TransactionPtr(new IDTransaction());
+				}
+
+				ByteStreamView stream(data, len);
+				if (legacy) {
+					tx->Deserialize(stream);
+					assert(hash == tx->GetHash());
+				} else {
+					tx->Deserialize(stream, true);
+					tx->SetHash(hash);
+				}
+
+				tx->SetBlockHeight(blockHeight);
+				tx->SetTimestamp(timeStamp);
+				return tx;
+			}
+
+			// tx types are plain integers, inlined so each filter keeps its own cached statement
+			std::string TypeList(const bytes_t &types) {
+				std::string list;
+				for (size_t i = 0; i < types.size(); ++i) {
+					if (i > 0)
+						list += ",";
+					list += std::to_string(types[i]);
+				}
+				return list;
+			}
+
+		}
+
 		TransactionDataStore::TransactionDataStore(Sqlite *sqlite) : TableBase(sqlite) {
-			InitializeTable(TX_DATABASE_CREATE);
+			InitializeTable(TX_DATABASE_CREATE + TX_INDEX_CREATE);
 		}
 
 		TransactionDataStore::TransactionDataStore(SqliteTransactionType type, Sqlite *sqlite) :
 			TableBase(type, sqlite) {
-			InitializeTable(TX_DATABASE_CREATE);
+			InitializeTable(TX_DATABASE_CREATE + TX_INDEX_CREATE);
+		}
+
+		TransactionEntity::TransactionEntity(const Transaction &tx) :
+			TxHash(tx.GetHash()),
+			BlockHeight(tx.GetBlockHeight()),
+			Timestamp(tx.GetTimestamp()),
+			Summarized(false) {
+			ByteStream stream;
+			stream.WriteExact([&tx](ByteStream &s) { tx.Serialize(s, true); });
+			Buff = stream.ReleaseBytes();
+		}
+
+		TransactionEntity::TransactionEntity(const Transaction &tx, const TransactionSummary &summary) :
+			TransactionEntity(tx) {
+			Summarized = true;
+			Summary = summary;
+			Summary.TxHash = TxHash;
+			Summary.BlockHeight = BlockHeight;
+			Summary.Timestamp = Timestamp;
 		}
 
 		TransactionDataStore::~TransactionDataStore() {}
 
-		bool TransactionDataStore::PutTransactionInternal(const std::string &iso, const TransactionPtr &tx) {
-			std::string sql, txHash;
+		bool TransactionDataStore::PutTransactionInternal(const std::string &iso, const TransactionEntity &tx) {
+			std::string sql;
 
 			sql = "INSERT INTO " + TX_TABLE_NAME + "(" +
 				  TX_COLUMN_ID + "," +
@@ -37,25 +104,26 @@ namespace Elastos {
 				  TX_TIME_STAMP + "," +
 				  TX_REMARK + "," +
 				  TX_ASSETID + "," +
-				  TX_ISO + ") VALUES (?, ?, ?, ?, ?, ?, ?);";
+				  TX_ISO + "," +
+				  TX_DIRECTION + "," +
+				  TX_AMOUNT + "," +
+				  TX_FEE + "," +
+				  TX_TYPE + ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
 
-			ByteStream stream;
-			tx->Serialize(stream, true);
-
-			txHash = tx->GetHash().GetHex();
-			if (!_sqlite->BindText(stmt, 1, txHash, nullptr) ||
-				!_sqlite->BindBlob(stmt, 2, stream.GetBytes(), nullptr) ||
-				!_sqlite->BindInt(stmt, 3, tx->GetBlockHeight()) ||
-				!_sqlite->BindInt64(stmt, 4, tx->GetTimestamp()) ||
+			if (!_sqlite->BindBlob(stmt, 1, tx.TxHash.begin(), tx.TxHash.size(), nullptr) ||
+				!_sqlite->BindBlob(stmt, 2, tx.Buff, nullptr) ||
+				!_sqlite->BindInt64(stmt, 3, tx.BlockHeight) ||
+				!_sqlite->BindInt64(stmt, 4, tx.Timestamp) ||
 				!_sqlite->BindText(stmt, 5, "", nullptr) ||
 				!_sqlite->BindText(stmt, 6, "", nullptr) ||
-				!_sqlite->BindText(stmt, 7, iso, nullptr)) {
+				!_sqlite->BindText(stmt, 7, iso, nullptr) ||
+				!BindSummary(stmt, 8, tx)) {
 				Log::error("bind args");
 			}
 
@@ -72,22 +140,33 @@ namespace Elastos {
 		}
 
 		bool TransactionDataStore::PutTransaction(const std::string &iso, const TransactionPtr &tx) {
-			std::string txHash = tx->GetHash().GetHex();
-			if (ContainHash(txHash)) {
-				Log::error("should not put in existed tx {}", tx->GetHash().GetHex());
+			return PutTransaction(iso, TransactionEntity(*tx));
+		}
+
+		bool TransactionDataStore::PutTransaction(const std::string &iso, const TransactionEntity &tx) {
+			if (ContainHash(tx.TxHash)) {
+				Log::error("should not put in existed tx {}", tx.TxHash.GetHex());
 				return false;
 			}
 
 			return DoTransaction([&iso, &tx, this]() { return this->PutTransactionInternal(iso, tx); });
 		}
 
+		bool TransactionDataStore::ReplaceTransaction(const std::string &iso, const TransactionEntity &tx) {
+			return DoTransaction([&iso, &tx, this]() {
+				if (this->ContainHash(tx.TxHash))
+					return this->UpdateTransactionInternal(iso, tx);
+				return this->PutTransactionInternal(iso, tx);
+			});
+		}
+
 		bool TransactionDataStore::PutTransactions(const std::string &iso, const std::vector<TransactionPtr> &txns) {
 			if (txns.empty())
 				return true;
 
 			return DoTransaction([&iso, &txns, this]() {
 				for (size_t i = 0; i < txns.size(); ++i) {
-					if (!this->PutTransactionInternal(iso, txns[i]))
+					if (!this->PutTransactionInternal(iso, TransactionEntity(*txns[i])))
 						return false;
 				}
 
@@ -110,6 +189,185 @@ namespace Elastos {
 			});
 		}
 
+		bool TransactionDataStore::SyncTransactions(const std::string &iso, const std::vector<TransactionEntity> &txns,
+													TableSyncResult &result) {
+			result = TableSyncResult();
+
+			return DoTransaction([&iso, &txns, &result, this]() {
+				struct Row {
+					bytes_t buff;
+					uint32_t blockHeight;
+					time_t timestamp;
+					std::string iso;
+					bool summarized;
+					TransactionSummary summary;
+					bool seen;
+				};
+				std::map<uint256, Row> rows;
+				std::string sql;
+
+				sql = "SELECT " +
+					  TX_COLUMN_ID + "," +
+					  TX_BUFF + "," +
+					  TX_BLOCK_HEIGHT + "," +
+					  TX_TIME_STAMP + "," +
+					  TX_ISO + "," +
+					  TX_DIRECTION + "," +
+					  TX_AMOUNT + "," +
+					  TX_FEE + "," +
+					  TX_TYPE +
+					  " FROM " + TX_TABLE_NAME + ";";
+
+				sqlite3_stmt *stmt;
+				if (!_sqlite->PrepareCached(sql, &stmt)) {
+					Log::error("prepare sql: {}", sql);
+					return false;
+				}
+
+				while (SQLITE_ROW == _sqlite->Step(stmt)) {
+					Row &row = rows[uint256(*_sqlite->ColumnBlobBytes(stmt, 0))];
+					const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
+					row.buff.assign(pdata, pdata + _sqlite->ColumnBytes(stmt, 1));
+					row.blockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 2);
+					row.timestamp = _sqlite->ColumnInt64(stmt, 3);
+					row.iso = _sqlite->ColumnText(stmt, 4);
+					row.summarized = _sqlite->ColumnType(stmt, 5) != SQLITE_NULL;
+					if (row.summarized) {
+						row.summary.Direction = _sqlite->ColumnText(stmt, 5);
+						row.summary.Amount.setDec(_sqlite->ColumnText(stmt, 6));
+						row.summary.Fee = (uint64_t) _sqlite->ColumnInt64(stmt, 7);
+						row.summary.Type = (uint8_t) _sqlite->ColumnInt(stmt, 8);
+					}
+					row.seen = false;
+				}
+
+				if (!_sqlite->Finalize(stmt)) {
+					Log::error("Tx sync select finalize");
+					return false;
+				}
+
+				for (size_t i = 0; i < txns.size(); ++i) {
+					std::map<uint256, Row>::iterator it = rows.find(txns[i].TxHash);
+					if (it == rows.end()) {
+						if (!this->PutTransactionInternal(iso, txns[i]))
+							return false;
+						result.Inserted++;
+						continue;
+					}
+
+					if (it->second.seen)
+						continue;
+					it->second.seen = true;
+
+					if (it->second.buff == txns[i].Buff && it->second.iso == iso &&
+						it->second.blockHeight == txns[i].BlockHeight && it->second.timestamp == txns[i].Timestamp &&
+						it->second.summarized == txns[i].Summarized &&
+						(!txns[i].Summarized || (it->second.summary.Direction == txns[i].Summary.Direction &&
+												 it->second.summary.Amount == txns[i].Summary.Amount &&
+												 it->second.summary.Fee == txns[i].Summary.Fee &&
+												 it->second.summary.Type == txns[i].Summary.Type))) {
+						result.Unchanged++;
+						continue;
+					}
+
+					if (!this->UpdateTransactionInternal(iso, txns[i]))
+						return false;
+					result.Updated++;
+				}
+
+				for (std::map<uint256, Row>::iterator it = rows.begin(); it != rows.end(); ++it) {
+					if (it->second.seen)
+						continue;
+
+					if (!this->DeleteTxInternal(it->first))
+						return false;
+					result.Deleted++;
+				}
+
+				return true;
+			});
+		}
+
+		bool TransactionDataStore::UpdateTransactionInternal(const std::string &iso, const TransactionEntity &tx) {
+			std::string sql;
+
+			sql = "UPDATE " + TX_TABLE_NAME + " SET " +
+				  TX_BUFF + " = ?, " +
+				  TX_BLOCK_HEIGHT + " = ?, " +
+				  TX_TIME_STAMP + " = ?, " +
+				  TX_ISO + " = ?, " +
+				  TX_DIRECTION + " = ?, " +
+				  TX_AMOUNT + " = ?, " +
+				  TX_FEE + " = ?, " +
+				  TX_TYPE + " = ? WHERE " + TX_COLUMN_ID + " = ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			if (!_sqlite->BindBlob(stmt, 1, tx.Buff, nullptr) ||
+				!_sqlite->BindInt64(stmt, 2, tx.BlockHeight) ||
+				!_sqlite->BindInt64(stmt, 3, tx.Timestamp) ||
+				!_sqlite->BindText(stmt, 4, iso, nullptr) ||
+				!BindSummary(stmt, 5, tx) ||
+				!_sqlite->BindBlob(stmt, 9, tx.TxHash.begin(), tx.TxHash.size(), nullptr)) {
+				Log::error("bind args");
+			}
+
+			if (SQLITE_DONE != _sqlite->Step(stmt)) {
+				Log::error("step");
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx sync update finalize");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool TransactionDataStore::BindSummary(sqlite3_stmt *stmt, int idx, const TransactionEntity &tx) const {
+			if (!tx.Summarized)
+				return _sqlite->BindNull(stmt, idx) &&
+					   _sqlite->BindText(stmt, idx + 1, "0", SQLITE_TRANSIENT) &&
+					   _sqlite->BindInt64(stmt, idx + 2, 0) &&
+					   _sqlite->BindInt(stmt, idx + 3, 0);
+
+			return _sqlite->BindText(stmt, idx, tx.Summary.Direction, nullptr) &&
+				   _sqlite->BindText(stmt, idx + 1, tx.Summary.Amount.getDec(), SQLITE_TRANSIENT) &&
+				   _sqlite->BindInt64(stmt, idx + 2, tx.Summary.Fee) &&
+				   _sqlite->BindInt(stmt, idx + 3, tx.Summary.Type);
+		}
+
+		bool TransactionDataStore::DeleteTxInternal(const uint256 &hash) {
+			std::string sql;
+
+			sql = "DELETE FROM " + TX_TABLE_NAME + " WHERE " + TX_COLUMN_ID + " = ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			if (!_sqlite->BindBlob(stmt, 1, hash.begin(), hash.size(), nullptr)) {
+				Log::error("bind args");
+			}
+
+			if (SQLITE_DONE != _sqlite->Step(stmt)) {
+				Log::error("step");
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx delete finalize");
+				return false;
+			}
+
+			return true;
+		}
+
 		size_t TransactionDataStore::GetAllTransactionsCount() const {
 			size_t count = 0;
 
@@ -118,7 +376,7 @@ namespace Elastos {
 			sql = "SELECT COUNT(" + TX_COLUMN_ID + ") AS nums FROM " + TX_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return 0;
 			}
@@ -136,11 +394,18 @@ namespace Elastos {
 		}
 
 		TransactionPtr TransactionDataStore::GetTransaction(const uint256 &hash, const std::string &chainID) {
-			return SelectTxByHash(hash.GetHex(), chainID);
+			return SelectTxByHash(hash, chainID);
 		}
 
 		std::vector<TransactionPtr> TransactionDataStore::GetAllTransactions(const std::string &chainID) const {
-			std::vector<TransactionPtr> txns;
+			struct RawTx {
+				uint256 hash;
+				bytes_t buff;
+				uint32_t blockHeight;
+				uint32_t timeStamp;
+				bool legacy;
+			};
+			std::vector<RawTx> rows;
 			std::string sql;
 			int r;
 
@@ -152,41 +417,25 @@ namespace Elastos {
 				  TX_ISO +
 				  " FROM " + TX_TABLE_NAME + /*" ORDER BY " + TX_BLOCK_HEIGHT + " ASC*/";";
 
+			// the blobs are copied out on this thread, only the deserialization is fanned out
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 			}
 
 			while (SQLITE_ROW == (r = _sqlite->Step(stmt))) {
-				TransactionPtr tx;
-				if (chainID == CHAINID_MAINCHAIN) {
-					tx = TransactionPtr(new Transaction());
-				} else if (chainID == CHAINID_IDCHAIN || chainID == CHAINID_TOKENCHAIN) {
-					tx = TransactionPtr(new IDTransaction());
-				}
-
-				uint256 txHash(_sqlite->ColumnText(stmt, 0));
+				RawTx row;
+				row.hash = uint256(*_sqlite->ColumnBlobBytes(stmt, 0));
 
 				const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
 				size_t len = (size_t) _sqlite->ColumnBytes(stmt, 1);
-				ByteStream stream(pdata, len);
+				row.buff.assign(pdata, pdata + len);
 
-				uint32_t blockHeight = (uint32_t) _sqlite->ColumnInt(stmt, 2);
-				uint32_t timeStamp = (uint32_t) _sqlite->ColumnInt(stmt, 3);
-				std::string iso = _sqlite->ColumnText(stmt, 4);
-
-				if (iso == "ela") {
-					tx->Deserialize(stream);
-					assert(txHash == tx->GetHash());
-				} else if (iso == "ela1") {
-					tx->Deserialize(stream, true);
-					tx->SetHash(txHash);
-				}
+				row.blockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 2);
+				row.timeStamp = (uint32_t) _sqlite->ColumnInt(stmt, 3);
+				row.legacy = _sqlite->ColumnText(stmt, 4) == "ela";
 
-				tx->SetBlockHeight(blockHeight);
-				tx->SetTimestamp(timeStamp);
-
-				txns.push_back(tx);
+				rows.push_back(std::move(row));
 			}
 
 			if (!_sqlite->Finalize(stmt)) {
@@ -194,30 +443,109 @@ namespace Elastos {
 				return {};
 			}
 
+			std::vector<TransactionPtr> txns(rows.size());
+			size_t threadCount = std::max(1u, boost::thread::hardware_concurrency());
+			threadCount = std::min(threadCount, rows.size() / TX_DESERIALIZE_BATCH + 1);
+
+			std::atomic<size_t> next(0);
+			boost::mutex errorLock;
+			std::exception_ptr error;
+
+			boost::function<void()> worker = [&]() {
+				for (size_t i = next++; i < rows.size(); i = next++) {
+					try {
+						txns[i] = DecodeTx(chainID, rows[i].hash, rows[i].buff.data(), rows[i].buff.size(),
+										   rows[i].blockHeight, rows[i].timeStamp, rows[i].legacy);
+						bytes_t().swap(rows[i].buff);
+					} catch (...) {
+						boost::mutex::scoped_lock scopedLock(errorLock);
+						if (!error)
+							error = std::current_exception();
+						next = rows.size();
+					}
+				}
+			};
+
+			boost::thread_group workers;
+			for (size_t i = 1; i < threadCount; ++i)
+				workers.create_thread(worker);
+			worker();
+			workers.join_all();
+
+			SPVLOG_DEBUG("deserialized {} txs with {} threads", txns.size(), threadCount);
+
+			if (error)
+				std::rethrow_exception(error);
+
 			return txns;
 		}
 
+		bool TransactionDataStore::ForEachTransaction(const std::string &chainID, const HeightRange &range,
+													  const boost::function<bool(const TransactionPtr &)> &visitor) const {
+			std::string sql;
+			int r;
+
+			sql = "SELECT " +
+				  TX_COLUMN_ID + "," +
+				  TX_BUFF + "," +
+				  TX_BLOCK_HEIGHT + "," +
+				  TX_TIME_STAMP + "," +
+				  TX_ISO +
+				  " FROM " + TX_TABLE_NAME;
+			if (!range.IsAll())
+				sql += " WHERE " + TX_BLOCK_HEIGHT + " BETWEEN ? AND ?";
+			sql += ";";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return false;
+			}
+
+			if (!range.IsAll() && (!_sqlite->BindInt64(stmt, 1, range.From) || !_sqlite->BindInt64(stmt, 2, range.To))) {
+				Log::error("bind args");
+			}
+
+			while (SQLITE_ROW == (r = _sqlite->Step(stmt))) {
+				uint256 txHash(*_sqlite->ColumnBlobBytes(stmt, 0));
+				const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
+				size_t len = (size_t) _sqlite->ColumnBytes(stmt, 1);
+				uint32_t blockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 2);
+				uint32_t timeStamp = (uint32_t) _sqlite->ColumnInt(stmt, 3);
+				bool legacy = _sqlite->ColumnText(stmt, 4) == "ela";
+
+				if (!visitor(DecodeTx(chainID, txHash, pdata, len, blockHeight, timeStamp, legacy)))
+					break;
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx for each finalize");
+				return false;
+			}
+
+			return true;
+		}
+
 		bool TransactionDataStore::UpdateTransaction(const std::vector<uint256> &hashes, uint32_t blockHeight,
 													 time_t timestamp) {
 			return DoTransaction([&hashes, &blockHeight, &timestamp, this]() {
-				std::string sql, hash;
+				std::string sql;
 
 				for (size_t i = 0; i < hashes.size(); ++i) {
-					hash = hashes[i].GetHex();
 					sql = "UPDATE " + TX_TABLE_NAME + " SET " +
 						  TX_BLOCK_HEIGHT + " = ?, " +
 						  TX_TIME_STAMP + " = ? " +
 						  " WHERE " + TX_COLUMN_ID + " = ?;";
 
 					sqlite3_stmt *stmt;
-					if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+					if (!_sqlite->PrepareCached(sql, &stmt)) {
 						Log::error("prepare sql: {}", sql);
 						return false;
 					}
 
-					if (!_sqlite->BindInt(stmt, 1, blockHeight) ||
+					if (!_sqlite->BindInt64(stmt, 1, blockHeight) ||
 						!_sqlite->BindInt64(stmt, 2, timestamp) ||
-						!_sqlite->BindText(stmt, 3, hash, nullptr)) {
+						!_sqlite->BindBlob(stmt, 3, hashes[i].begin(), hashes[i].size(), nullptr)) {
 						Log::error("bind args");
 					}
 
@@ -234,53 +562,175 @@ namespace Elastos {
 			});
 		}
 
-		bool TransactionDataStore::DeleteTxByHash(const uint256 &hash) {
-			return DoTransaction([&hash, this]() {
+		std::vector<uint256> TransactionDataStore::GetHashesWithoutSummary() const {
+			std::vector<uint256> hashes;
+			std::string sql;
+
+			sql = "SELECT " + TX_COLUMN_ID + " FROM " + TX_TABLE_NAME + " WHERE " + TX_DIRECTION + " IS NULL;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return {};
+			}
+
+			while (SQLITE_ROW == _sqlite->Step(stmt)) {
+				hashes.push_back(uint256(*_sqlite->ColumnBlobBytes(stmt, 0)));
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx get without summary finalize");
+				return {};
+			}
+
+			return hashes;
+		}
+
+		bool TransactionDataStore::UpdateSummaries(const std::vector<TransactionSummary> &summaries) {
+			if (summaries.empty())
+				return true;
+
+			return DoTransaction([&summaries, this]() {
 				std::string sql;
-				std::string hashString = hash.GetHex();
 
-				sql = "DELETE FROM " + TX_TABLE_NAME + " WHERE " + TX_COLUMN_ID + " = ?;";
+				sql = "UPDATE " + TX_TABLE_NAME + " SET " +
+					  TX_DIRECTION + " = ?, " +
+					  TX_AMOUNT + " = ?, " +
+					  TX_FEE + " = ?, " +
+					  TX_TYPE + " = ? WHERE " + TX_COLUMN_ID + " = ?;";
 
-				sqlite3_stmt *stmt;
-				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
-					Log::error("prepare sql: {}", sql);
-					return false;
-				}
+				for (size_t i = 0; i < summaries.size(); ++i) {
+					const TransactionSummary &summary = summaries[i];
+					sqlite3_stmt *stmt;
+					if (!_sqlite->PrepareCached(sql, &stmt)) {
+						Log::error("prepare sql: {}", sql);
+						return false;
+					}
 
-				if (!_sqlite->BindText(stmt, 1, hashString, nullptr)) {
-					Log::error("bind args");
-				}
+					if (!_sqlite->BindText(stmt, 1, summary.Direction, nullptr) ||
+						!_sqlite->BindText(stmt, 2, summary.Amount.getDec(), SQLITE_TRANSIENT) ||
+						!_sqlite->BindInt64(stmt, 3, summary.Fee) ||
+						!_sqlite->BindInt(stmt, 4, summary.Type) ||
+						!_sqlite->BindBlob(stmt, 5, summary.TxHash.begin(), summary.TxHash.size(), nullptr)) {
+						Log::error("bind args");
+					}
 
-				if (SQLITE_DONE != _sqlite->Step(stmt)) {
-					Log::error("step");
-				}
+					if (SQLITE_DONE != _sqlite->Step(stmt)) {
+						Log::error("step");
+					}
 
-				if (!_sqlite->Finalize(stmt)) {
-					Log::error("Tx delete finalize");
-					return false;
+					if (!_sqlite->Finalize(stmt)) {
+						Log::error("Tx update summary finalize");
+						return false;
+					}
 				}
+
 				return true;
 			});
 		}
 
+		std::vector<TransactionSummary> TransactionDataStore::GetSummaries(const bytes_t &types, size_t start,
+																		   size_t count) const {
+			std::vector<TransactionSummary> summaries;
+			std::string sql;
+
+			sql = "SELECT " +
+				  TX_COLUMN_ID + "," +
+				  TX_DIRECTION + "," +
+				  TX_AMOUNT + "," +
+				  TX_FEE + "," +
+				  TX_TYPE + "," +
+				  TX_BLOCK_HEIGHT + "," +
+				  TX_TIME_STAMP +
+				  " FROM " + TX_TABLE_NAME +
+				  " WHERE " + TX_DIRECTION + " <> ''";
+			if (!types.empty())
+				sql += " AND " + TX_TYPE + " IN (" + TypeList(types) + ")";
+			sql += " ORDER BY " + TX_BLOCK_HEIGHT + " DESC, " + TX_TIME_STAMP + " DESC LIMIT ? OFFSET ?;";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return {};
+			}
+
+			// a negative LIMIT is sqlite's "no limit"
+			int64_t limit = count == TX_SUMMARY_NO_LIMIT ? -1 : (int64_t) std::min(count, (size_t) INT64_MAX);
+			int64_t offset = (int64_t) std::min(start, (size_t) INT64_MAX);
+			if (!_sqlite->BindInt64(stmt, 1, limit) || !_sqlite->BindInt64(stmt, 2, offset)) {
+				Log::error("bind args");
+			}
+
+			while (SQLITE_ROW == _sqlite->Step(stmt)) {
+				TransactionSummary summary;
+				summary.TxHash = uint256(*_sqlite->ColumnBlobBytes(stmt, 0));
+				summary.Direction = _sqlite->ColumnText(stmt, 1);
+				summary.Amount.setDec(_sqlite->ColumnText(stmt, 2));
+				summary.Fee = (uint64_t) _sqlite->ColumnInt64(stmt, 3);
+				summary.Type = (uint8_t) _sqlite->ColumnInt(stmt, 4);
+				summary.BlockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 5);
+				summary.Timestamp = _sqlite->ColumnInt64(stmt, 6);
+				summaries.push_back(summary);
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx get summaries finalize");
+				return {};
+			}
+
+			return summaries;
+		}
+
+		size_t TransactionDataStore::GetSummaryCount(const bytes_t &types) const {
+			size_t count = 0;
+			std::string sql;
+
+			sql = "SELECT COUNT(*) FROM " + TX_TABLE_NAME + " WHERE " + TX_DIRECTION + " <> ''";
+			if (!types.empty())
+				sql += " AND " + TX_TYPE + " IN (" + TypeList(types) + ")";
+			sql += ";";
+
+			sqlite3_stmt *stmt;
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
+				Log::error("prepare sql: {}", sql);
+				return 0;
+			}
+
+			if (SQLITE_ROW == _sqlite->Step(stmt)) {
+				count = (size_t) _sqlite->ColumnInt64(stmt, 0);
+			}
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx get summary count finalize");
+				return 0;
+			}
+
+			return count;
+		}
+
+		bool TransactionDataStore::DeleteTxByHash(const uint256 &hash) {
+			return DoTransaction([&hash, this]() {
+				return this->DeleteTxInternal(hash);
+			});
+		}
+
 		bool TransactionDataStore::DeleteTxByHashes(const std::vector<uint256> &hashes) {
 			if (hashes.empty())
 				return true;
 
 			return DoTransaction([&hashes, this]() {
-				std::string sql, hash;
+				std::string sql;
 				for (size_t i = 0; i < hashes.size(); ++i) {
-					hash = hashes[i].GetHex();
 					sql = "DELETE FROM " + TX_TABLE_NAME +
 						  " WHERE " + TX_COLUMN_ID + " = ?;";
 
 					sqlite3_stmt *stmt;
-					if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+					if (!_sqlite->PrepareCached(sql, &stmt)) {
 						Log::error("prepare sql: {}" + sql);
 						return false;
 					}
 
-					if (!_sqlite->BindText(stmt, 1, hash, nullptr)) {
+					if (!_sqlite->BindBlob(stmt, 1, hashes[i].begin(), hashes[i].size(), nullptr)) {
 						Log::error("bind args");
 					}
 
@@ -300,7 +750,96 @@ namespace Elastos {
 
 		void TransactionDataStore::flush() { _sqlite->flush(); }
 
-		TransactionPtr TransactionDataStore::SelectTxByHash(const std::string &hash, const std::string &chainID) const {
+		bool TransactionDataStore::AddSummaryColumns() {
+			const std::string columns[][2] = {
+				{TX_DIRECTION, "text DEFAULT NULL"},
+				{TX_AMOUNT, "text DEFAULT '0'"},
+				{TX_FEE, "integer DEFAULT 0"},
+				{TX_TYPE, "integer DEFAULT 0"}
+			};
+
+			return DoTransaction([&columns, this]() {
+				std::string sql;
+
+				for (size_t i = 0; i < sizeof(columns) / sizeof(columns[0]); ++i) {
+					if (ColumnType(TX_TABLE_NAME, columns[i][0]).empty())
+						sql += "ALTER TABLE " + TX_TABLE_NAME + " ADD COLUMN " + columns[i][0] + " " + columns[i][1] + ";";
+				}
+				sql += TX_SUMMARY_INDEX_CREATE;
+
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+
+				return true;
+			});
+		}
+
+		bool TransactionDataStore::MigrateUnsignedHeights() {
+			return UnsignInt32Column(TX_TABLE_NAME, TX_BLOCK_HEIGHT);
+		}
+
+		bool TransactionDataStore::MigrateBinaryKeys(size_t batchSize) {
+			std::string legacyTable = TX_TABLE_NAME + "Legacy";
+			// a legacy table left behind means an earlier migration stopped half way, it holds the rows not moved yet
+			if (ColumnType(legacyTable, TX_COLUMN_ID).empty()) {
+				if (!boost::iequals(ColumnType(TX_TABLE_NAME, TX_COLUMN_ID), "text"))
+					return true;
+
+				bool renamed = DoAtomicTransaction([&legacyTable, this]() {
+					std::string sql = "ALTER TABLE " + TX_TABLE_NAME + " RENAME TO " + legacyTable + ";" +
+									  TX_DATABASE_CREATE;
+					if (!_sqlite->exec(sql, nullptr, nullptr)) {
+						Log::error("exec sql: {}", sql);
+						return false;
+					}
+					return true;
+				});
+
+				if (!renamed)
+					return false;
+			}
+
+			std::string columns = TX_COLUMN_ID + "," +
+								  TX_BUFF + "," +
+								  TX_BLOCK_HEIGHT + "," +
+								  TX_TIME_STAMP + "," +
+								  TX_REMARK + "," +
+								  TX_ASSETID + "," +
+								  TX_ISO;
+
+			std::string insertSql = "INSERT INTO " + TX_TABLE_NAME + "(" + columns + ") VALUES (?, ?, ?, ?, ?, ?, ?);";
+
+			size_t count = 0;
+			bool result = MoveLegacyRows(legacyTable, columns, insertSql, [this](sqlite3_stmt *select, sqlite3_stmt *stmt) {
+				uint256 txHash(_sqlite->ColumnText(select, 1));
+				return _sqlite->BindBlob(stmt, 1, txHash.begin(), txHash.size(), SQLITE_TRANSIENT) &&
+					   _sqlite->BindBlob(stmt, 2, _sqlite->ColumnBlob(select, 2), _sqlite->ColumnBytes(select, 2),
+										 nullptr) &&
+					   _sqlite->BindInt64(stmt, 3, _sqlite->ColumnInt64(select, 3)) &&
+					   _sqlite->BindInt64(stmt, 4, _sqlite->ColumnInt64(select, 4)) &&
+					   _sqlite->BindText(stmt, 5, _sqlite->ColumnText(select, 5), SQLITE_TRANSIENT) &&
+					   _sqlite->BindText(stmt, 6, _sqlite->ColumnText(select, 6), SQLITE_TRANSIENT) &&
+					   _sqlite->BindText(stmt, 7, _sqlite->ColumnText(select, 7), SQLITE_TRANSIENT);
+			}, batchSize, count);
+
+			result = result && DoAtomicTransaction([&legacyTable, this]() {
+				std::string sql = "DROP TABLE " + legacyTable + ";" + TX_INDEX_CREATE;
+				if (!_sqlite->exec(sql, nullptr, nullptr)) {
+					Log::error("exec sql: {}", sql);
+					return false;
+				}
+				return true;
+			});
+
+			if (result)
+				Log::info("migrated {} rows of {} to binary keys", count, TX_TABLE_NAME);
+
+			return result;
+		}
+
+		TransactionPtr TransactionDataStore::SelectTxByHash(const uint256 &hash, const std::string &chainID) const {
 			TransactionPtr tx = nullptr;
 
 			std::string sql;
@@ -315,12 +854,12 @@ namespace Elastos {
 				  " WHERE " + TX_COLUMN_ID + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}", sql);
 				return nullptr;
 			}
 
-			if (!_sqlite->BindText(stmt, 1, hash, nullptr)) {
+			if (!_sqlite->BindBlob(stmt, 1, hash.begin(), hash.size(), nullptr)) {
 				Log::error("bind args");
 			}
 
@@ -331,13 +870,13 @@ namespace Elastos {
 					tx = TransactionPtr(new IDTransaction());
 				}
 
-				uint256 txHash(_sqlite->ColumnText(stmt, 0));
+				uint256 txHash(*_sqlite->ColumnBlobBytes(stmt, 0));
 
 				const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
 				size_t len = (size_t) _sqlite->ColumnBytes(stmt, 1);
-				ByteStream stream(pdata, len);
+				ByteStreamView stream(pdata, len);
 
-				uint32_t blockHeight = (uint32_t) _sqlite->ColumnInt(stmt, 2);
+				uint32_t blockHeight = (uint32_t) _sqlite->ColumnInt64(stmt, 2);
 				uint32_t timeStamp = (uint32_t) _sqlite->ColumnInt(stmt, 3);
 				std::string iso = _sqlite->ColumnText(stmt, 4);
 
@@ -361,7 +900,7 @@ namespace Elastos {
 			return tx;
 		}
 
-		bool TransactionDataStore::ContainHash(const std::string &hash) const {
+		bool TransactionDataStore::ContainHash(const uint256 &hash) const {
 			bool contain = false;
 
 			std::string sql;
@@ -372,12 +911,12 @@ namespace Elastos {
 				  " WHERE " + TX_COLUMN_ID + " = ?;";
 
 			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+			if (!_sqlite->PrepareCached(sql, &stmt)) {
 				Log::error("prepare sql: {}" + sql);
 				return false;
 			}
 
-			if (!_sqlite->BindText(stmt, 1, hash, nullptr)) {
+			if (!_sqlite->BindBlob(stmt, 1, hash.begin(), hash.size(), nullptr)) {
 				Log::error("bind args");
 			}
 
@@ -9,6 +9,7 @@
 #include "TableBase.h"
 
 #include <Common/uint256.h>
+#include <Common/Amount.h>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -17,6 +18,41 @@ namespace Elastos {
 
 		typedef boost::shared_ptr<Transaction> TransactionPtr;
 
+		// GetSummaries count that lists every row from start on.
+#define TX_SUMMARY_NO_LIMIT SIZE_MAX
+
+		// Fields of a history listing, stored next to the raw tx so a page is served without deserializing it.
+		// An empty Direction marks a row the wallet doesn't hold, summarized so it isn't looked up again but
+		// left out of listings.
+		struct TransactionSummary {
+			TransactionSummary() : Amount(0), Fee(0), Type(0), BlockHeight(0), Timestamp(0) {}
+
+			uint256 TxHash;
+			std::string Direction;
+			ElaWallet::Amount Amount;
+			uint64_t Fee;
+			uint8_t Type;
+			uint32_t BlockHeight;
+			time_t Timestamp;
+		};
+
+		// A tx as stored, serialized when constructed so the row can be written later without touching the tx.
+		// Built without a summary the row is stored unsummarized, see GetHashesWithoutSummary.
+		struct TransactionEntity {
+			TransactionEntity() : BlockHeight(0), Timestamp(0), Summarized(false) {}
+
+			explicit TransactionEntity(const Transaction &tx);
+
+			TransactionEntity(const Transaction &tx, const TransactionSummary &summary);
+
+			uint256 TxHash;
+			bytes_t Buff;
+			uint32_t BlockHeight;
+			time_t Timestamp;
+			bool Summarized;
+			TransactionSummary Summary;
+		};
+
 		class TransactionDataStore : public TableBase {
 		public:
 			TransactionDataStore(Sqlite *sqlite);
@@ -27,30 +63,69 @@ namespace Elastos {
 
 			bool PutTransaction(const std::string &iso, const TransactionPtr &tx);
 
+			bool PutTransaction(const std::string &iso, const TransactionEntity &tx);
+
+			// Inserts tx, or overwrites the stored row with the same hash.
+			bool ReplaceTransaction(const std::string &iso, const TransactionEntity &tx);
+
 			bool PutTransactions(const std::string &iso, const std::vector<TransactionPtr> &txns);
 
 			bool DeleteAllTransactions();
 
+			// Makes the table match txns, writing only rows that are new, changed or gone.
+			bool SyncTransactions(const std::string &iso, const std::vector<TransactionEntity> &txns,
+								  TableSyncResult &result);
+
 			size_t GetAllTransactionsCount() const;
 
 			TransactionPtr GetTransaction(const uint256 &hash, const std::string &chainID);
 
 			std::vector<TransactionPtr> GetAllTransactions(const std::string &chainID) const;
 
+			// Visits the rows in range one at a time, until visitor returns false.
+			bool ForEachTransaction(const std::string &chainID, const HeightRange &range,
+									const boost::function<bool(const TransactionPtr &)> &visitor) const;
+
 			bool UpdateTransaction(const std::vector<uint256> &hashes, uint32_t blockHeight, time_t timestamp);
 
+			// Rows stored without a summary, written from a bare tx or before DATABASE_SCHEMA_VERSION 2.
+			std::vector<uint256> GetHashesWithoutSummary() const;
+
+			bool UpdateSummaries(const std::vector<TransactionSummary> &summaries);
+
+			// Newest first, restricted to types unless it is empty.
+			std::vector<TransactionSummary> GetSummaries(const bytes_t &types, size_t start, size_t count) const;
+
+			size_t GetSummaryCount(const bytes_t &types) const;
+
 			bool DeleteTxByHash(const uint256 &hash);
 
 			bool DeleteTxByHashes(const std::vector<uint256> &hashes);
 
 			void flush();
 
+			// Rebuilds a table created before DATABASE_SCHEMA_VERSION 1, which keyed rows by hex text, moving
+			// batchSize rows per transaction.
+			bool MigrateBinaryKeys(size_t batchSize = LEGACY_MOVE_BATCH_SIZE);
+
+			// Adds the summary columns missing from a table created before DATABASE_SCHEMA_VERSION 2.
+			bool AddSummaryColumns();
+
+			// Rewrites the heights above INT32_MAX stored as negative values before DATABASE_SCHEMA_VERSION 3.
+			bool MigrateUnsignedHeights();
+
 		private:
-			TransactionPtr SelectTxByHash(const std::string &hash, const std::string &chainID) const;
+			TransactionPtr SelectTxByHash(const uint256 &hash, const std::string &chainID) const;
+
+			bool ContainHash(const uint256 &hash) const;
+
+			bool PutTransactionInternal(const std::string &iso, const TransactionEntity &tx);
+
+			bool UpdateTransactionInternal(const std::string &iso, const TransactionEntity &tx);
 
-			bool ContainHash(const std::string &hash) const;
+			bool BindSummary(sqlite3_stmt *stmt, int idx, const TransactionEntity &tx) const;
 
-			bool PutTransactionInternal(const std::string &iso, const TransactionPtr &tx);
+			bool DeleteTxInternal(const uint256 &hash);
 
 		private:
 			/*
@@ -64,16 +139,35 @@ namespace Elastos {
 			const std::string TX_ISO = "transactionISO";
 			const std::string TX_REMARK = "transactionRemark";
 			const std::string TX_ASSETID = "assetID";
+			const std::string TX_DIRECTION = "transactionDirection";
+			const std::string TX_AMOUNT = "transactionAmount";
+			const std::string TX_FEE = "transactionFee";
+			const std::string TX_TYPE = "transactionType";
 
 			const std::string TX_DATABASE_CREATE = "create table if not exists " +
 												   TX_TABLE_NAME + " (" +
-												   TX_COLUMN_ID + " text not null, " +
+												   TX_COLUMN_ID + " blob not null, " +
 												   TX_BUFF + " blob, " +
 												   TX_BLOCK_HEIGHT + " integer, " +
 												   TX_TIME_STAMP + " integer, " +
 												   TX_REMARK + " text DEFAULT '', " +
 												   TX_ASSETID + " text not null, " +
-												   TX_ISO + " text DEFAULT 'ELA' );";
+												   TX_ISO + " text DEFAULT 'ELA', " +
+												   TX_DIRECTION + " text DEFAULT NULL, " +
+												   TX_AMOUNT + " text DEFAULT '0', " +
+												   TX_FEE + " integer DEFAULT 0, " +
+												   TX_TYPE + " integer DEFAULT 0);";
+
+			const std::string TX_INDEX_CREATE = "create index if not exists txHashIndex on " +
+												TX_TABLE_NAME + " (" + TX_COLUMN_ID + ");" +
+												"create index if not exists txBlockHeightIndex on " +
+												TX_TABLE_NAME + " (" + TX_BLOCK_HEIGHT + ");" +
+												"create index if not exists txTimeStampIndex on " +
+												TX_TABLE_NAME + " (" + TX_TIME_STAMP + ");";
+
+			// created by AddSummaryColumns, older tables don't have the columns yet when TX_INDEX_CREATE runs
+			const std::string TX_SUMMARY_INDEX_CREATE = "create index if not exists txTypeIndex on " +
+														TX_TABLE_NAME + " (" + TX_TYPE + ", " + TX_BLOCK_HEIGHT + ");";
 		};
 
 	} // namespace ElaWallet
@@ -0,0 +1,159 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "WriteBehindQueue.h"
+
+#include <Common/Log.h>
+
+// how long the writer waits for the rest of a batch before committing what it has
+#define BATCH_LINGER_MS 50
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		WriteBehindQueue::WriteBehindQueue(const boost::function<bool()> &beginBatch,
+										   const boost::function<bool()> &endBatch,
+										   size_t capacity) :
+			_beginBatch(beginBatch),
+			_endBatch(endBatch),
+			_capacity(capacity > 0 ? capacity : 1),
+			_batchEnd(false),
+			_writing(false),
+			_stop(false),
+			_flushWaiters(0) {
+			_writer = boost::thread(boost::bind(&WriteBehindQueue::Run, this));
+		}
+
+		WriteBehindQueue::~WriteBehindQueue() {
+			Stop();
+		}
+
+		void WriteBehindQueue::Enqueue(const Operation &op) {
+			Push("", op);
+		}
+
+		void WriteBehindQueue::Enqueue(const std::string &key, const Operation &op) {
+			Push(key, op);
+		}
+
+		void WriteBehindQueue::Push(const std::string &key, const Operation &op) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			while (!_stop && _queue.size() >= _capacity)
+				_space.wait(scopedLock);
+
+			if (_stop) {
+				scopedLock.unlock();
+				std::list<Entry> batch(1);
+				batch.back().Op = op;
+				Write(batch);
+				return;
+			}
+
+			if (!key.empty()) {
+				std::map<std::string, std::list<Entry>::iterator>::iterator it = _keyed.find(key);
+				if (it != _keyed.end()) {
+					_queue.erase(it->second);
+					_keyed.erase(it);
+				}
+
+				std::string prefix = key + "/";
+				it = _keyed.lower_bound(prefix);
+				while (it != _keyed.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+					_queue.erase(it->second);
+					_keyed.erase(it++);
+				}
+			}
+
+			Entry entry;
+			entry.Key = key;
+			entry.Op = op;
+			_queue.push_back(entry);
+			if (!key.empty())
+				_keyed[key] = --_queue.end();
+
+			_wakeup.notify_one();
+		}
+
+		void WriteBehindQueue::EndBatch() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			_batchEnd = true;
+			_wakeup.notify_one();
+		}
+
+		void WriteBehindQueue::Flush() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			++_flushWaiters;
+			_wakeup.notify_one();
+			while (!_queue.empty() || _writing)
+				_done.wait(scopedLock);
+			--_flushWaiters;
+		}
+
+		void WriteBehindQueue::Stop() {
+			{
+				boost::mutex::scoped_lock scopedLock(_lock);
+				_stop = true;
+				_wakeup.notify_one();
+				_space.notify_all();
+			}
+
+			if (_writer.joinable())
+				_writer.join();
+		}
+
+		size_t WriteBehindQueue::PendingCount() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _queue.size();
+		}
+
+		void WriteBehindQueue::Run() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+
+			for (;;) {
+				while (_queue.empty() && !_stop)
+					_wakeup.wait(scopedLock);
+
+				if (_queue.empty())
+					break;
+
+				_wakeup.timed_wait(scopedLock, boost::posix_time::milliseconds(BATCH_LINGER_MS), [this]() {
+					return _batchEnd || _stop || _flushWaiters > 0 || _queue.size() >= _capacity;
+				});
+
+				std::list<Entry> batch;
+				batch.swap(_queue);
+				_keyed.clear();
+				_batchEnd = false;
+				_writing = true;
+				_space.notify_all();
+
+				scopedLock.unlock();
+				Write(batch);
+				scopedLock.lock();
+
+				_writing = false;
+				_done.notify_all();
+			}
+
+			_done.notify_all();
+		}
+
+		void WriteBehindQueue::Write(const std::list<Entry> &batch) {
+			if (!_beginBatch())
+				Log::error("begin write batch failed");
+
+			for (std::list<Entry>::const_iterator it = batch.cbegin(); it != batch.cend(); ++it) {
+				try {
+					it->Op();
+				} catch (const std::exception &e) {
+					Log::error("write behind exception: {}", e.what());
+				}
+			}
+
+			if (!_endBatch())
+				Log::error("commit write batch failed");
+		}
+
+	}
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_WRITEBEHINDQUEUE_H__
+#define __ELASTOS_SDK_WRITEBEHINDQUEUE_H__
+
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+#include <list>
+#include <map>
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Runs database writes on a single writer thread. Everything queued while the writer is busy is
+		 * committed together in one batch, so a block batch costs one commit instead of one per callback.
+		 */
+		class WriteBehindQueue {
+		public:
+			typedef boost::function<void()> Operation;
+
+			WriteBehindQueue(const boost::function<bool()> &beginBatch, const boost::function<bool()> &endBatch,
+							 size_t capacity = 4096);
+
+			~WriteBehindQueue();
+
+			// Blocks while the queue is full. After Stop() the operation runs on the calling thread.
+			void Enqueue(const Operation &op);
+
+			// Drops the pending operation queued under the same key and queues op behind everything else. Keys name
+			// a record as "table/record", a bare "table" key also drops the pending records of that table.
+			void Enqueue(const std::string &key, const Operation &op);
+
+			// Ends the current block batch, the writer commits it without waiting for more operations.
+			void EndBatch();
+
+			// Returns once every operation queued before the call is committed.
+			void Flush();
+
+			// Flushes and joins the writer thread.
+			void Stop();
+
+			size_t PendingCount() const;
+
+		private:
+			struct Entry {
+				std::string Key;
+				Operation Op;
+			};
+
+			void Push(const std::string &key, const Operation &op);
+
+			void Run();
+
+			void Write(const std::list<Entry> &batch);
+
+		private:
+			boost::function<bool()> _beginBatch, _endBatch;
+			size_t _capacity;
+
+			mutable boost::mutex _lock;
+			boost::condition_variable _wakeup, _space, _done;
+			std::list<Entry> _queue;
+			std::map<std::string, std::list<Entry>::iterator> _keyed;
+			bool _batchEnd, _writing, _stop;
+			size_t _flushWaiters;
+			boost::thread _writer;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_WRITEBEHINDQUEUE_H__
@@ -92,24 +92,23 @@ namespace Elastos {
 
 		void IDChainSubWallet::InitDIDList() {
 			_didList.clear();
-			std::vector<DIDEntity> list = _walletManager->loadDIDList();
-			size_t len = list.size();
-			for (size_t i = 0; i < len; ++i) {
+			_walletManager->loadDIDList([this](const DIDEntity &entity) {
 				PayloadPtr infoPtr(new DIDInfo());
-				ByteStream stream(list[i].PayloadInfo);
+				ByteStreamView stream(entity.PayloadInfo);
 				infoPtr->Deserialize(stream, 0);
 
 				DIDDetailPtr didDetailPtr(new DIDDetail());
 				didDetailPtr->SetDIDInfo(infoPtr);
-				didDetailPtr->SetBlockHeighht(list[i].BlockHeight);
-				didDetailPtr->SetIssuanceTime(list[i].CreateTime);
-				didDetailPtr->SetTxHash(list[i].TxHash);
-				didDetailPtr->SetTxTimeStamp(list[i].TimeStamp);
+				didDetailPtr->SetBlockHeighht(entity.BlockHeight);
+				didDetailPtr->SetIssuanceTime(entity.CreateTime);
+				didDetailPtr->SetTxHash(entity.TxHash);
+				didDetailPtr->SetTxTimeStamp(entity.TimeStamp);
 
 				Lock();
 				InsertDID(didDetailPtr);
 				Unlock();
-			}
+				return true;
+			});
 		}
 
 		IDChainSubWallet::~IDChainSubWallet() {
@@ -610,7 +609,7 @@ namespace Elastos {
 			SubWallet::onTxAdded(tx);
 
 			if (tx->GetTransactionType() == IDTransaction::didTransaction) {
-				DIDInfo *payload = dynamic_cast<DIDInfo *>(tx->GetPayload());
+				const DIDInfo *payload = dynamic_cast<const DIDInfo *>(tx->GetPayload());
 				if (payload) {
 					DIDDetailPtr didDetailPtr(new DIDDetail());
 					didDetailPtr->SetDIDInfo(tx->GetPayloadPtr());
@@ -101,7 +101,7 @@ namespace Elastos {
 			ChainConfigPtr configPtr =  _parent->GetChainConfig(sideChainID);
 			OutputArray outputs;
 			Address receiveAddr(configPtr->GenesisAddress());
-			outputs.emplace_back(OutputPtr(new TransactionOutput(value + _config->MinFee(), receiveAddr)));
+			outputs.emplace_back(OutputPtr(new TransactionOutput(Amount(value + _config->MinFee()), receiveAddr)));
 			AddressPtr fromAddr(new Address(fromAddress));
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::transferCrossChainAsset, payload, fromAddr, outputs, memo);
@@ -218,7 +218,7 @@ namespace Elastos {
 			ArgInfo("memo: {}", memo);
 
 			ErrorChecker::CheckBigIntAmount(amount);
-			BigInt bgAmount, minAmount(DEPOSIT_MIN_ELA);
+			Amount bgAmount, minAmount(DEPOSIT_MIN_ELA);
 			bgAmount.setDec(amount);
 
 			minAmount *= SELA_PER_ELA;
@@ -271,7 +271,7 @@ namespace Elastos {
 
 			OutputArray outputs;
 			AddressPtr receiveAddr = wallet->GetReceiveAddress();
-			outputs.push_back(OutputPtr(new TransactionOutput(BigInt(0), *receiveAddr)));
+			outputs.push_back(OutputPtr(new TransactionOutput(Amount(0), *receiveAddr)));
 			AddressPtr fromAddr(new Address(fromAddress));
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::updateProducer, payload, fromAddr, outputs, memo);
@@ -309,7 +309,7 @@ namespace Elastos {
 
 			OutputArray outputs;
 			AddressPtr receiveAddr = wallet->GetReceiveAddress();
-			outputs.push_back(OutputPtr(new TransactionOutput(BigInt(0), *receiveAddr)));
+			outputs.push_back(OutputPtr(new TransactionOutput(Amount(0), *receiveAddr)));
 			AddressPtr fromAddr(new Address(fromAddress));
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::cancelProducer, payload, fromAddr, outputs, memo);
@@ -335,7 +335,7 @@ namespace Elastos {
 			ArgInfo("memo: {}", memo);
 
 			ErrorChecker::CheckBigIntAmount(amount);
-			BigInt bgAmount;
+			Amount bgAmount;
 			bgAmount.setDec(amount);
 
 			ErrorChecker::CheckParam(bgAmount <= 0, Error::CreateTransaction, "output amount should big than zero");
@@ -416,6 +416,7 @@ namespace Elastos {
 			}
 
 			pv->SetVoteContent(voteContent);
+			tx->ResetHash();
 		}
 
 		nlohmann::json MainchainSubWallet::CreateVoteProducerTransaction(
@@ -433,7 +434,7 @@ namespace Elastos {
 			ArgInfo("invalidCandidates: {}", invalidCandidates.dump());
 
 			bool max = false;
-			BigInt bgStake;
+			Amount bgStake;
 			if (stake == "-1") {
 				max = true;
 				bgStake = 0;
@@ -483,7 +484,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			UTXOArray utxos = wallet->GetVoteUTXO();
 			nlohmann::json j;
-			std::map<std::string, BigInt> votedList;
+			std::map<std::string, Amount> votedList;
 
 			for (size_t i = 0; i < utxos.size(); ++i) {
 				const OutputPtr &output = utxos[i]->Output();
@@ -496,7 +497,7 @@ namespace Elastos {
 					continue;
 				}
 
-				BigInt stake = output->Amount();
+				Amount stake = output->Amount();
 				uint8_t version = pv->Version();
 				const std::vector<VoteContent> &voteContents = pv->GetVoteContent();
 				std::for_each(voteContents.cbegin(), voteContents.cend(),
@@ -505,7 +506,7 @@ namespace Elastos {
 									  std::for_each(vc.GetCandidateVotes().cbegin(), vc.GetCandidateVotes().cend(),
 													[&votedList, &stake, &version](const CandidateVotes &cvs) {
 														std::string c = cvs.GetCandidate().getHex();
-														BigInt votes;
+														Amount votes;
 
 														if (version == VOTE_PRODUCER_CR_VERSION)
 															votes = cvs.GetVotes();
@@ -523,7 +524,7 @@ namespace Elastos {
 
 			}
 
-			for (std::map<std::string, BigInt>::iterator it = votedList.begin(); it != votedList.end(); ++it)
+			for (std::map<std::string, Amount>::iterator it = votedList.begin(); it != votedList.end(); ++it)
 				j[(*it).first] = (*it).second.getDec();
 
 			ArgInfo("r => {}", j.dump());
@@ -655,7 +656,7 @@ namespace Elastos {
 			ArgInfo("memo: {}", memo);
 
 			ErrorChecker::CheckBigIntAmount(amount);
-			BigInt bgAmount, minAmount(DEPOSIT_MIN_ELA);
+			Amount bgAmount, minAmount(DEPOSIT_MIN_ELA);
 			bgAmount.setDec(amount);
 
 			minAmount *= SELA_PER_ELA;
@@ -712,7 +713,7 @@ namespace Elastos {
 
 			OutputArray outputs;
 			AddressPtr receiveAddr = wallet->GetReceiveAddress();
-			outputs.push_back(OutputPtr(new TransactionOutput(BigInt(0), *receiveAddr)));
+			outputs.push_back(OutputPtr(new TransactionOutput(Amount(0), *receiveAddr)));
 			AddressPtr fromAddr(new Address(fromAddress));
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::updateCR, payload, fromAddr, outputs, memo);
@@ -754,7 +755,7 @@ namespace Elastos {
 
 			OutputArray outputs;
 			AddressPtr receiveAddr = wallet->GetReceiveAddress();
-			outputs.push_back(OutputPtr(new TransactionOutput(BigInt(0), *receiveAddr)));
+			outputs.push_back(OutputPtr(new TransactionOutput(Amount(0), *receiveAddr)));
 			AddressPtr fromAddr(new Address(fromAddress));
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::unregisterCR, payload, fromAddr, outputs, memo);
@@ -781,7 +782,7 @@ namespace Elastos {
 			ArgInfo("memo: {}", memo);
 
 			ErrorChecker::CheckBigIntAmount(amount);
-			BigInt bgAmount;
+			Amount bgAmount;
 			bgAmount.setDec(amount);
 
 			AddressPtr fromAddress(new Address(PrefixDeposit, bytes_t(crPublicKey)));
@@ -812,13 +813,11 @@ namespace Elastos {
 			ErrorChecker::CheckParam(!votes.is_object(), Error::Code::JsonFormatError, "votes is error json format");
 			ErrorChecker::CheckJsonArray(invalidCandidates, 0, "invalidCandidates is error json format");
 
-			BigInt bgStake = 0;
-
 			VoteContent voteContent(VoteContent::CRC);
 			std::vector<CandidateVotes> candidates;
 			std::string key;
 			bytes_t candidate;
-			BigInt value;
+			Amount value;
 			for (nlohmann::json::const_iterator it = votes.cbegin(); it != votes.cend(); ++it) {
 				ErrorChecker::CheckParam(!it.value().is_string(), Error::InvalidArgument, "stake value should be big int string");
 				std::string voteAmount = it.value().get<std::string>();
@@ -860,7 +859,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			UTXOArray utxos = wallet->GetVoteUTXO();
 			nlohmann::json j;
-			std::map<std::string, BigInt> votedList;
+			std::map<std::string, Amount> votedList;
 
 			for (size_t i = 0; i < utxos.size(); ++i) {
 				const OutputPtr &output = utxos[i]->Output();
@@ -891,7 +890,7 @@ namespace Elastos {
 
 			}
 
-			for (std::map<std::string, BigInt>::iterator it = votedList.begin(); it != votedList.end(); ++it)
+			for (std::map<std::string, Amount>::iterator it = votedList.begin(); it != votedList.end(); ++it)
 				j[(*it).first] = (*it).second.getDec();
 
 			ArgInfo("r => {}", j.dump());
@@ -917,7 +916,7 @@ namespace Elastos {
 				    tx->GetTransactionType() == Transaction::updateCR) {
 					const CRInfo *pinfo = dynamic_cast<const CRInfo *>(tx->GetPayload());
 					if (pinfo) {
-						ByteStream stream(pinfo->GetCode());
+						ByteStreamView stream(pinfo->GetCode());
 						bytes_t pubKey;
 						stream.ReadVarBytes(pubKey);
 						Address did(pinfo->GetDID());
@@ -1090,7 +1089,7 @@ namespace Elastos {
 
 			AddressPtr receiveAddr = wallet->GetReceiveAddress();
 			OutputArray outputs;
-			outputs.push_back(OutputPtr(new TransactionOutput(BigInt(0), *receiveAddr)));
+			outputs.push_back(OutputPtr(new TransactionOutput(Amount(0), *receiveAddr)));
 			AddressPtr fromAddr(new Address(""));
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::crcProposal, payload, fromAddr, outputs, memo);
@@ -1245,12 +1244,11 @@ namespace Elastos {
 
 			ErrorChecker::CheckParam(!votes.is_object(), Error::Code::JsonFormatError, "votes is error json format");
 			ErrorChecker::CheckJsonArray(invalidCandidates, 0, "invalidCandidates is error json format");
-			BigInt bgStake = 0;
 
 			VoteContent voteContent(VoteContent::CRCProposal);
 			std::vector<CandidateVotes> candidates;
 			bytes_t candidate;
-			BigInt value;
+			Amount value;
 			for (nlohmann::json::const_iterator it = votes.cbegin(); it != votes.cend(); ++it) {
 				ErrorChecker::CheckParam(!it.value().is_string(), Error::InvalidArgument, "stake value should be big int string");
 
@@ -1292,13 +1290,12 @@ namespace Elastos {
 
 			ErrorChecker::CheckParam(!votes.is_object(), Error::Code::JsonFormatError, "votes is error json format");
 			ErrorChecker::CheckJsonArray(invalidCandidates, 0, "invalidCandidates is error json format");
-			BigInt bgStake = 0;
 
 			VoteContent voteContent(VoteContent::CRCImpeachment);
 			std::vector<CandidateVotes> candidates;
 			std::string key;
 			bytes_t candidate;
-			BigInt value;
+			Amount value;
 			for (nlohmann::json::const_iterator it = votes.cbegin(); it != votes.cend(); ++it) {
 				ErrorChecker::CheckParam(!it.value().is_string(), Error::InvalidArgument, "stake value should be big int string");
 				ErrorChecker::CheckBigIntAmount(it.value().get<std::string>());
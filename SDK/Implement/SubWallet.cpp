@@ -17,6 +17,7 @@
 #include <WalletCore/CoinInfo.h>
 #include <SpvService/Config.h>
 #include <Wallet/UTXO.h>
+#include <Database/TransactionDataStore.h>
 
 #include <algorithm>
 #include <boost/scoped_ptr.hpp>
@@ -252,7 +253,7 @@ namespace Elastos {
 				ErrorChecker::CheckCondition(true, Error::InvalidArgument, "Decode tx with unknown algorithm");
 			}
 
-			ByteStream stream(rawHex);
+			ByteStreamView stream(rawHex);
 			ErrorChecker::CheckParam(!tx->Deserialize(stream, true), Error::InvalidArgument,
 									 "Invalid input: deserialize fail");
 
@@ -272,7 +273,7 @@ namespace Elastos {
 
 			ErrorChecker::CheckBigIntAmount(amount);
 			bool max = false;
-			BigInt bnAmount;
+			Amount bnAmount;
 			if (amount == "-1") {
 				max = true;
 				bnAmount = 0;
@@ -314,6 +315,32 @@ namespace Elastos {
 			return result;
 		}
 
+		nlohmann::json SubWallet::SignTransactions(const nlohmann::json &createdTxs,
+		                                           const std::string &payPassword) const {
+
+			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
+			ArgInfo("txs: {}", createdTxs.dump());
+			ArgInfo("passwd: *");
+
+			ErrorChecker::CheckJsonArray(createdTxs, 1, "createdTxs");
+
+			std::vector<TransactionPtr> txs;
+			for (nlohmann::json::const_iterator it = createdTxs.cbegin(); it != createdTxs.cend(); ++it)
+				txs.push_back(DecodeTx(*it));
+
+			_walletManager->GetWallet()->SignTransactions(txs, payPassword);
+
+			nlohmann::json result = nlohmann::json::array();
+			for (size_t i = 0; i < txs.size(); ++i) {
+				nlohmann::json signedTx;
+				EncodeTx(signedTx, txs[i]);
+				result.push_back(signedTx);
+			}
+
+			ArgInfo("r => {}", result.dump());
+			return result;
+		}
+
 		nlohmann::json SubWallet::PublishTransaction(const nlohmann::json &signedTx) {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
 			ArgInfo("tx: {}", signedTx.dump());
@@ -385,7 +412,7 @@ namespace Elastos {
 			std::vector<nlohmann::json> jsonList;
 			const WalletPtr &wallet = _walletManager->GetWallet();
 
-			j["MaxCount"] = wallet->GetAllTransactionCount();
+			j["MaxCount"] = _walletManager->GetTransactionSummaryCount(bytes_t());
 
 			if (!txid.empty()) {
 				uint256 txHash(txid);
@@ -398,10 +425,13 @@ namespace Elastos {
 					j["Transactions"] = {};
 				}
 			} else {
-				std::vector<TransactionPtr> txns = wallet->GetAllTransactions(start, count);
-				for (size_t i = 0; i < txns.size(); ++i) {
-					confirms = txns[i]->GetConfirms(wallet->LastBlockHeight());
-					jsonList.push_back(txns[i]->GetSummary(wallet, confirms, false));
+				// the page comes from the summary columns, no tx is deserialized or walked for it
+				std::vector<TransactionSummary> summaries = _walletManager->GetTransactionSummaries(bytes_t(), start,
+																									 count);
+				uint32_t lastBlockHeight = wallet->LastBlockHeight();
+				for (size_t i = 0; i < summaries.size(); ++i) {
+					confirms = Transaction::GetConfirms(summaries[i].BlockHeight, lastBlockHeight);
+					jsonList.push_back(Transaction::GetSummary(summaries[i], confirms));
 				}
 				j["Transactions"] = jsonList;
 			}
@@ -485,7 +515,7 @@ namespace Elastos {
 			_walletManager->PublishTransaction(tx);
 		}
 
-		void SubWallet::balanceChanged(const uint256 &assetID, const BigInt &balance) {
+		void SubWallet::balanceChanged(const uint256 &assetID, const Amount &balance) {
 			ArgInfo("{} {} Balance: {}", _walletManager->GetWallet()->GetWalletID(), GetFunName(), balance.getDec());
 			boost::mutex::scoped_lock scoped_lock(lock);
 
@@ -85,6 +85,10 @@ namespace Elastos {
 					const nlohmann::json &createdTx,
 					const std::string &payPassword) const;
 
+			virtual nlohmann::json SignTransactions(
+					const nlohmann::json &createdTxs,
+					const std::string &payPassword) const;
+
 			virtual nlohmann::json GetTransactionSignedInfo(
 					const nlohmann::json &rawTransaction) const;
 
@@ -111,7 +115,7 @@ namespace Elastos {
 			virtual void SyncStop();
 
 		protected: //implement Wallet::Listener
-			virtual void balanceChanged(const uint256 &asset, const BigInt &balance);
+			virtual void balanceChanged(const uint256 &asset, const Amount &balance);
 
 			virtual void onCoinBaseTxAdded(const UTXOPtr &cb);
 
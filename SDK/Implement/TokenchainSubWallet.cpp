@@ -49,7 +49,7 @@ namespace Elastos {
 			ArgInfo("memo: {}", memo);
 
 			ErrorChecker::CheckBigIntAmount(registerAmount);
-			BigInt assetAmount;
+			Amount assetAmount;
 			assetAmount.setDec(registerAmount);
 
 			ErrorChecker::CheckParam(wallet->AssetNameExist(name), Error::InvalidArgument,
@@ -63,12 +63,14 @@ namespace Elastos {
 
 			OutputArray outputs;
 			AddressPtr receiveAddr = wallet->GetReceiveAddress();
-			outputs.emplace_back(OutputPtr(new TransactionOutput(BigInt(1000000000), *receiveAddr, Asset::GetELAAssetID())));
+			outputs.emplace_back(OutputPtr(new TransactionOutput(Amount(1000000000), *receiveAddr, Asset::GetELAAssetID())));
 			AddressPtr fromAddr(new Address());
 
 			TransactionPtr tx = wallet->CreateTransaction(Transaction::registerAsset, payload, fromAddr, outputs, memo);
 
-			assetAmount *= BigInt(TOKEN_ASSET_PRECISION, 10);
+			Amount assetPrecision;
+			assetPrecision.setDec(TOKEN_ASSET_PRECISION);
+			assetAmount *= assetPrecision;
 			tx->AddOutput(OutputPtr(new TransactionOutput(assetAmount, address, asset->GetHash())));
 
 			if (tx->GetOutputs().size() > 0) {
@@ -103,11 +105,11 @@ namespace Elastos {
 
 			uint8_t invalidPrecision = Asset::MaxPrecision - assetInfo->GetPrecision();
 			assert(invalidPrecision < Asset::MaxPrecision);
-			BigInt bn(1);
+			Amount bn(1);
 			for (size_t i = 0; i < invalidPrecision; ++i)
 				bn *= 10;
 
-			BigInt bnAmount;
+			Amount bnAmount;
 			bnAmount.setDec(amount);
 
 			ErrorChecker::CheckParam((bnAmount % bn) != 0, Error::InvalidArgument, "amount exceed max presicion");
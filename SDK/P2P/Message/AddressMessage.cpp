@@ -19,7 +19,7 @@ namespace Elastos {
 		}
 
 		bool AddressMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 			uint64_t count = 0;
 
 			if (!stream.ReadUint64(count)) {
@@ -26,7 +26,7 @@ namespace Elastos {
 		}
 
 		bool InventoryMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 			uint32_t type;
 
 			uint32_t count;
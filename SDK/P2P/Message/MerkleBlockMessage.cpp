@@ -28,7 +28,7 @@ namespace Elastos {
 
 		bool MerkleBlockMessage::Accept(const bytes_t &msg) {
 			std::vector<uint256> txHashes;
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 
 			PeerManager *manager = _peer->GetPeerManager();
 			MerkleBlockPtr block(Registry::Instance()->CreateMerkleBlock(manager->GetChainID()));
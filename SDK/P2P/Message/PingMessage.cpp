@@ -21,7 +21,7 @@ namespace Elastos {
 		}
 
 		bool PingMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 			uint64_t height;
 
 			if (!stream.ReadUint64(height)) {
@@ -15,7 +15,7 @@ namespace Elastos {
 		}
 
 		bool RejectMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 
 			std::string type;
 			if (!stream.ReadVarString(type)) {
@@ -25,7 +25,7 @@ namespace Elastos {
 		bool TransactionMessage::Accept(const bytes_t &msg) {
 			std::string chainID = _peer->GetPeerManager()->GetChainID();
 
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 
 			TransactionPtr tx;
 			if (chainID == CHAINID_MAINCHAIN) {
@@ -68,7 +68,7 @@ namespace Elastos {
 			PEER_INFO(_peer, "sending tx {}", txParam.tx->GetHash().GetHex());
 
 			ByteStream stream;
-			txParam.tx->Serialize(stream);
+			stream.WriteExact([&txParam](ByteStream &s) { txParam.tx->Serialize(s); });
 			SendMessage(stream.GetBytes(), Type());
 		}
 
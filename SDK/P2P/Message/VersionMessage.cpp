@@ -20,7 +20,7 @@ namespace Elastos {
 		}
 
 		bool VersionMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStreamView stream(msg);
 
 			uint32_t version = 0;
 			if (!stream.ReadUint32(version)) {
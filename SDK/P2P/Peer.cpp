@@ -201,14 +201,16 @@ namespace Elastos {
 				struct timeval tv;
 				int socket, error = 0;
 				ByteStream stream;
+				stream.Reserve(HEADER_LENGTH + message.size());
 
 				stream.WriteUint32(_magicNumber);
-				stream.WriteBytes(bytes_t(type.c_str(), type.size()));
+				stream.WriteBytes(type.c_str(), type.size());
 				if (type.size() < 12)
 					stream.WriteBytes(bytes_t(12 - type.size(), 0));
 				stream.WriteUint32(message.size());
-				bytes_t hash = sha256_2(message);
-				stream.WriteUint32(*(uint32_t *)hash.data());
+				uint256 hash;
+				sha256_2(message.data(), message.size(), hash);
+				stream.WriteUint32(*(uint32_t *)hash.begin());
 				stream.WriteBytes(message);
 
 				const bytes_t &buf = stream.GetBytes();
@@ -409,9 +411,10 @@ namespace Elastos {
 									this->error("read message error: {}", FormatError(error));
 								}
 							} else if (len == msgLen) {
-								bytes_t hash = sha256_2(payload);;
+								uint256 hash;
+								sha256_2(payload.data(), payload.size(), hash);
 
-								if (*(uint32_t *)(&hash[0]) != checksum) { // verify checksum
+								if (*(uint32_t *)hash.begin() != checksum) { // verify checksum
 									this->error("reading {}, invalid checksum {:x}, expected {:x}, payload length:{},",
 												type, UInt32GetLE(&hash), checksum, msgLen);
 									error = EPROTO;
@@ -587,24 +590,20 @@ namespace Elastos {
 			_lastBlockHash = hash;
 		}
 
-		const std::set<uint256> &Peer::KnownTxHashSet() const {
+		const FlatHashSet<uint256> &Peer::KnownTxHashSet() const {
 			return _knownTxHashSet;
 		}
 
 		void Peer::AddKnownTxHashes(const std::vector<uint256> &txHashes) {
 			for (size_t i = 0; i < txHashes.size(); i++) {
-				if (_knownTxHashSet.find(txHashes[i]) == _knownTxHashSet.end()) {
+				if (_knownTxHashSet.insert(txHashes[i]).second)
 					_knownTxHashes.push_back(txHashes[i]);
-					_knownTxHashSet.insert(txHashes[i]);
-				}
 			}
 		}
 
 		void Peer::RemoveKnownTxHashes(const std::vector<uint256> &txHashes) {
 			for (size_t i = 0; i < txHashes.size(); ++i) {
-				if (_knownTxHashSet.find(txHashes[i]) != _knownTxHashSet.end()) {
-					_knownTxHashSet.erase(txHashes[i]);
-				}
+				_knownTxHashSet.erase(txHashes[i]);
 
 				for (std::vector<uint256>::iterator it = _knownTxHashes.begin(); it != _knownTxHashes.end();) {
 					if ((*it) == txHashes[i]) {
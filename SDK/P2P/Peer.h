@@ -10,6 +10,7 @@
 
 #include <Common/Log.h>
 #include <Common/ElementSet.h>
+#include <Common/FlatHashMap.h>
 #include <Common/uint256.h>
 
 #include <deque>
@@ -216,7 +217,7 @@ namespace Elastos {
 
 			void SetLastBlockHash(const uint256 &hash);
 
-			const std::set<uint256> &KnownTxHashSet() const;
+			const FlatHashSet<uint256> &KnownTxHashSet() const;
 
 			void AddKnownTxHashes(const std::vector<uint256> &txHashes);
 
@@ -372,7 +373,7 @@ namespace Elastos {
 			uint256 _lastBlockHash;
 			MerkleBlockPtr _currentBlock;
 			std::vector<uint256> _currentBlockTxHashes, _knownBlockHashes, _knownTxHashes;
-			std::set<uint256> _knownTxHashSet;
+			FlatHashSet<uint256> _knownTxHashSet;
 			volatile int _socket;
 
 			PeerCallback _mempoolCallback;
@@ -36,6 +36,7 @@
 #define MAX_CONNECT_FAILURES  1000 // notify user of network problems after this many connect failures in a row
 #define PEER_FLAG_SYNCED      0x01
 #define PEER_FLAG_NEEDSUPDATE 0x02
+#define BLOCK_COMPACT_DEPTH   100 // main chain blocks this deep are not expected to be reorganized anymore
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -1410,6 +1411,7 @@ namespace Elastos {
 					if (txHashes.size() > 0)
 						_wallet->UpdateTransactions(txHashes, block->GetHeight(), block->GetTimestamp());
 					if (_downloadPeer) _downloadPeer->SetCurrentBlockHeight(block->GetHeight());
+					CompactBlocks(block);
 
 					if (block->GetHeight() < _estimatedHeight && peer == _downloadPeer) {
 						peer->ScheduleDisconnect(PROTOCOL_TIMEOUT); // reschedule sync timeout
@@ -1886,6 +1888,30 @@ namespace Elastos {
 			return r;
 		}
 
+		// blocks at or below the last checkpoint can't be forked anymore and are compacted as soon as they extend the
+		// main chain, above it the block BLOCK_COMPACT_DEPTH behind the new tip is
+		void PeerManager::CompactBlocks(const MerkleBlockPtr &block) {
+			if (block->GetHeight() <= _chainParams->LastCheckpoint().Height()) {
+				block->Compact();
+				_uncompactedBlocks.clear();
+				return;
+			}
+
+			// after a reorg or a reload the window doesn't end at the new block's parent, walk the chain back once
+			if (_uncompactedBlocks.empty() || _uncompactedBlocks.back()->GetHash() != block->GetPrevBlockHash()) {
+				_uncompactedBlocks.clear();
+				for (MerkleBlockPtr b = _blocks.Get(block->GetPrevBlockHash());
+					 b && _uncompactedBlocks.size() < BLOCK_COMPACT_DEPTH; b = _blocks.Get(b->GetPrevBlockHash()))
+					_uncompactedBlocks.push_front(b);
+			}
+
+			_uncompactedBlocks.push_back(block);
+			while (_uncompactedBlocks.size() > BLOCK_COMPACT_DEPTH) {
+				_uncompactedBlocks.front()->Compact();
+				_uncompactedBlocks.pop_front();
+			}
+		}
+
 		std::vector<uint256> PeerManager::GetBlockLocators() {
 			// append 10 most recent block hashes, decending, then continue appending, doubling the step back each time,
 			// finishing with the genesis block (top, -1, -2, -3, -4, -5, -6, -7, -8, -9, -11, -15, -23, -39, -71, -135, ..., 0)
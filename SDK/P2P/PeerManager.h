@@ -17,6 +17,7 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <boost/weak_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/function.hpp>
@@ -235,6 +236,8 @@ namespace Elastos {
 
 			bool VerifyBlock(const MerkleBlockPtr &block, const MerkleBlockPtr &prev, const PeerPtr &peer);
 
+			void CompactBlocks(const MerkleBlockPtr &block);
+
 			std::vector<uint256> GetBlockLocators();
 
 			void LoadMempools();
@@ -287,6 +290,8 @@ namespace Elastos {
 			BlockSet _orphans;
 			BlockSet _checkpoints;
 			MerkleBlockPtr _lastBlock, _lastOrphan;
+			// main chain blocks above the last checkpoint not compacted yet, oldest first, ending at _lastBlock
+			std::deque<MerkleBlockPtr> _uncompactedBlocks;
 			std::vector<TransactionPeerList> _txRelays, _txRequests;
 			std::vector<PublishedTransaction> _publishedTx;
 			std::vector<uint256> _publishedTxHashes;
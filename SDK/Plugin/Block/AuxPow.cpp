@@ -53,7 +53,7 @@ namespace Elastos {
 			return SerializeBtcBlockHeader(ostream, _parBlockHeader);
 		}
 
-		bool AuxPow::Deserialize(const ByteStream &istream) {
+		bool AuxPow::Deserialize(const ByteStreamView &istream) {
 			if (!DeserializeBtcTransaction(istream, _parCoinBaseTx)) {
 				Log::error("deserialize AuxPow btc tx error");
 				return false;
@@ -126,7 +126,7 @@ namespace Elastos {
 			ostream.WriteUint32(tx->lockTime);
 		}
 
-		bool AuxPow::DeserializeBtcTransaction(const ByteStream &istream, BRTransaction *tx) {
+		bool AuxPow::DeserializeBtcTransaction(const ByteStreamView &istream, BRTransaction *tx) {
 			if (!istream.ReadUint32(tx->version)) {
 				Log::error("deserialize version error");
 				return false;
@@ -171,7 +171,7 @@ namespace Elastos {
 			ostream.WriteUint32(in->sequence);
 		}
 
-		bool AuxPow::DeserializeBtcTxIn(const ByteStream &istream, BRTransaction *tx) {
+		bool AuxPow::DeserializeBtcTxIn(const ByteStreamView &istream, BRTransaction *tx) {
 			UInt256 txHash;
 			if (!istream.ReadBytes(txHash.u8, sizeof(txHash))) {
 				Log::error("deserialize txHash error");
@@ -206,7 +206,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(out->script, out->scriptLen);
 		}
 
-		bool AuxPow::DeserializeBtcTxOut(const ByteStream &istream, BRTransaction *tx) {
+		bool AuxPow::DeserializeBtcTxOut(const ByteStreamView &istream, BRTransaction *tx) {
 			uint64_t amount = 0;
 			if (!istream.ReadUint64(amount)) {
 				Log::error("deserialize amount error");
@@ -232,7 +232,7 @@ namespace Elastos {
 			ostream.WriteUint32(b->nonce);
 		}
 
-		bool AuxPow::DeserializeBtcBlockHeader(const ByteStream &istream, BRMerkleBlock *b) {
+		bool AuxPow::DeserializeBtcBlockHeader(const ByteStreamView &istream, BRMerkleBlock *b) {
 			if (!istream.ReadUint32(b->version)) {
 				Log::error("deserialize version error");
 				return false;
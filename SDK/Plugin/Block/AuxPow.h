@@ -38,7 +38,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
 
 			BRTransaction *GetBTCTransaction() const;
 
@@ -53,19 +53,19 @@ namespace Elastos {
 		private:
 			void SerializeBtcTransaction(ByteStream &ostream, const BRTransaction *tx) const;
 
-			bool DeserializeBtcTransaction(const ByteStream &istream, BRTransaction *tx);
+			bool DeserializeBtcTransaction(const ByteStreamView &istream, BRTransaction *tx);
 
 			void SerializeBtcTxIn(ByteStream &ostream, const BRTxInput *in) const;
 
-			bool DeserializeBtcTxIn(const ByteStream &istream, BRTransaction *tx);
+			bool DeserializeBtcTxIn(const ByteStreamView &istream, BRTransaction *tx);
 
 			void SerializeBtcTxOut(ByteStream &ostream, const BRTxOutput *out) const;
 
-			bool DeserializeBtcTxOut(const ByteStream &istream, BRTransaction *tx);
+			bool DeserializeBtcTxOut(const ByteStreamView &istream, BRTransaction *tx);
 
 			void SerializeBtcBlockHeader(ByteStream &ostream, const BRMerkleBlock *b) const;
 
-			bool DeserializeBtcBlockHeader(const ByteStream &istream, BRMerkleBlock *b);
+			bool DeserializeBtcBlockHeader(const ByteStreamView &istream, BRMerkleBlock *b);
 
 		private:
 			std::vector<uint256> _auxMerkleBranch;
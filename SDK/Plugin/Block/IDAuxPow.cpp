@@ -60,7 +60,7 @@ namespace Elastos {
 			_mainBlockHeader->auxPow.Serialize(stream);
 		}
 
-		bool IDAuxPow::Deserialize(const ByteStream &stream) {
+		bool IDAuxPow::Deserialize(const ByteStreamView &stream) {
 			if (!_idAuxBlockTx.Deserialize(stream)) {
 				return false;
 			}
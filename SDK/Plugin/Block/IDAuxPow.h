@@ -28,7 +28,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
 
 			IDAuxPow &operator=(const IDAuxPow &idAuxPow);
 
@@ -51,7 +51,8 @@ namespace Elastos {
 			if (_blockHash == 0) {
 				ByteStream ostream;
 				MerkleBlockBase::SerializeNoAux(ostream);
-				_blockHash = sha256_2(ostream.GetBytes());
+				const bytes_t &header = ostream.GetBytes();
+				sha256_2(header.data(), header.size(), _blockHash);
 			}
 			return _blockHash;
 		}
@@ -65,8 +66,7 @@ namespace Elastos {
 			// bit is the sign, and the remaining 23bits is the value after having been right shifted by (size - 3)*8 bits
 			static const uint32_t maxsize = MAX_PROOF_OF_WORK >> 24, maxtarget = MAX_PROOF_OF_WORK & 0x00ffffff;
 			const uint32_t size = _target >> 24, target = _target & 0x00ffffff;
-			size_t hashIdx = 0, flagIdx = 0;
-			uint256 merkleRoot = MerkleBlockRootR(&hashIdx, &flagIdx, 0), t;
+			uint256 merkleRoot = MerkleBlockRoot(), t;
 			int r = 1;
 
 			// check if merkle root is correct
@@ -103,15 +103,28 @@ namespace Elastos {
 			MerkleBlockBase::SerializeAfterAux(ostream);
 		}
 
-		bool MerkleBlock::Deserialize(const ByteStream &istream) {
+		bool MerkleBlock::Deserialize(const ByteStreamView &istream) {
+			if (!DeserializeUnhashed(istream))
+				return false;
+
+			GetHash();
+			return true;
+		}
+
+		bool MerkleBlock::DeserializeUnhashed(const ByteStreamView &istream) {
 			if (!MerkleBlockBase::DeserializeNoAux(istream) || !_auxPow.Deserialize(istream) ||
 				!MerkleBlockBase::DeserializeAfterAux(istream))
 				return false;
 
-			GetHash();
+			_blockHash = 0;
 			return true;
 		}
 
+		void MerkleBlock::Compact() {
+			MerkleBlockBase::Compact();
+			_auxPow = AuxPow();
+		}
+
 		const AuxPow &MerkleBlock::GetAuxPow() const {
 			return _auxPow;
 		}
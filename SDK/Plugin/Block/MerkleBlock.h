@@ -30,7 +30,9 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
+
+			virtual bool DeserializeUnhashed(const ByteStreamView &istream);
 
 			virtual const uint256 &GetHash() const;
 
@@ -38,6 +40,8 @@ namespace Elastos {
 
 			virtual std::string GetBlockType() const { return "ELA"; }
 
+			virtual void Compact();
+
 			const AuxPow &GetAuxPow() const;
 
 			void SetAuxPow(const AuxPow &pow);
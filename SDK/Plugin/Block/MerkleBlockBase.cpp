@@ -9,6 +9,9 @@
 #include <Common/ByteStream.h>
 #include <Common/Utils.h>
 #include <Common/hash.h>
+#include <Common/SHA256D.h>
+
+#include <algorithm>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -16,7 +19,17 @@ namespace Elastos {
 		namespace {
 			namespace {
 
-				inline static int _ceil_log2(int x) {
+				// a block has at most 2^32 transactions, so the tree is never deeper than this
+				const int MERKLE_MAX_DEPTH = 32;
+
+				const uint32_t MERKLE_NODE_INTERNAL = 0xFFFFFFFF, MERKLE_NODE_MISSING = 0xFFFFFFFE;
+
+				struct MerkleNode {
+					uint32_t source; // index into _hashes, or one of the two values above
+					uint8_t depth;
+				};
+
+				inline static int _ceil_log2(uint32_t x) {
 					int r = (x & (x - 1)) ? 1 : 0;
 
 					while ((x >>= 1) != 0) r++;
@@ -31,7 +44,8 @@ namespace Elastos {
 				_target(0),
 				_nonce(0),
 				_totalTx(0),
-				_height(0) {
+				_height(0),
+				_txHashesCached(false) {
 		}
 
 		MerkleBlockBase::~MerkleBlockBase() {
@@ -100,6 +114,7 @@ namespace Elastos {
 
 		void MerkleBlockBase::SetTransactionCount(uint32_t count) {
 			_totalTx = count;
+			ResetTxHashesCache();
 		}
 
 		const std::vector<uint256> &MerkleBlockBase::GetHashes() const {
@@ -108,6 +123,7 @@ namespace Elastos {
 
 		void MerkleBlockBase::SetHashes(const std::vector<uint256> &hashes) {
 			_hashes = hashes;
+			ResetTxHashesCache();
 		}
 
 		const std::vector<uint8_t> &MerkleBlockBase::GetFlags() const {
@@ -116,6 +132,7 @@ namespace Elastos {
 
 		void MerkleBlockBase::SetFlags(const std::vector<uint8_t> &flags) {
 			_flags = flags;
+			ResetTxHashesCache();
 		}
 
 		void MerkleBlockBase::SerializeNoAux(ByteStream &ostream) const {
@@ -128,7 +145,11 @@ namespace Elastos {
 			ostream.WriteUint32(_height);
 		}
 
-		bool MerkleBlockBase::DeserializeNoAux(const ByteStream &istream) {
+		void MerkleBlockBase::SerializeHeader(ByteStream &ostream) const {
+			SerializeNoAux(ostream);
+		}
+
+		bool MerkleBlockBase::DeserializeNoAux(const ByteStreamView &istream) {
 			if (!istream.ReadUint32(_version))
 				return false;
 
@@ -166,8 +187,9 @@ namespace Elastos {
 			ostream.WriteVarBytes(_flags);
 		}
 
-		bool MerkleBlockBase::DeserializeAfterAux(const ByteStream &istream) {
+		bool MerkleBlockBase::DeserializeAfterAux(const ByteStreamView &istream) {
 			istream.Skip(1);    //correspond to serialization of node, should get one byte here
+			ResetTxHashesCache();
 
 			if (!istream.ReadUint32(_totalTx))
 				return false;
@@ -190,68 +212,126 @@ namespace Elastos {
 		}
 
 		size_t MerkleBlockBase::MerkleBlockTxHashes(std::vector<uint256> &txHashes) const {
-			size_t hashIdx = 0, flagIdx = 0;
+			if (_txHashesCached) {
+				txHashes.insert(txHashes.end(), _txHashes.begin(), _txHashes.end());
+				return txHashes.size();
+			}
 
-			return MerkleBlockTxHashesR(txHashes, hashIdx, flagIdx, 0);
+			MerkleBlockDecode(&txHashes, nullptr);
+			return txHashes.size();
 		}
 
-		size_t MerkleBlockBase::MerkleBlockTxHashesR(std::vector<uint256> &txHashes, size_t &hashIdx, size_t &flagIdx,
-													 int depth) const {
-			uint8_t flag;
+		uint256 MerkleBlockBase::MerkleBlockRoot() const {
+			uint256 root;
 
-			if (flagIdx / 8 < _flags.size() && hashIdx < _hashes.size()) {
-				flag = (_flags[flagIdx / 8] & (1 << (flagIdx % 8)));
-				flagIdx++;
+			_txHashes.clear();
+			MerkleBlockDecode(&_txHashes, &root);
+			_txHashesCached = true;
+			return root;
+		}
 
-				if (! flag || depth == ceilLog2(_totalTx)) {
-					if (flag) {
-						txHashes.push_back(_hashes[hashIdx]); // leaf
+		// walks the partial merkle tree depth first with an explicit stack, appending the matched tx hashes to txHashes.
+		// if root is given the nodes are also laid out level by level, left to right, and the root is calculated one
+		// level at a time. the children of the internal nodes of a level are then the whole level below, in pairs, so
+		// each level is hashed in place with a single batch. returns the number of matched hashes
+		// NOTE: this merkle tree design has a security vulnerability (CVE-2012-2459), which can be defended against by
+		// considering the merkle root invalid if there are duplicate hashes in any rows with an even number of elements
+		size_t MerkleBlockBase::MerkleBlockDecode(std::vector<uint256> *txHashes, uint256 *root) const {
+			const int height = _ceil_log2(_totalTx);
+			const size_t flagBits = _flags.size() * 8;
+			uint8_t stack[MERKLE_MAX_DEPTH + 2]; // one pending right branch per level, plus the node being walked
+			size_t levelSize[MERKLE_MAX_DEPTH + 2] = {0}, levelStart[MERKLE_MAX_DEPTH + 2];
+			std::vector<MerkleNode> nodes;
+			size_t top = 0, hashIdx = 0, flagIdx = 0, matched = 0;
+
+			if (root)
+				nodes.reserve(flagBits + 1);
+
+			stack[top++] = 0;
+			while (top > 0) {
+				uint8_t depth = stack[--top];
+				MerkleNode node = {MERKLE_NODE_MISSING, depth};
+
+				if (flagIdx < flagBits && hashIdx < _hashes.size()) {
+					bool flag = (_flags[flagIdx / 8] & (1 << (flagIdx % 8))) != 0;
+					flagIdx++;
+
+					if (flag && depth != height) {
+						node.source = MERKLE_NODE_INTERNAL;
+						stack[top++] = depth + 1; // right branch
+						stack[top++] = depth + 1; // left branch, walked first
+					} else {
+						if (flag) {
+							if (txHashes)
+								txHashes->push_back(_hashes[hashIdx]); // leaf
+							matched++;
+						}
+						node.source = (uint32_t) hashIdx++;
 					}
+				}
 
-					hashIdx++;
-				} else {
-					MerkleBlockTxHashesR(txHashes, hashIdx, flagIdx, depth + 1); // left branch
-					MerkleBlockTxHashesR(txHashes, hashIdx, flagIdx, depth + 1); // right branch
+				if (root) {
+					nodes.push_back(node);
+					levelSize[depth]++;
 				}
 			}
 
-			return txHashes.size();
-		}
+			if (!root)
+				return matched;
+
+			*root = uint256();
+			levelStart[0] = 0;
+			for (int depth = 0; depth <= height; ++depth)
+				levelStart[depth + 1] = levelStart[depth] + levelSize[depth];
+
+			// missing branches stay zero
+			std::vector<uint256> hashes(nodes.size());
+			std::vector<uint8_t> internal(nodes.size(), 0);
+			size_t next[MERKLE_MAX_DEPTH + 2];
+			std::copy(levelStart, levelStart + height + 1, next);
+			for (size_t i = 0; i < nodes.size(); ++i) {
+				size_t pos = next[nodes[i].depth]++;
+				if (nodes[i].source == MERKLE_NODE_INTERNAL)
+					internal[pos] = 1;
+				else if (nodes[i].source != MERKLE_NODE_MISSING)
+					hashes[pos] = _hashes[nodes[i].source];
+			}
 
-		int MerkleBlockBase::ceilLog2(int x) const {
-			int r = (x & (x - 1)) ? 1 : 0;
+			std::vector<uint256> parents;
+			for (int depth = height - 1; depth >= 0; --depth) {
+				size_t count = levelSize[depth + 1] / 2;
+				uint256 *children = hashes.data() + levelStart[depth + 1];
 
-			while ((x >>= 1) != 0) r++;
-			return r;
-		}
+				if (count == 0)
+					continue;
 
-		// recursively walks the merkle tree to calculate the merkle root
-		// NOTE: this merkle tree design has a security vulnerability (CVE-2012-2459), which can be defended against by
-		// considering the merkle root invalid if there are duplicate hashes in any rows with an even number of elements
-		uint256 MerkleBlockBase::MerkleBlockRootR(size_t *hashIdx, size_t *flagIdx, int depth) const {
-			uint8_t flag;
-			uint256 hashes[2], md;
-
-			if (*flagIdx / 8 < _flags.size() && *hashIdx < _hashes.size()) {
-				flag = (_flags[*flagIdx / 8] & (1 << (*flagIdx % 8)));
-				(*flagIdx)++;
-
-				if (flag && depth != _ceil_log2(_totalTx)) {
-					hashes[0] = MerkleBlockRootR(hashIdx, flagIdx, depth + 1); // left branch
-					hashes[1] = MerkleBlockRootR(hashIdx, flagIdx, depth + 1); // right branch
-
-					if (hashes[0] != 0 && hashes[0] != hashes[1]) {
-						if (hashes[1] == 0)
-							hashes[1] = hashes[0]; // if right branch is missing, dup left branch
-
-						bytes_t data(hashes[0].begin(), hashes[0].size());
-						data += bytes_t(hashes[1].begin(), hashes[1].size());
-						md = sha256_2(data);
-					} else *hashIdx = SIZE_MAX; // defend against (CVE-2012-2459)
-				} else md = _hashes[(*hashIdx)++]; // leaf
+				for (size_t i = 0; i < count; ++i) {
+					const uint256 &left = children[2 * i];
+					uint256 &right = children[2 * i + 1];
+
+					if (left == 0 || left == right)
+						return matched; // defend against (CVE-2012-2459), root stays zero
+
+					if (right == 0)
+						right = left; // if right branch is missing, dup left branch
+				}
+
+				parents.resize(count);
+				SHA256D::HashPairs(parents.data(), children, count);
+
+				for (size_t i = levelStart[depth], p = 0; p < count; ++i) {
+					if (internal[i])
+						hashes[i] = parents[p++];
+				}
 			}
 
-			return md;
+			*root = hashes[0];
+			return matched;
+		}
+
+		void MerkleBlockBase::ResetTxHashesCache() {
+			std::vector<uint256>().swap(_txHashes);
+			_txHashesCached = false;
 		}
 
 		void MerkleBlockBase::SetHash(const uint256 &hash) {
@@ -261,5 +341,11 @@ namespace Elastos {
 		bool MerkleBlockBase::IsEqual(const IMerkleBlock *block) const {
 			return (block == this || GetHash() == block->GetHash());
 		}
+
+		void MerkleBlockBase::Compact() {
+			std::vector<uint256>().swap(_hashes);
+			bytes_t().swap(_flags);
+			ResetTxHashesCache();
+		}
 	}
 }
@@ -69,20 +69,25 @@ namespace Elastos {
 
 			size_t MerkleBlockTxHashes(std::vector<uint256> &txHashes) const;
 
+			virtual void Compact();
+
+			virtual void SerializeHeader(ByteStream &ostream) const;
+
 		protected:
 			void SerializeNoAux(ByteStream &ostream) const;
 
-			bool DeserializeNoAux(const ByteStream &istream);
+			bool DeserializeNoAux(const ByteStreamView &istream);
 
 			void SerializeAfterAux(ByteStream &ostream) const;
 
-			bool DeserializeAfterAux(const ByteStream &istream);
+			bool DeserializeAfterAux(const ByteStreamView &istream);
 
-			uint256 MerkleBlockRootR(size_t *hashIdx, size_t *flagIdx, int depth) const;
+			// also keeps the matched tx hashes, so MerkleBlockTxHashes() after IsValid() doesn't walk the tree again
+			uint256 MerkleBlockRoot() const;
 
-			size_t MerkleBlockTxHashesR(std::vector<uint256> &txHashes, size_t &hashIdx, size_t &flagIdx, int depth) const;
+			size_t MerkleBlockDecode(std::vector<uint256> *txHashes, uint256 *root) const;
 
-			int ceilLog2(int x) const;
+			void ResetTxHashesCache();
 
 		protected:
 			mutable uint256 _blockHash;
@@ -96,6 +101,9 @@ namespace Elastos {
 			std::vector<uint256> _hashes;
 			bytes_t _flags;
 			uint32_t _height;
+
+			mutable std::vector<uint256> _txHashes;
+			mutable bool _txHashesCached;
 		};
 
 	}
@@ -22,7 +22,9 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
+
+			virtual bool DeserializeUnhashed(const ByteStreamView &istream);
 
 			virtual const uint256 &GetHash() const;
 
@@ -30,6 +32,8 @@ namespace Elastos {
 
 			virtual std::string GetBlockType() const;
 
+			virtual void Compact();
+
 		private:
 			IDAuxPow idAuxPow;
 		};
@@ -22,7 +22,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const = 0;
 
-			virtual bool Deserialize(const ByteStream &istream) = 0;
+			virtual bool Deserialize(const ByteStreamView &istream) = 0;
 
 			virtual nlohmann::json ToJson() const = 0;
 
@@ -20,7 +20,14 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const = 0;
 
-			virtual bool Deserialize(const ByteStream &istream) = 0;
+			virtual bool Deserialize(const ByteStreamView &istream) = 0;
+
+			// same as Deserialize without hashing the header, for callers that hash many blocks in one batch
+			// and then call SetHash
+			virtual bool DeserializeUnhashed(const ByteStreamView &istream) = 0;
+
+			// the header fields covered by the block hash
+			virtual void SerializeHeader(ByteStream &ostream) const = 0;
 
 			virtual uint32_t GetHeight() const = 0;
 
@@ -61,6 +68,10 @@ namespace Elastos {
 			virtual std::string GetBlockType() const = 0;
 
 			virtual size_t MerkleBlockTxHashes(std::vector<uint256> &txHashes) const = 0;
+
+			// Drops the AuxPow and the partial merkle tree of a block that can no longer be reorganized,
+			// only the header and the block hash are kept.
+			virtual void Compact() = 0;
 		};
 
 		typedef boost::shared_ptr<IMerkleBlock> MerkleBlockPtr;
@@ -48,11 +48,10 @@ namespace Elastos {
 
 		size_t Asset::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_name.size());
+			size += ByteStream::VarUintSize(_name.size());
 			size += _name.size();
-			size += stream.WriteVarUint(_description.size());
+			size += ByteStream::VarUintSize(_description.size());
 			size += _description.size();
 			size += 3;
 
@@ -67,7 +66,7 @@ namespace Elastos {
 			ostream.WriteBytes(&_recordType, 1);
 		}
 
-		bool Asset::Deserialize(const ByteStream &istream) {
+		bool Asset::Deserialize(const ByteStreamView &istream) {
 			if (!istream.ReadVarString(_name)) {
 				Log::error("Asset payload deserialize name fail");
 				return false;
@@ -80,7 +80,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
 
 			virtual nlohmann::json ToJson() const;
 
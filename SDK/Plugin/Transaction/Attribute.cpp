@@ -18,7 +18,7 @@ namespace Elastos {
 			operator=(attr);
 		}
 
-		Attribute::Attribute(Attribute::Usage usage, const bytes_t &data) :
+		Attribute::Attribute(Attribute::Usage usage, const SmallBytes &data) :
 			_usage(usage),
 			_data(data) {
 
@@ -37,7 +37,7 @@ namespace Elastos {
 			return _usage;
 		}
 
-		const bytes_t &Attribute::GetData() const {
+		const SmallBytes &Attribute::GetData() const {
 			return _data;
 		}
 
@@ -52,10 +52,9 @@ namespace Elastos {
 
 		size_t Attribute::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += 1;
-			size += stream.WriteVarUint(_data.size());
+			size += ByteStream::VarUintSize(_data.size());
 			size += _data.size();
 
 			return size;
@@ -66,7 +65,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_data);
 		}
 
-		bool Attribute::Deserialize(const ByteStream &istream) {
+		bool Attribute::Deserialize(const ByteStreamView &istream) {
 			if (!istream.ReadBytes(&_usage, 1)) {
 				Log::error("Attribute deserialize usage fail");
 				return false;
@@ -29,7 +29,7 @@ namespace Elastos {
 
 			Attribute(const Attribute &attr);
 
-			Attribute(Usage usage, const bytes_t &data);
+			Attribute(Usage usage, const SmallBytes &data);
 
 			~Attribute();
 
@@ -37,7 +37,7 @@ namespace Elastos {
 
 			Usage GetUsage() const;
 
-			const bytes_t &GetData() const;
+			const SmallBytes &GetData() const;
 
 			bool IsValid() const;
 
@@ -45,7 +45,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
 
 			virtual nlohmann::json ToJson() const;
 
@@ -53,7 +53,7 @@ namespace Elastos {
 
 		private:
 			Usage _usage;
-			bytes_t _data;
+			SmallBytes _data;
 		};
 
 		typedef boost::shared_ptr<Attribute> AttributePtr;
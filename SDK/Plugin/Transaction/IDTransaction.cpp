@@ -43,7 +43,7 @@ namespace Elastos {
 			return payload;
 		}
 
-		bool IDTransaction::DeserializeType(const ByteStream &istream) {
+		bool IDTransaction::DeserializeType(const ByteStreamView &istream) {
 			if (!istream.ReadByte(_type)) {
 				Log::error("deserialize flag byte error");
 				return false;
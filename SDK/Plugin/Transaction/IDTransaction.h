@@ -28,7 +28,7 @@ namespace Elastos {
 
 			virtual ~IDTransaction();
 
-			virtual bool DeserializeType(const ByteStream &istream);
+			virtual bool DeserializeType(const ByteStreamView &istream);
 
 		public:
 			virtual PayloadPtr InitPayload(uint8_t type);
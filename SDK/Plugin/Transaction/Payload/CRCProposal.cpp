@@ -89,28 +89,27 @@ namespace Elastos {
 		}
 
 		size_t CRCProposal::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += sizeof(uint8_t);
 
-			size += stream.WriteVarUint(_sponsorPublicKey.size());
+			size += ByteStream::VarUintSize(_sponsorPublicKey.size());
 			size += _sponsorPublicKey.size();
 
 			size += _draftHash.size();
 
-			size += stream.WriteVarUint(_budgets.size());
+			size += ByteStream::VarUintSize(_budgets.size());
 
 			size += sizeof(uint64_t) * _budgets.size();
 
 			size += _recipient.size();
 
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			size += _crSponsorDID.size();
 
-			size += stream.WriteVarUint(_crSignature.size());
+			size += ByteStream::VarUintSize(_crSignature.size());
 			size += _crSignature.size();
 
 			return size;
@@ -127,7 +126,7 @@ namespace Elastos {
 			ostream.WriteBytes(_recipient);
 		}
 
-		bool CRCProposal::DeserializeUnsigned(const ByteStream &istream, uint8_t version) {
+		bool CRCProposal::DeserializeUnsigned(const ByteStreamView &istream, uint8_t version) {
 			uint8_t type = 0;
 			if (!istream.ReadUint8(type)) {
 				Log::error("CRCProposal DeserializeUnsigned: read type key");
@@ -176,7 +175,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_signature);
 		}
 
-		bool CRCProposal::DeserializeSponsorSigned(const ByteStream &istream, uint8_t version) {
+		bool CRCProposal::DeserializeSponsorSigned(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeUnsigned(istream, version)) {
 				return false;
 			}
@@ -198,7 +197,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_crSignature);
 		}
 
-		bool CRCProposal::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool CRCProposal::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeSponsorSigned(istream, version)) {
 				return false;
 			}
@@ -48,13 +48,12 @@ namespace Elastos {
 		}
 
 		size_t CRCProposalReview::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += _proposalHash.size();
 			size += sizeof(uint8_t);
 			size += _crDID.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -66,7 +65,7 @@ namespace Elastos {
 			ostream.WriteBytes(_crDID);
 		}
 
-		bool CRCProposalReview::DeserializeUnsigned(const ByteStream &istream, uint8_t version) {
+		bool CRCProposalReview::DeserializeUnsigned(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadBytes(_proposalHash)) {
 				Log::error("CRCProposalReview DeserializeUnsigned: read proposalHash key");
 				return false;
@@ -92,7 +91,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_signature);
 		}
 
-		bool CRCProposalReview::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool CRCProposalReview::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeUnsigned(istream, version)) {
 				return false;
 			}
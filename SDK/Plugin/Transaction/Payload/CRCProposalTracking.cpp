@@ -97,7 +97,6 @@ namespace Elastos {
 		}
 
 		size_t CRCProposalTracking::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += sizeof(uint8_t);
@@ -109,19 +108,19 @@ namespace Elastos {
 
 			size += sizeof(uint64_t);
 
-			size += stream.WriteVarUint(_leaderPubKey.size());
+			size += ByteStream::VarUintSize(_leaderPubKey.size());
 			size += _leaderPubKey.size();
 
-			size += stream.WriteVarUint(_newLeaderPubKey.size());
+			size += ByteStream::VarUintSize(_newLeaderPubKey.size());
 			size += _newLeaderPubKey.size();
 
-			size += stream.WriteVarUint(_leaderSign.size());
+			size += ByteStream::VarUintSize(_leaderSign.size());
 			size += _leaderSign.size();
 
-			size += stream.WriteVarUint(_newLeaderSign.size());
+			size += ByteStream::VarUintSize(_newLeaderSign.size());
 			size += _newLeaderSign.size();
 
-			size += stream.WriteVarUint(_secretaryGeneralSign.size());
+			size += ByteStream::VarUintSize(_secretaryGeneralSign.size());
 			size += _secretaryGeneralSign.size();
 
 			return size;
@@ -137,7 +136,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_newLeaderPubKey);
 		}
 
-		bool CRCProposalTracking::DeserializeUnsigned(const ByteStream &istream, uint8_t version) {
+		bool CRCProposalTracking::DeserializeUnsigned(const ByteStreamView &istream, uint8_t version) {
 			uint8_t type = 0;
 			if (!istream.ReadUint8(type)) {
 				Log::error("CRCProposalTracking DeserializeUnsigned: read type key");
@@ -186,7 +185,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_secretaryGeneralSign);
 		}
 
-		bool CRCProposalTracking::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool CRCProposalTracking::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeUnsigned(istream, version)) {
 				return false;
 			}
@@ -70,11 +70,11 @@ namespace Elastos {
 
 			void SerializeUnsigned(ByteStream &ostream, uint8_t version) const;
 
-			bool DeserializeUnsigned(const ByteStream &istream, uint8_t version);
+			bool DeserializeUnsigned(const ByteStreamView &istream, uint8_t version);
 
 			virtual void Serialize(ByteStream &ostream, uint8_t version) const;
 
-			virtual bool Deserialize(const ByteStream &istream, uint8_t version);
+			virtual bool Deserialize(const ByteStreamView &istream, uint8_t version);
 
 			virtual nlohmann::json ToJson(uint8_t version) const;
 
@@ -66,17 +66,16 @@ namespace Elastos {
 
 		size_t CRInfo::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_code.size());
+			size += ByteStream::VarUintSize(_code.size());
 			size += _code.size();
 			size += _did.size();
-			size += stream.WriteVarUint(_nickName.size());
+			size += ByteStream::VarUintSize(_nickName.size());
 			size += _nickName.size();
-			size += stream.WriteVarUint(_url.size());
+			size += ByteStream::VarUintSize(_url.size());
 			size += _url.size();
 			size += sizeof(_location);
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -87,7 +86,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_signature);
 		}
 
-		bool CRInfo::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool CRInfo::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeUnsigned(istream, version)) {
 				Log::error("CRInfo Deserialize: payload unsigned");
 				return false;
@@ -109,7 +108,7 @@ namespace Elastos {
 			ostream.WriteUint64(_location);
 		}
 
-		bool CRInfo::DeserializeUnsigned(const ByteStream &istream, uint8_t version) {
+		bool CRInfo::DeserializeUnsigned(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadVarBytes(_code)) {
 				Log::error("CRInfo Deserialize: read _code");
 				return false;
@@ -161,7 +160,7 @@ namespace Elastos {
 		}
 
 		bool CRInfo::IsValid() const {
-			ByteStream stream(_code);
+			ByteStreamView stream(_code);
 			bytes_t pubKey;
 			stream.ReadVarBytes(pubKey);
 
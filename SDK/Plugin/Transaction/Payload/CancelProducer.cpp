@@ -37,17 +37,16 @@ namespace Elastos {
 			ostream.WriteVarBytes(_publicKey);
 		}
 
-		bool CancelProducer::DeserializeUnsigned(const ByteStream &istream, uint8_t version) {
+		bool CancelProducer::DeserializeUnsigned(const ByteStreamView &istream, uint8_t version) {
 			return istream.ReadVarBytes(_publicKey);
 		}
 
 		size_t CancelProducer::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_publicKey.size());
+			size += ByteStream::VarUintSize(_publicKey.size());
 			size += _publicKey.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -58,7 +57,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_signature);
 		}
 
-		bool CancelProducer::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool CancelProducer::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeUnsigned(istream, version)) {
 				Log::error("Deserialize: cancel producer payload read unsigned");
 				return false;
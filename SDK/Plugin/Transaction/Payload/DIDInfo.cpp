@@ -54,16 +54,15 @@ namespace Elastos {
 		}
 
 		size_t DIDHeaderInfo::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
-			size = stream.WriteVarUint(_specification.size());
+			size = ByteStream::VarUintSize(_specification.size());
 			size += _specification.size();
-			size += stream.WriteVarUint(_operation.size());
+			size += ByteStream::VarUintSize(_operation.size());
 			size += _operation.size();
 
 			if (_operation == UPDATE_DID) {
-				size += stream.WriteVarUint(_previousTxid.size());
+				size += ByteStream::VarUintSize(_previousTxid.size());
 				size += _previousTxid.size();
 			}
 
@@ -78,7 +77,7 @@ namespace Elastos {
 			}
 		}
 
-		bool DIDHeaderInfo::Deserialize(const ByteStream &stream, uint8_t version) {
+		bool DIDHeaderInfo::Deserialize(const ByteStreamView &stream, uint8_t version) {
 			if (!stream.ReadVarString(_specification)) {
 				Log::error("DIDHeaderInfo deserialize: specification");
 				return false;
@@ -909,14 +908,13 @@ namespace Elastos {
 		}
 
 		size_t DIDProofInfo::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
-			size += stream.WriteVarUint(_type.size());
+			size += ByteStream::VarUintSize(_type.size());
 			size += _type.size();
-			size += stream.WriteVarUint(_verificationMethod.size());
+			size += ByteStream::VarUintSize(_verificationMethod.size());
 			size += _verificationMethod.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -928,7 +926,7 @@ namespace Elastos {
 			stream.WriteVarString(_signature);
 		}
 
-		bool DIDProofInfo::Deserialize(const ByteStream &stream, uint8_t version) {
+		bool DIDProofInfo::Deserialize(const ByteStreamView &stream, uint8_t version) {
 			if (!stream.ReadVarString(_type)) {
 				Log::error("DIDProofInfo deserialize: type");
 				return false;
@@ -1039,7 +1037,7 @@ namespace Elastos {
 			_proof.Serialize(stream, version);
 		}
 
-		bool DIDInfo::Deserialize(const ByteStream &stream, uint8_t version) {
+		bool DIDInfo::Deserialize(const ByteStreamView &stream, uint8_t version) {
 			if (!_header.Deserialize(stream, version)) {
 				Log::error("DIDInfo deserialize header");
 				return false;
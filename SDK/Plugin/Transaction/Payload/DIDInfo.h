@@ -43,7 +43,7 @@
 
 			virtual void Serialize(ByteStream &stream, uint8_t version) const;
 
-			virtual bool Deserialize(const ByteStream &stream, uint8_t version);
+			virtual bool Deserialize(const ByteStreamView &stream, uint8_t version);
 
 			virtual nlohmann::json ToJson(uint8_t version) const;
 
@@ -157,7 +157,7 @@
 
 			virtual void Serialize(ByteStream &stream, uint8_t version) const;
 
-			virtual bool Deserialize(const ByteStream &stream, uint8_t version);
+			virtual bool Deserialize(const ByteStreamView &stream, uint8_t version);
 
 			virtual nlohmann::json ToJson(uint8_t version) const;
 
@@ -375,7 +375,7 @@
 
 			virtual void Serialize(ByteStream &stream, uint8_t version) const;
 
-			virtual bool Deserialize(const ByteStream &stream, uint8_t version);
+			virtual bool Deserialize(const ByteStreamView &stream, uint8_t version);
 
 			virtual nlohmann::json ToJson(uint8_t version) const;
 
@@ -13,7 +13,7 @@ namespace Elastos {
 
 		bytes_t IPayload::GetData(uint8_t version) const {
 			ByteStream stream;
-			Serialize(stream, version);
+			stream.WriteExact([&](ByteStream &s) { Serialize(s, version); });
 
 			return stream.GetBytes();
 		}
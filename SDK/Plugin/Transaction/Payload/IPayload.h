@@ -22,7 +22,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream, uint8_t version) const = 0;
 
-			virtual bool Deserialize(const ByteStream &istream, uint8_t version) = 0;
+			virtual bool Deserialize(const ByteStreamView &istream, uint8_t version) = 0;
 
 			virtual nlohmann::json ToJson(uint8_t version) const = 0;
 
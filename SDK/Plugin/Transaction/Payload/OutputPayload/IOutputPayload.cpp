@@ -13,7 +13,7 @@ namespace Elastos {
 
 		bytes_t IOutputPayload::getData() const {
 			ByteStream stream;
-			Serialize(stream);
+			stream.WriteExact([this](ByteStream &s) { Serialize(s); });
 
 			return stream.GetBytes();
 		}
@@ -27,7 +27,7 @@ namespace Elastos {
 		void PayloadDefault::Serialize(ByteStream &ostream) const {
 		}
 
-		bool PayloadDefault::Deserialize(const ByteStream &istream) {
+		bool PayloadDefault::Deserialize(const ByteStreamView &istream) {
 			return true;
 		}
 
@@ -13,7 +13,7 @@ namespace Elastos {
 
 		}
 
-		CandidateVotes::CandidateVotes(const bytes_t &candidate, const BigInt &votes) :
+		CandidateVotes::CandidateVotes(const bytes_t &candidate, const Amount &votes) :
 				_candidate(candidate), _votes(votes) {
 
 		}
@@ -26,7 +26,7 @@ namespace Elastos {
 			return _candidate;
 		}
 
-		const BigInt &CandidateVotes::GetVotes() const {
+		const Amount &CandidateVotes::GetVotes() const {
 			return _votes;
 		}
 
@@ -42,7 +42,7 @@ namespace Elastos {
 			}
 		}
 
-		bool CandidateVotes::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool CandidateVotes::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadVarBytes(_candidate)) {
 				Log::error("CandidateVotes deserialize candidate fail");
 				return false;
@@ -128,8 +128,8 @@ namespace Elastos {
 			}
 		}
 
-		BigInt VoteContent::GetMaxVoteAmount() const {
-			BigInt max = 0;
+		Amount VoteContent::GetMaxVoteAmount() const {
+			Amount max = 0;
 
 			for (std::vector<CandidateVotes>::const_iterator it = _candidates.cbegin(); it != _candidates.cend(); ++it)
 				if (max < (*it).GetVotes())
@@ -138,8 +138,8 @@ namespace Elastos {
 			return max;
 		}
 
-		BigInt VoteContent::GetTotalVoteAmount() const {
-			BigInt total = 0;
+		Amount VoteContent::GetTotalVoteAmount() const {
+			Amount total = 0;
 
 			for (std::vector<CandidateVotes>::const_iterator it = _candidates.cbegin(); it != _candidates.cend(); ++it)
 				total += (*it).GetVotes();
@@ -156,7 +156,7 @@ namespace Elastos {
 			}
 		}
 
-		bool VoteContent::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool VoteContent::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			uint8_t type = 0;
 			if (!istream.ReadUint8(type)) {
 				Log::error("VoteContent deserialize type error");
@@ -235,23 +235,22 @@ namespace Elastos {
 		}
 
 		size_t PayloadVote::EstimateSize() const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += 1;
-			size += stream.WriteVarUint(_content.size());
+			size += ByteStream::VarUintSize(_content.size());
 			for (std::vector<VoteContent>::const_iterator vc = _content.cbegin(); vc != _content.cend(); ++vc) {
 				size += 1;
-				size += stream.WriteVarUint((*vc).GetCandidateVotes().size());
+				size += ByteStream::VarUintSize((*vc).GetCandidateVotes().size());
 
 				const std::vector<CandidateVotes> &candidateVotes = (*vc).GetCandidateVotes();
 				std::vector<CandidateVotes>::const_iterator cv;
 				for (cv = candidateVotes.cbegin(); cv != candidateVotes.cend(); ++cv) {
-					size += stream.WriteVarUint((*cv).GetCandidate().size());
+					size += ByteStream::VarUintSize((*cv).GetCandidate().size());
 					size += (*cv).GetCandidate().size();
 
 					if (_version >= VOTE_PRODUCER_CR_VERSION) {
-						size += stream.WriteVarUint((*cv).GetVotes().getUint64());
+						size += ByteStream::VarUintSize((*cv).GetVotes().getUint64());
 					}
 				}
 			}
@@ -268,7 +267,7 @@ namespace Elastos {
 			}
 		}
 
-		bool PayloadVote::Deserialize(const ByteStream &istream) {
+		bool PayloadVote::Deserialize(const ByteStreamView &istream) {
 			if (!istream.ReadUint8(_version)) {
 				Log::error("payload vote deserialize version error");
 				return false;
@@ -6,7 +6,7 @@
 #define __ELASTOS_SDK_OUTPUT_PAYLOADVOTE_H
 
 #include <Plugin/Transaction/Payload/OutputPayload/IOutputPayload.h>
-#include <Common/BigInt.h>
+#include <Common/Amount.h>
 
 #define VOTE_PRODUCER_CR_VERSION  0x01
 
@@ -17,26 +17,26 @@ namespace Elastos {
 		public:
 			CandidateVotes();
 
-			explicit CandidateVotes(const bytes_t &candidate, const BigInt &votes = 0);
+			explicit CandidateVotes(const bytes_t &candidate, const Amount &votes = 0);
 
 			~CandidateVotes();
 		public:
 			const bytes_t & GetCandidate() const;
 
-			const BigInt &GetVotes() const;
+			const Amount &GetVotes() const;
 
 			void SetVotes(uint64_t votes);
 
 			void Serialize(ByteStream &ostream, uint8_t version) const;
 
-			bool Deserialize(const ByteStream &istream, uint8_t version);
+			bool Deserialize(const ByteStreamView &istream, uint8_t version);
 
 			nlohmann::json ToJson(uint8_t version) const;
 
 			void FromJson(const nlohmann::json &j, uint8_t version);
 		private:
 			bytes_t  _candidate;
-			BigInt _votes;
+			Amount _votes;
 		};
 
 		class VoteContent {
@@ -69,13 +69,13 @@ namespace Elastos {
 
 			void SetAllCandidateVotes(uint64_t votes);
 
-			BigInt GetMaxVoteAmount() const;
+			Amount GetMaxVoteAmount() const;
 
-			BigInt GetTotalVoteAmount() const;
+			Amount GetTotalVoteAmount() const;
 
 			void Serialize(ByteStream &ostream, uint8_t version) const;
 
-			bool Deserialize(const ByteStream &istream, uint8_t version);
+			bool Deserialize(const ByteStreamView &istream, uint8_t version);
 
 			nlohmann::json ToJson(uint8_t version) const;
 
@@ -107,7 +107,7 @@ namespace Elastos {
 
 			virtual void Serialize(ByteStream &ostream) const;
 
-			virtual bool Deserialize(const ByteStream &istream);
+			virtual bool Deserialize(const ByteStreamView &istream);
 
 			virtual nlohmann::json ToJson() const;
 
@@ -30,12 +30,11 @@ namespace Elastos {
 
 		size_t RechargeToSideChain::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
 			if (version == RechargeToSideChain::V0) {
-				size += stream.WriteVarUint(_merkeProof.size());
+				size += ByteStream::VarUintSize(_merkeProof.size());
 				size += _merkeProof.size();
-				size += stream.WriteVarUint(_mainChainTransaction.size());
+				size += ByteStream::VarUintSize(_mainChainTransaction.size());
 				size += _mainChainTransaction.size();
 			} else if (version == RechargeToSideChain::V1) {
 				size += _mainChainTxHash.size();
@@ -55,7 +54,7 @@ namespace Elastos {
 			}
 		}
 
-		bool RechargeToSideChain::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool RechargeToSideChain::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (version == RechargeToSideChain::V0) {
 				if (!istream.ReadVarBytes(_merkeProof)) {
 					Log::error("Deserialize: recharge to side chain payload read merkle proof");
@@ -45,11 +45,10 @@ namespace Elastos {
 
 		size_t Record::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_recordType.size());
+			size += ByteStream::VarUintSize(_recordType.size());
 			size += _recordType.size();
-			size += stream.WriteVarUint(_recordData.size());
+			size += ByteStream::VarUintSize(_recordData.size());
 			size += _recordData.size();
 
 			return size;
@@ -60,7 +59,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_recordData);
 		}
 
-		bool Record::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool Record::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadVarString(_recordType)) {
 				Log::error("Payload record deserialize type fail");
 				return false;
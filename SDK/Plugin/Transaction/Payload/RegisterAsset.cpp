@@ -49,7 +49,7 @@ namespace Elastos {
 			ostream.WriteBytes(_controller);
 		}
 
-		bool RegisterAsset::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool RegisterAsset::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!_asset->Deserialize(istream)) {
 				Log::error("Payload register asset deserialize asset fail");
 				return false;
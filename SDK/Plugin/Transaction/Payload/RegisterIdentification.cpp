@@ -48,24 +48,23 @@ namespace Elastos {
 
 		size_t RegisterIdentification::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_id.size());
+			size += ByteStream::VarUintSize(_id.size());
 			size += _id.size();
-			size += stream.WriteVarUint(_sign.size());
+			size += ByteStream::VarUintSize(_sign.size());
 			size += _sign.size();
 
-			size += stream.WriteVarUint(_contents.size());
+			size += ByteStream::VarUintSize(_contents.size());
 			for (size_t i = 0; i < _contents.size(); ++i) {
-				size += stream.WriteVarUint(_contents[i].Path.size());
+				size += ByteStream::VarUintSize(_contents[i].Path.size());
 				size += _contents[i].Path.size();
 
-				size += stream.WriteVarUint(_contents[i].Values.size());
+				size += ByteStream::VarUintSize(_contents[i].Values.size());
 				for (size_t j = 0; j < _contents[i].Values.size(); ++j) {
 					size += _contents[i].Values[j].DataHash.size();
-					size += stream.WriteVarUint(_contents[i].Values[j].Proof.size());
+					size += ByteStream::VarUintSize(_contents[i].Values[j].Proof.size());
 					size += _contents[i].Values[j].Proof.size();
-					size += stream.WriteVarUint(_contents[i].Values[j].Info.size());
+					size += ByteStream::VarUintSize(_contents[i].Values[j].Info.size());
 					size += _contents[i].Values[j].Info.size();
 				}
 			}
@@ -94,7 +93,7 @@ namespace Elastos {
 			}
 		}
 
-		bool RegisterIdentification::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool RegisterIdentification::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadVarString(_id)) {
 				Log::error("Payload register identification deserialize id fail");
 				return false;
@@ -25,7 +25,7 @@ namespace Elastos {
 
 		}
 
-		bool ReturnDepositCoin::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool ReturnDepositCoin::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			return true;
 		}
 
@@ -66,12 +66,11 @@ namespace Elastos {
 
 		size_t SideChainPow::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += _sideBlockHash.size();
 			size += _sideGenesisHash.size();
 			size += sizeof(_blockHeight);
-			size += stream.WriteVarUint(_signedData.size());
+			size += ByteStream::VarUintSize(_signedData.size());
 			size += _signedData.size();
 
 			return size;
@@ -84,7 +83,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_signedData);
 		}
 
-		bool SideChainPow::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool SideChainPow::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadBytes(_sideBlockHash))
 				return false;
 
@@ -28,7 +28,7 @@ namespace Elastos {
 
 		}
 
-		bool TransferAsset::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool TransferAsset::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			return true;
 		}
 
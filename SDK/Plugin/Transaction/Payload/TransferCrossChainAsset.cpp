@@ -85,13 +85,12 @@ namespace Elastos {
 
 		size_t TransferCrossChainAsset::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_info.size());
+			size += ByteStream::VarUintSize(_info.size());
 			for (size_t i = 0; i < _info.size(); ++i) {
-				size += stream.WriteVarUint(_info[i]._crossChainAddress.size());
+				size += ByteStream::VarUintSize(_info[i]._crossChainAddress.size());
 				size += _info[i]._crossChainAddress.size();
-				size += stream.WriteVarUint(_info[i]._outputIndex);
+				size += ByteStream::VarUintSize(_info[i]._outputIndex);
 				size += sizeof(_info[i]._outputIndex);
 			}
 
@@ -108,7 +107,7 @@ namespace Elastos {
 			}
 		}
 
-		bool TransferCrossChainAsset::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool TransferCrossChainAsset::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			uint64_t len = 0;
 			if (!istream.ReadVarUint(len)) {
 				Log::error("Payload transfer cross chain asset deserialize fail");
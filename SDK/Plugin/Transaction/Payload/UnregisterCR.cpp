@@ -35,8 +35,7 @@ namespace Elastos {
 			size_t size = 0;
 			size += _did.size();
 
-			ByteStream stream;
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -47,7 +46,7 @@ namespace Elastos {
 			ostream.WriteVarBytes(_signature);
 		}
 
-		bool UnregisterCR::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool UnregisterCR::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!DeserializeUnsigned(istream, version)) {
 				return false;
 			}
@@ -64,7 +63,7 @@ namespace Elastos {
 			ostream.WriteBytes(_did);
 		}
 
-		bool UnregisterCR::DeserializeUnsigned(const ByteStream &istream, uint8_t version) {
+		bool UnregisterCR::DeserializeUnsigned(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadBytes(_did)) {
 				Log::error("UnregisterCR Deserialize: read _did");
 				return false;
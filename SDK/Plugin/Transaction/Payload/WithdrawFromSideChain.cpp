@@ -56,12 +56,11 @@ namespace Elastos {
 
 		size_t WithdrawFromSideChain::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += sizeof(_blockHeight);
-			size += stream.WriteVarUint(_genesisBlockAddress.size());
+			size += ByteStream::VarUintSize(_genesisBlockAddress.size());
 			size += _genesisBlockAddress.size();
-			size += stream.WriteVarUint(_sideChainTransactionHash.size());
+			size += ByteStream::VarUintSize(_sideChainTransactionHash.size());
 
 			for (size_t i = 0; i < _sideChainTransactionHash.size(); ++i)
 				size += _sideChainTransactionHash[i].size();
@@ -79,7 +78,7 @@ namespace Elastos {
 			}
 		}
 
-		bool WithdrawFromSideChain::Deserialize(const ByteStream &istream, uint8_t version) {
+		bool WithdrawFromSideChain::Deserialize(const ByteStreamView &istream, uint8_t version) {
 			if (!istream.ReadUint32(_blockHeight)) {
 				Log::error("Payload with draw asset deserialize block height fail");
 				return false;
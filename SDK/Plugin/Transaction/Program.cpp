@@ -21,7 +21,7 @@ namespace Elastos {
 			operator=(program);
 		}
 
-		Program::Program(const std::string &path, const bytes_t &code, const bytes_t &parameter) :
+		Program::Program(const std::string &path, const SmallBytes &code, const SmallBytes &parameter) :
 				_path(path),
 				_parameter(parameter),
 				_code(code) {
@@ -42,15 +42,15 @@ namespace Elastos {
 			Key key;
 			uint8_t signatureCount = 0;
 
-			std::vector<bytes_t> publicKeys;
+			std::vector<SmallBytes> publicKeys;
 			SignType type = DecodePublicKey(publicKeys);
 			if (type == SignTypeInvalid) {
 				Log::error("Invalid Redeem script");
 				return false;
 			}
 
-			ByteStream stream(_parameter);
-			bytes_t signature;
+			ByteStreamView stream(_parameter);
+			SmallBytes signature;
 			while (stream.ReadVarBytes(signature)) {
 				bool verified = false;
 				for (size_t i = 0; i < publicKeys.size(); ++i) {
@@ -92,7 +92,7 @@ namespace Elastos {
 
 		nlohmann::json Program::GetSignedInfo(const uint256 &md) const {
 			nlohmann::json info;
-			std::vector<bytes_t> publicKeys;
+			std::vector<SmallBytes> publicKeys;
 			SignType type = DecodePublicKey(publicKeys);
 			if (type == SignTypeInvalid) {
 				Log::warn("Can not decode pubkey from program");
@@ -100,8 +100,8 @@ namespace Elastos {
 			}
 
 			Key key;
-			ByteStream stream(_parameter);
-			bytes_t signature;
+			ByteStreamView stream(_parameter);
+			SmallBytes signature;
 			nlohmann::json signers;
 			while (stream.ReadVarBytes(signature)) {
 				for (size_t i = 0; i < publicKeys.size(); ++i) {
@@ -128,14 +128,14 @@ namespace Elastos {
 			return info;
 		}
 
-		SignType Program::DecodePublicKey(std::vector<bytes_t> &pubkeys) const {
+		SignType Program::DecodePublicKey(std::vector<SmallBytes> &pubkeys) const {
 			if (_code.size() < 33 + 2)
 				return SignTypeInvalid;
 
 			SignType signType = SignType(_code[_code.size() - 1]);
-			bytes_t pubKey;
+			SmallBytes pubKey;
 
-			ByteStream stream(_code);
+			ByteStreamView stream(_code);
 
 			if (signType == SignTypeMultiSign || signType == SignTypeCrossChain) {
 				stream.Skip(1);
@@ -151,19 +151,19 @@ namespace Elastos {
 			return signType;
 		}
 
-		const bytes_t &Program::GetCode() const {
+		const SmallBytes &Program::GetCode() const {
 			return _code;
 		}
 
-		const bytes_t &Program::GetParameter() const {
+		const SmallBytes &Program::GetParameter() const {
 			return _parameter;
 		}
 
-		void Program::SetCode(const bytes_t &code) {
+		void Program::SetCode(const SmallBytes &code) {
 			_code = code;
 		}
 
-		void Program::SetParameter(const bytes_t &parameter) {
+		void Program::SetParameter(const SmallBytes &parameter) {
 			_parameter = parameter;
 		}
 
@@ -177,23 +177,22 @@ namespace Elastos {
 
 		size_t Program::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
 			if (_parameter.empty()) {
 				if (SignType(_code.back()) == SignTypeMultiSign) {
 					uint8_t m = (uint8_t)(_code[0] - OP_1 + 1);
 					uint64_t signLen = m * 64ul;
-					size += stream.WriteVarUint(signLen);
+					size += ByteStream::VarUintSize(signLen);
 					size += signLen;
 				} else if (SignType(_code.back()) == SignTypeStandard) {
 					size += 65;
 				}
 			} else {
-				size += stream.WriteVarUint(_parameter.size());
+				size += ByteStream::VarUintSize(_parameter.size());
 				size += _parameter.size();
 			}
 
-			size += stream.WriteVarUint(_code.size());
+			size += ByteStream::VarUintSize(_code.size());
 			size += _code.size();
 
 			return size;
@@ -207,7 +206,7 @@ namespace Elastos {
 			}
 		}
 
-		bool Program::Deserialize(const ByteStream &istream, bool extend) {
+		bool Program::Deserialize(const ByteStreamView &istream, bool extend) {
 			if (!istream.ReadVarBytes(_parameter)) {
 				Log::error("Program deserialize parameter fail");
 				return false;
@@ -22,25 +22,25 @@ namespace Elastos {
 
 			Program(const Program &program);
 
-			Program(const std::string &path, const bytes_t &code, const bytes_t &parameter);
+			Program(const std::string &path, const SmallBytes &code, const SmallBytes &parameter);
 
 			~Program();
 
 			Program &operator=(const Program &tx);
 
-			SignType DecodePublicKey(std::vector<bytes_t> &pubkeys) const;
+			SignType DecodePublicKey(std::vector<SmallBytes> &pubkeys) const;
 
 			bool VerifySignature(const uint256 &md) const;
 
 			nlohmann::json GetSignedInfo(const uint256 &md) const;
 
-			const bytes_t &GetCode() const;
+			const SmallBytes &GetCode() const;
 
-			const bytes_t &GetParameter() const;
+			const SmallBytes &GetParameter() const;
 
-			void SetCode(const bytes_t &code);
+			void SetCode(const SmallBytes &code);
 
-			void SetParameter(const bytes_t &parameter);
+			void SetParameter(const SmallBytes &parameter);
 
 			void SetPath(const std::string &path);
 
@@ -50,7 +50,7 @@ namespace Elastos {
 
 			void Serialize(ByteStream &ostream, bool extend = false) const;
 
-			bool Deserialize(const ByteStream &istream, bool extend = false);
+			bool Deserialize(const ByteStreamView &istream, bool extend = false);
 
 			virtual nlohmann::json ToJson() const;
 
@@ -58,8 +58,8 @@ namespace Elastos {
 
 		private:
 			std::string _path;
-			bytes_t _code;
-			bytes_t _parameter;
+			SmallBytes _code;
+			SmallBytes _parameter;
 		};
 
 		typedef boost::shared_ptr<Program> ProgramPtr;
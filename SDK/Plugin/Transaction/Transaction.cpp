@@ -26,6 +26,7 @@
 #include <Plugin/Transaction/Payload/CRCProposalTracking.h>
 #include <Wallet/UTXO.h>
 #include <Wallet/Wallet.h>
+#include <Database/TransactionDataStore.h>
 
 #include <Common/Log.h>
 #include <Common/ErrorChecker.h>
@@ -74,6 +75,7 @@ namespace Elastos {
 
 		Transaction &Transaction::operator=(const Transaction &orig) {
 			_isRegistered = orig._isRegistered;
+			ResetHash();
 			_txHash = orig.GetHash();
 
 			_version = orig._version;
@@ -125,13 +127,15 @@ namespace Elastos {
 
 		void Transaction::ResetHash() {
 			_txHash = 0;
+			_shaData = 0;
+			_unsignedBytes[0].clear();
+			_unsignedBytes[1].clear();
 		}
 
 		const uint256 &Transaction::GetHash() const {
 			if (_txHash == 0) {
-				ByteStream stream;
-				SerializeUnsigned(stream);
-				_txHash = sha256_2(stream.GetBytes());
+				const bytes_t &bytes = GetUnsignedBytes();
+				sha256_2(bytes.data(), bytes.size(), _txHash);
 			}
 			return _txHash;
 		}
@@ -146,6 +150,7 @@ namespace Elastos {
 
 		void Transaction::SetVersion(const TxVersion &version) {
 			_version = version;
+			ResetHash();
 		}
 
 		uint8_t Transaction::GetTransactionType() const {
@@ -171,6 +176,7 @@ namespace Elastos {
 		void Transaction::FixIndex() {
 			for (uint16_t i = 0; i < _outputs.size(); ++i)
 				_outputs[i]->SetFixedIndex(i);
+			_unsignedBytes[1].clear();
 		}
 
 		OutputPtr Transaction::OutputOfIndex(uint16_t fixedIndex) const {
@@ -185,16 +191,19 @@ namespace Elastos {
 
 		void Transaction::SetOutputs(const std::vector<OutputPtr> &outputs) {
 			_outputs = outputs;
+			ResetHash();
 		}
 
 		void Transaction::AddOutput(const OutputPtr &output) {
 			_outputs.push_back(output);
+			ResetHash();
 		}
 
 		void Transaction::RemoveOutput(const OutputPtr &output) {
 			for (std::vector<OutputPtr>::iterator it = _outputs.begin(); it != _outputs.end(); ) {
 				if (output == (*it)) {
 					it = _outputs.erase(it);
+					ResetHash();
 					break;
 				} else {
 					++it;
@@ -206,12 +215,9 @@ namespace Elastos {
 			return _inputs;
 		}
 
-		std::vector<InputPtr>& Transaction::GetInputs() {
-			return _inputs;
-		}
-
 		void Transaction::AddInput(const InputPtr &Input) {
 			_inputs.push_back(Input);
+			ResetHash();
 		}
 
 		bool Transaction::ContainInput(const uint256 &hash, uint32_t n) const {
@@ -232,6 +238,7 @@ namespace Elastos {
 		void Transaction::SetLockTime(uint32_t t) {
 
 			_lockTime = t;
+			ResetHash();
 		}
 
 		uint32_t Transaction::GetBlockHeight() const {
@@ -252,7 +259,6 @@ namespace Elastos {
 
 		size_t Transaction::EstimateSize() const {
 			size_t i, txSize = 0;
-			ByteStream stream;
 
 			if (_version >= TxVersion::V09)
 				txSize += 1;
@@ -263,21 +269,21 @@ namespace Elastos {
 			// payload
 			txSize += _payload->EstimateSize(_payloadVersion);
 
-			txSize += stream.WriteVarUint(_attributes.size());
+			txSize += ByteStream::VarUintSize(_attributes.size());
 			for (i = 0; i < _attributes.size(); ++i)
 				txSize += _attributes[i]->EstimateSize();
 
-			txSize += stream.WriteVarUint(_inputs.size());
+			txSize += ByteStream::VarUintSize(_inputs.size());
 			for (i = 0; i < _inputs.size(); ++i)
 				txSize += _inputs[i]->EstimateSize();
 
-			txSize += stream.WriteVarUint(_outputs.size());
+			txSize += ByteStream::VarUintSize(_outputs.size());
 			for (i = 0; i < _outputs.size(); ++i)
 				txSize += _outputs[i]->EstimateSize();
 
 			txSize += sizeof(_lockTime);
 
-			txSize += stream.WriteVarUint(_programs.size());
+			txSize += ByteStream::VarUintSize(_programs.size());
 			for (i = 0; i < _programs.size(); ++i)
 				txSize += _programs[i]->EstimateSize();
 
@@ -357,20 +363,18 @@ namespace Elastos {
 			return _payload.get();
 		}
 
-		IPayload *Transaction::GetPayload() {
-			return _payload.get();
-		}
-
 		const PayloadPtr &Transaction::GetPayloadPtr() const {
 			return _payload;
 		}
 
 		void Transaction::SetPayload(const PayloadPtr &payload) {
 			_payload = payload;
+			ResetHash();
 		}
 
 		void Transaction::AddAttribute(const AttributePtr &attribute) {
 			_attributes.push_back(attribute);
+			ResetHash();
 		}
 
 		const std::vector<AttributePtr> &Transaction::GetAttributes() const {
@@ -402,7 +406,7 @@ namespace Elastos {
 		}
 
 		void Transaction::Serialize(ByteStream &ostream, bool extend) const {
-			SerializeUnsigned(ostream, extend);
+			ostream.WriteBytes(GetUnsignedBytes(extend));
 
 			ostream.WriteVarUint(_programs.size());
 			for (size_t i = 0; i < _programs.size(); i++) {
@@ -441,7 +445,7 @@ namespace Elastos {
 			ostream.WriteUint32(_lockTime);
 		}
 
-		bool Transaction::DeserializeType(const ByteStream &istream) {
+		bool Transaction::DeserializeType(const ByteStreamView &istream) {
 			uint8_t flagByte = 0;
 			if (!istream.ReadByte(flagByte)) {
 				Log::error("deserialize flag byte error");
@@ -461,7 +465,7 @@ namespace Elastos {
 			return true;
 		}
 
-		bool Transaction::Deserialize(const ByteStream &istream, bool extend) {
+		bool Transaction::Deserialize(const ByteStreamView &istream, bool extend) {
 			Reinit();
 
 			if (!DeserializeType(istream)) {
@@ -555,8 +559,8 @@ namespace Elastos {
 			}
 
 			ByteStream stream;
-			SerializeUnsigned(stream);
-			_txHash = sha256_2((stream.GetBytes()));
+			stream.WriteExact([this](ByteStream &s) { SerializeUnsigned(s); });
+			sha256_2(stream.GetBytes().data(), stream.GetBytes().size(), _txHash);
 
 			return true;
 		}
@@ -670,7 +674,7 @@ namespace Elastos {
 
 		uint64_t Transaction::GetTxFee(const WalletPtr &wallet) {
 			uint64_t fee = 0;
-			BigInt inputAmount(0), outputAmount(0);
+			Amount inputAmount(0), outputAmount(0);
 
 			for (size_t i = 0; i < _inputs.size(); ++i) {
 				const TransactionPtr &tx = wallet->TransactionForHash(_inputs[i]->TxHash());
@@ -688,29 +692,26 @@ namespace Elastos {
 			return fee;
 		}
 
-		nlohmann::json Transaction::GetSummary(const WalletPtr &wallet, uint32_t confirms, bool detail) {
-			std::string addr;
-			nlohmann::json summary, outputPayload;
-			std::vector<nlohmann::json> outputPayloads;
-			std::string direction = "Received";
-			BigInt inputAmount(0), outputAmount(0), changeAmount(0);
-			uint64_t fee = 0;
-			std::map<std::string, BigInt>::iterator it;
+		void Transaction::GetSummaryAmounts(const WalletPtr &wallet, std::string &direction, Amount &amount,
+											uint64_t &fee, std::map<uint168, Amount> *inputList,
+											std::map<uint168, Amount> *outputList) const {
+			uint168 addr;
+			Amount inputAmount(0), outputAmount(0), changeAmount(0);
 
-			std::map<std::string, BigInt> inputList;
-			for (InputArray::iterator in = _inputs.begin(); in != _inputs.end(); ++in) {
+			direction = "Received";
+			for (InputArray::const_iterator in = _inputs.begin(); in != _inputs.end(); ++in) {
 				TransactionPtr tx = wallet->TransactionForHash((*in)->TxHash());
 				if (tx) {
 					const OutputPtr o = tx->OutputOfIndex((*in)->Index());
 					if (o && wallet->ContainsAddress(o->Addr()) && !wallet->IsDepositAddress(o->Addr())) {
-						const BigInt &spentAmount = o->Amount();
-						addr = o->Addr()->String();
+						const Amount &spentAmount = o->Amount();
+						addr = o->Addr()->ProgramHash();
 
-						if (detail) {
-							if (inputList.find(addr) == inputList.end()) {
-								inputList[addr] = spentAmount;
+						if (inputList) {
+							if (inputList->find(addr) == inputList->end()) {
+								(*inputList)[addr] = spentAmount;
 							} else {
-								inputList[addr] += spentAmount;
+								(*inputList)[addr] += spentAmount;
 							}
 						}
 
@@ -721,14 +722,14 @@ namespace Elastos {
 				} else {
 					UTXOPtr cb = wallet->CoinBaseTxForHash((*in)->TxHash());
 					if (cb && cb->Index() == (*in)->Index()) {
-						const BigInt &spentAmount = cb->Output()->Amount();
-						addr = cb->Output()->Addr()->String();
+						const Amount &spentAmount = cb->Output()->Amount();
+						addr = cb->Output()->Addr()->ProgramHash();
 
-						if (detail) {
-							if (inputList.find(addr) == inputList.end()) {
-								inputList[addr] = spentAmount;
+						if (inputList) {
+							if (inputList->find(addr) == inputList->end()) {
+								(*inputList)[addr] = spentAmount;
 							} else {
-								inputList[addr] += spentAmount;
+								(*inputList)[addr] += spentAmount;
 							}
 						}
 
@@ -738,24 +739,10 @@ namespace Elastos {
 				}
 			}
 
-			nlohmann::json inputJson;
-			if (direction == "Sent") {
-				for (it = inputList.begin(); it != inputList.end(); ++it) {
-					inputJson[it->first] = it->second.getDec();
-				}
-			}
-
 			bool containAddress;
-			std::map<std::string, BigInt> outputList;
-			for (OutputArray::iterator o = _outputs.begin(); o != _outputs.end(); ++o) {
-				const BigInt &oAmount = (*o)->Amount();
-				addr = (*o)->Addr()->String();
-
-				if ((*o)->GetType() == TransactionOutput::VoteOutput) {
-					outputPayload = (*o)->GetPayload()->ToJson();
-					outputPayload["Amount"] = oAmount.getDec();
-					outputPayloads.push_back(outputPayload);
-				}
+			for (OutputArray::const_iterator o = _outputs.begin(); o != _outputs.end(); ++o) {
+				const Amount &oAmount = (*o)->Amount();
+				addr = (*o)->Addr()->ProgramHash();
 
 				containAddress = wallet->ContainsAddress((*o)->Addr());
 				if (containAddress && !wallet->IsDepositAddress((*o)->Addr())) {
@@ -764,21 +751,16 @@ namespace Elastos {
 					outputAmount += oAmount;
 				}
 
-				if (detail && (direction == "Sent" || (direction != "Sent" && containAddress))) {
-					if (outputList.find(addr) == outputList.end()) {
-						outputList[addr] = oAmount;
+				if (outputList && (direction == "Sent" || (direction != "Sent" && containAddress))) {
+					if (outputList->find(addr) == outputList->end()) {
+						(*outputList)[addr] = oAmount;
 					} else {
-						outputList[addr] += oAmount;
+						(*outputList)[addr] += oAmount;
 					}
 				}
 			}
 
-			nlohmann::json outputJson;
-			for (it = outputList.begin(); it != outputList.end(); ++it) {
-				outputJson[it->first] = it->second.getDec();
-			}
-
-			if (direction == "Sent" && outputAmount == BigInt(0)) {
+			if (direction == "Sent" && outputAmount.isZero()) {
 				direction = "Moved";
 			}
 
@@ -788,7 +770,6 @@ namespace Elastos {
 				fee = 0;
 			}
 
-			BigInt amount(0);
 			if (direction == "Received") {
 				amount = changeAmount;
 			} else if (direction == "Sent") {
@@ -796,20 +777,53 @@ namespace Elastos {
 			} else {
 				amount = 0;
 			}
+		}
+
+		nlohmann::json Transaction::GetSummary(const WalletPtr &wallet, uint32_t confirms, bool detail) {
+			nlohmann::json summary, outputPayload;
+			std::vector<nlohmann::json> outputPayloads;
+			std::string direction;
+			Amount amount(0);
+			uint64_t fee = 0;
+			std::map<uint168, Amount>::iterator it;
+			std::map<uint168, Amount> inputList, outputList;
+
+			GetSummaryAmounts(wallet, direction, amount, fee, detail ? &inputList : nullptr,
+							  detail ? &outputList : nullptr);
+
+			nlohmann::json inputJson;
+			if (direction != "Received") {
+				for (it = inputList.begin(); it != inputList.end(); ++it) {
+					inputJson[Address(it->first).String()] = it->second.getDec();
+				}
+			}
+
+			for (OutputArray::iterator o = _outputs.begin(); o != _outputs.end(); ++o) {
+				if ((*o)->GetType() == TransactionOutput::VoteOutput) {
+					outputPayload = (*o)->GetPayload()->ToJson();
+					outputPayload["Amount"] = (*o)->Amount().getDec();
+					outputPayloads.push_back(outputPayload);
+				}
+			}
+
+			nlohmann::json outputJson;
+			for (it = outputList.begin(); it != outputList.end(); ++it) {
+				outputJson[Address(it->first).String()] = it->second.getDec();
+			}
 
-			summary["TxHash"] = GetHash().GetHex();
-			summary["Status"] = confirms <= 6 ? "Pending" : "Confirmed";
-			summary["ConfirmStatus"] = confirms <= 6 ? std::to_string(confirms) : "6+";
-			summary["Timestamp"] = GetTimestamp();
-			summary["Direction"] = direction;
-			summary["Amount"] = amount.getDec();
-			summary["Type"] = GetTransactionType();
-			summary["Height"] = GetBlockHeight();
+			TransactionSummary basic;
+			basic.TxHash = GetHash();
+			basic.Direction = direction;
+			basic.Amount = amount;
+			basic.Type = GetTransactionType();
+			basic.BlockHeight = GetBlockHeight();
+			basic.Timestamp = GetTimestamp();
+			summary = GetSummary(basic, confirms);
 			if (detail) {
 				std::string memo;
 				for (size_t i = 0; i < _attributes.size(); ++i) {
 					if (_attributes[i]->GetUsage() == Attribute::Usage::Memo) {
-						const bytes_t &memoData = _attributes[i]->GetData();
+						const SmallBytes &memoData = _attributes[i]->GetData();
 						memo = std::string((char *)memoData.data(), memoData.size());
 						try {
 							nlohmann::json memoJson = nlohmann::json::parse(memo);
@@ -845,10 +859,37 @@ namespace Elastos {
 			return summary;
 		}
 
+		nlohmann::json Transaction::GetSummary(const TransactionSummary &summary, uint32_t confirms) {
+			nlohmann::json j;
+
+			j["TxHash"] = summary.TxHash.GetHex();
+			j["Status"] = confirms <= 6 ? "Pending" : "Confirmed";
+			j["ConfirmStatus"] = confirms <= 6 ? std::to_string(confirms) : "6+";
+			j["Timestamp"] = summary.Timestamp;
+			j["Direction"] = summary.Direction;
+			j["Amount"] = summary.Amount.getDec();
+			j["Type"] = summary.Type;
+			j["Height"] = summary.BlockHeight;
+
+			return j;
+		}
+
+		const bytes_t &Transaction::GetUnsignedBytes(bool extend) const {
+			bytes_t &bytes = _unsignedBytes[extend ? 1 : 0];
+			if (bytes.empty()) {
+				ByteStream stream;
+				stream.WriteExact([this, extend](ByteStream &s) { SerializeUnsigned(s, extend); });
+				bytes = stream.ReleaseBytes();
+			}
+			return bytes;
+		}
+
 		uint256 Transaction::GetShaData() const {
-			ByteStream stream;
-			SerializeUnsigned(stream);
-			return uint256(sha256(stream.GetBytes()));
+			if (_shaData == 0) {
+				const bytes_t &bytes = GetUnsignedBytes();
+				sha256(bytes.data(), bytes.size(), _shaData);
+			}
+			return _shaData;
 		}
 
 		PayloadPtr Transaction::InitPayload(uint8_t type) {
@@ -897,6 +938,7 @@ namespace Elastos {
 		}
 
 		void Transaction::Cleanup() {
+			ResetHash();
 			_inputs.clear();
 			_outputs.clear();
 			_attributes.clear();
@@ -910,6 +952,7 @@ namespace Elastos {
 
 		void Transaction::SetPayloadVersion(uint8_t version) {
 			_payloadVersion = version;
+			ResetHash();
 		}
 
 		uint64_t Transaction::GetFee() const {
@@ -921,14 +964,18 @@ namespace Elastos {
 		}
 
 		bool Transaction::IsEqual(const Transaction *tx) const {
-			return (tx == this || _txHash == tx->GetHash());
+			return (tx == this || GetHash() == tx->GetHash());
 		}
 
 		uint32_t Transaction::GetConfirms(uint32_t walletBlockHeight) const {
-			if (_blockHeight == TX_UNCONFIRMED)
+			return GetConfirms(_blockHeight, walletBlockHeight);
+		}
+
+		uint32_t Transaction::GetConfirms(uint32_t blockHeight, uint32_t walletBlockHeight) {
+			if (blockHeight == TX_UNCONFIRMED)
 				return 0;
 
-			return walletBlockHeight >= _blockHeight ? walletBlockHeight - _blockHeight + 1 : 0;
+			return walletBlockHeight >= blockHeight ? walletBlockHeight - blockHeight + 1 : 0;
 		}
 
 	}
@@ -7,9 +7,12 @@
 
 #include <Plugin/Interface/ELAMessageSerializable.h>
 #include <Plugin/Transaction/Payload/IPayload.h>
+#include <Common/Amount.h>
 
 #include <boost/shared_ptr.hpp>
 
+#include <map>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -18,6 +21,7 @@ namespace Elastos {
 		class TransactionInput;
 		class Program;
 		class Attribute;
+		struct TransactionSummary;
 		typedef boost::shared_ptr<Wallet> WalletPtr;
 		typedef boost::shared_ptr<TransactionOutput> OutputPtr;
 		typedef std::vector<OutputPtr> OutputArray;
@@ -83,9 +87,9 @@ namespace Elastos {
 
 			void Serialize(ByteStream &ostream, bool extend = false) const;
 
-			bool Deserialize(const ByteStream &istream, bool extend = false);
+			bool Deserialize(const ByteStreamView &istream, bool extend = false);
 
-			virtual bool DeserializeType(const ByteStream &istream);
+			virtual bool DeserializeType(const ByteStreamView &istream);
 
 			uint64_t CalculateFee(uint64_t feePerKb);
 
@@ -99,6 +103,8 @@ namespace Elastos {
 
 			void SetHash(const uint256 &hash);
 
+			// Drops the cached hash, sighash and serialization. Every mutator does this itself, only an output
+			// changed in place through its pointer needs an explicit call.
 			void ResetHash();
 
 			const TxVersion &GetVersion() const;
@@ -119,8 +125,6 @@ namespace Elastos {
 
 			const std::vector<InputPtr> &GetInputs() const;
 
-			std::vector<InputPtr> &GetInputs();
-
 			void AddInput(const InputPtr &Input);
 
 			bool ContainInput(const uint256 &hash, uint32_t n) const;
@@ -157,8 +161,6 @@ namespace Elastos {
 
 			const IPayload *GetPayload() const;
 
-			IPayload *GetPayload();
-
 			const PayloadPtr &GetPayloadPtr() const;
 
 			void SetPayload(const PayloadPtr &payload);
@@ -177,6 +179,15 @@ namespace Elastos {
 
 			nlohmann::json GetSummary(const WalletPtr &wallet, uint32_t confirms, bool detail);
 
+			// The listing fields of GetSummary, built from a stored summary without the tx.
+			static nlohmann::json GetSummary(const TransactionSummary &summary, uint32_t confirms);
+
+			// Direction ("Received", "Sent" or "Moved"), amount and fee listed by GetSummary, optionally with the
+			// wallet's spent inputs and the relevant outputs summed per address.
+			void GetSummaryAmounts(const WalletPtr &wallet, std::string &direction, Amount &amount, uint64_t &fee,
+								   std::map<uint168, Amount> *inputList = nullptr,
+								   std::map<uint168, Amount> *outputList = nullptr) const;
+
 			uint8_t	GetPayloadVersion() const;
 
 			void SetPayloadVersion(uint8_t version);
@@ -187,6 +198,9 @@ namespace Elastos {
 
 			void SerializeUnsigned(ByteStream &ostream, bool extend = false) const;
 
+			// SerializeUnsigned output, cached until the next ResetHash.
+			const bytes_t &GetUnsignedBytes(bool extend = false) const;
+
 			uint256 GetShaData() const;
 
 			void Cleanup();
@@ -195,6 +209,8 @@ namespace Elastos {
 
 			uint32_t GetConfirms(uint32_t walletBlockHeight) const;
 
+			static uint32_t GetConfirms(uint32_t blockHeight, uint32_t walletBlockHeight);
+
 		public:
 			virtual PayloadPtr InitPayload(uint8_t type);
 
@@ -206,6 +222,8 @@ namespace Elastos {
 		protected:
 			bool _isRegistered;
 			mutable uint256 _txHash;
+			mutable uint256 _shaData;
+			mutable bytes_t _unsignedBytes[2]; // indexed by extend, empty until first use
 
 			TxVersion _version; // uint8_t
 			uint32_t _lockTime;
@@ -81,7 +81,7 @@ namespace Elastos {
 			ostream.WriteUint32(_sequence);
 		}
 
-		bool TransactionInput::Deserialize(const ByteStream &istream) {
+		bool TransactionInput::Deserialize(const ByteStreamView &istream) {
 			if (!istream.ReadBytes(_txHash)) {
 				Log::error("deserialize tx's txHash error");
 				return false;
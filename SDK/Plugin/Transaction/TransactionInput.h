@@ -43,7 +43,7 @@ namespace Elastos {
 
 			void Serialize(ByteStream &ostream) const;
 
-			bool Deserialize(const ByteStream &istream);
+			bool Deserialize(const ByteStreamView &istream);
 
 			nlohmann::json ToJson() const;
 
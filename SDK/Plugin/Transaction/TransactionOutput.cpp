@@ -44,7 +44,7 @@ namespace Elastos {
 			return *this;
 		}
 
-		TransactionOutput::TransactionOutput(const BigInt &a, const Address &addr, const uint256 &assetID,
+		TransactionOutput::TransactionOutput(const ElaWallet::Amount &a, const Address &addr, const uint256 &assetID,
 											 Type type, const OutputPayloadPtr &payload) :
 			_fixedIndex(0),
 			_outputLock(0),
@@ -68,24 +68,23 @@ namespace Elastos {
 			return _addr;
 		}
 
-		const BigInt &TransactionOutput::Amount() const {
+		const Amount &TransactionOutput::Amount() const {
 			return _amount;
 		}
 
-		void TransactionOutput::SetAmount(const BigInt &a) {
+		void TransactionOutput::SetAmount(const ElaWallet::Amount &a) {
 			_amount = a;
 		}
 
 		size_t TransactionOutput::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += _assetID.size();
 			if (_assetID == Asset::GetELAAssetID()) {
 				size += sizeof(uint64_t);
 			} else {
 				bytes_t amountBytes = _amount.getHexBytes();
-				size += stream.WriteVarUint(amountBytes.size());
+				size += ByteStream::VarUintSize(amountBytes.size());
 				size += amountBytes.size();
 			}
 
@@ -99,10 +98,7 @@ namespace Elastos {
 			ostream.WriteBytes(_assetID);
 
 			if (_assetID == Asset::GetELAAssetID()) {
-				bytes_t bytes = _amount.getHexBytes(true);
-				uint64_t amount = 0;
-				memcpy(&amount, &bytes[0], MIN(bytes.size(), sizeof(uint64_t)));
-				ostream.WriteUint64(amount);
+				ostream.WriteUint64(_amount.getUint64());
 			} else {
 				ostream.WriteVarBytes(_amount.getHexBytes());
 			}
@@ -120,7 +116,7 @@ namespace Elastos {
 			}
 		}
 
-		bool TransactionOutput::Deserialize(const ByteStream &istream, uint8_t txVersion, bool extend) {
+		bool TransactionOutput::Deserialize(const ByteStreamView &istream, uint8_t txVersion, bool extend) {
 			if (!istream.ReadBytes(_assetID)) {
 				Log::error("deserialize output assetid error");
 				return false;
@@ -132,7 +128,7 @@ namespace Elastos {
 					Log::error("deserialize output amount error");
 					return false;
 				}
-				_amount.setHexBytes(bytes_t(&amount, sizeof(amount)), true);
+				_amount.setUint64(amount);
 			} else {
 				bytes_t bytes;
 				if (!istream.ReadVarBytes(bytes)) {
@@ -9,7 +9,7 @@
 #include <Plugin/Transaction/Payload/OutputPayload/IOutputPayload.h>
 #include <Plugin/Transaction/Asset.h>
 #include <WalletCore/Address.h>
-#include <Common/BigInt.h>
+#include <Common/Amount.h>
 
 #include <boost/shared_ptr.hpp>
 
@@ -31,7 +31,7 @@ namespace Elastos {
 
 			TransactionOutput &operator=(const TransactionOutput &tx);
 
-			TransactionOutput(const BigInt &amount, const Address &toAddress, const uint256 &assetID = Asset::GetELAAssetID(),
+			TransactionOutput(const ElaWallet::Amount &amount, const Address &toAddress, const uint256 &assetID = Asset::GetELAAssetID(),
 							  Type type = Default, const OutputPayloadPtr &payload = nullptr);
 
 			~TransactionOutput();
@@ -40,15 +40,15 @@ namespace Elastos {
 
 			void Serialize(ByteStream &ostream, uint8_t txVersion, bool extend = false) const;
 
-			bool Deserialize(const ByteStream &istream, uint8_t txVersion, bool extend = false);
+			bool Deserialize(const ByteStreamView &istream, uint8_t txVersion, bool extend = false);
 
 			bool IsValid() const;
 
 			const AddressPtr &Addr() const;
 
-			const BigInt &Amount() const;
+			const ElaWallet::Amount &Amount() const;
 
-			void SetAmount(const BigInt &amount);
+			void SetAmount(const ElaWallet::Amount &amount);
 
 			const uint256 &AssetID() const;
 
@@ -83,7 +83,7 @@ namespace Elastos {
 		private:
 			uint16_t _fixedIndex;
 
-			BigInt _amount; // to support token chain
+			ElaWallet::Amount _amount; // to support token chain
 			uint256 _assetID;
 			uint32_t _outputLock;
 			AddressPtr _addr;
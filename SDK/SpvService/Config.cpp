@@ -22,7 +22,9 @@ namespace Elastos {
 			_minFee(0),
 			_feePerKB(0),
 			_disconnectionTime(0),
-			_chainParameters(nullptr) {
+			_chainParameters(nullptr),
+			_databaseProfile(DurabilityProfile::Normal()),
+			_bulkSyncBlocks(2000) {
 		}
 
 		const uint32_t &ChainConfig::Index() const {
@@ -49,6 +51,14 @@ namespace Elastos {
 			return _chainParameters;
 		}
 
+		const DurabilityProfile &ChainConfig::DatabaseProfile() const {
+			return _databaseProfile;
+		}
+
+		const uint32_t &ChainConfig::BulkSyncBlocks() const {
+			return _bulkSyncBlocks;
+		}
+
 		Config::Config(const Config &cfg) {
 			this->operator=(cfg);
 		}
@@ -114,6 +124,34 @@ namespace Elastos {
 					if (chainConfigJson.find("DisconnectionTime") != chainConfigJson.end())
 						chainConfig->_disconnectionTime = chainConfigJson["DisconnectionTime"].get<uint32_t>();
 
+					if (chainConfigJson.find("Database") != chainConfigJson.end()) {
+						nlohmann::json databaseJson = chainConfigJson["Database"];
+
+						if (databaseJson.find("Profile") != databaseJson.end()) {
+							std::string profile = databaseJson["Profile"].get<std::string>();
+							if (!DurabilityProfile::FromName(profile, chainConfig->_databaseProfile))
+								Log::error("unknown database profile: {} in config json", profile);
+						}
+
+						if (databaseJson.find("JournalMode") != databaseJson.end())
+							chainConfig->_databaseProfile.JournalMode = databaseJson["JournalMode"].get<std::string>();
+
+						if (databaseJson.find("Synchronous") != databaseJson.end())
+							chainConfig->_databaseProfile.Synchronous = databaseJson["Synchronous"].get<std::string>();
+
+						if (databaseJson.find("CacheSize") != databaseJson.end())
+							chainConfig->_databaseProfile.CacheSize = databaseJson["CacheSize"].get<int64_t>();
+
+						if (databaseJson.find("MmapSize") != databaseJson.end())
+							chainConfig->_databaseProfile.MmapSize = databaseJson["MmapSize"].get<int64_t>();
+
+						if (databaseJson.find("AutoCheckpoint") != databaseJson.end())
+							chainConfig->_databaseProfile.AutoCheckpoint = databaseJson["AutoCheckpoint"].get<int>();
+
+						if (databaseJson.find("BulkSyncBlocks") != databaseJson.end())
+							chainConfig->_bulkSyncBlocks = databaseJson["BulkSyncBlocks"].get<uint32_t>();
+					}
+
 					if (chainConfigJson.find("ChainParameters") != chainConfigJson.end()) {
 						nlohmann::json chainParamsJson = chainConfigJson["ChainParameters"];
 						ChainParamsPtr chainParams(new ChainParams());
@@ -187,7 +225,7 @@ namespace Elastos {
 			bool changed = false;
 
 			const std::vector<std::string> configNames = {"Index", "MinFee", "FeePerKB", "GenesisAddress",
-														  "DisconnectionTime"};
+														  "DisconnectionTime", "Database"};
 
 			for (const std::string &configName : configNames) {
 				if (newConfig.find(configName) != newConfig.end()) {
@@ -5,6 +5,8 @@
 #ifndef __ELASTOS_SDK_CONFIG_H__
 #define __ELASTOS_SDK_CONFIG_H__
 
+#include <Database/Sqlite.h>
+
 #include <nlohmann/json.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
@@ -38,6 +40,11 @@ namespace Elastos {
 
 			const ChainParamsPtr &ChainParameters() const;
 
+			const DurabilityProfile &DatabaseProfile() const;
+
+			// Initial catch-up runs with DurabilityProfile::BulkSync() when more than this many blocks behind, 0 disables it.
+			const uint32_t &BulkSyncBlocks() const;
+
 		private:
 			friend class Config;
 
@@ -47,6 +54,8 @@ namespace Elastos {
 			uint32_t _disconnectionTime;
 			std::string _genesisAddress;
 			ChainParamsPtr _chainParameters;
+			DurabilityProfile _databaseProfile;
+			uint32_t _bulkSyncBlocks;
 		};
 
 		typedef boost::shared_ptr<ChainConfig> ChainConfigPtr;
@@ -10,6 +10,10 @@
 #include <Common/ErrorChecker.h>
 #include <SpvService/Config.h>
 
+#include <boost/thread.hpp>
+
+#include <chrono>
+#include <exception>
 #include <sstream>
 
 namespace Elastos {
@@ -32,36 +36,93 @@ namespace Elastos {
 				ErrorChecker::ThrowParamException(Error::InvalidChainID, "invalid chain ID");
 			}
 
-			std::vector<TransactionPtr>  txs = loadTransactions(chainID);
-			std::vector<UTXOPtr> cbs = loadCoinBaseUTXOs();
+			typedef std::chrono::steady_clock Clock;
+			Clock::time_point start = Clock::now();
+			auto elapsed = [](Clock::time_point since) {
+				return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+			};
+
+			// headers come from their own file, so blocks load while the database is read on this thread.
+			// the loader refers to the locals below, it is joined before any of them goes out of scope
+			std::vector<MerkleBlockPtr> blocks;
+			std::vector<PeerInfo> peers;
+			std::set<PeerInfo> blackPeers;
+			std::exception_ptr loaderError;
+			boost::thread blockLoader;
+			if (_peerManager == nullptr) {
+				blockLoader = boost::thread([&]() {
+					try {
+						Clock::time_point t = Clock::now();
+						blocks = loadBlocks(chainID);
+						Log::info("startup: {} blocks loaded in {} ms", blocks.size(), elapsed(t));
+					} catch (...) {
+						loaderError = std::current_exception();
+					}
+				});
+			}
+
+			std::vector<TransactionPtr> txs;
+			std::vector<UTXOPtr> cbs;
+			try {
+				Clock::time_point t = Clock::now();
+				txs = loadTransactions(chainID);
+				Log::info("startup: {} txs loaded in {} ms", txs.size(), elapsed(t));
+
+				t = Clock::now();
+				cbs = loadCoinBaseUTXOs();
+				Log::info("startup: {} coinbase utxos loaded in {} ms", cbs.size(), elapsed(t));
+
+				std::sort(txs.begin(), txs.end(), [](const TransactionPtr &a, const TransactionPtr &b) {
+					return a->GetBlockHeight() < b->GetBlockHeight();
+				});
+
+				std::sort(cbs.begin(), cbs.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
+					return a->BlockHeight() < b->BlockHeight();
+				});
+
+				if (_peerManager == nullptr) {
+					t = Clock::now();
+					peers = loadPeers();
+					blackPeers = loadBlackPeers();
+					Log::info("startup: {} peers loaded in {} ms", peers.size() + blackPeers.size(), elapsed(t));
+				}
+			} catch (...) {
+				if (blockLoader.joinable())
+					blockLoader.join();
+				throw;
+			}
 
-			std::sort(txs.begin(), txs.end(), [](const TransactionPtr &a, const TransactionPtr &b) {
-				return a->GetBlockHeight() < b->GetBlockHeight();
-			});
+			if (blockLoader.joinable())
+				blockLoader.join();
 
-			std::sort(cbs.begin(), cbs.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-				return a->BlockHeight() < b->BlockHeight();
-			});
+			// rethrown here, on the caller's thread
+			if (loaderError)
+				std::rethrow_exception(loaderError);
 
+			Clock::time_point t;
 			if (_peerManager == nullptr) {
 				_peerManager = PeerManagerPtr(new PeerManager(
 						config->ChainParameters(),
 						nullptr,
 						earliestPeerTime,
 						config->DisconnectionTime(),
-						loadBlocks(chainID),
-						loadPeers(),
-						loadBlackPeers(),
+						blocks,
+						peers,
+						blackPeers,
 						createPeerManagerListener(),
 						chainID,
 						netType));
 			}
 
 			if (_wallet == nullptr) {
+				t = Clock::now();
 				_wallet = WalletPtr(new Wallet(_peerManager->GetLastBlockHeight(), walletID, chainID,
 											   loadAssets(), txs, cbs, subAccount, createWalletListener()));
 				_peerManager->SetWallet(_wallet);
+				Log::info("startup: wallet built in {} ms", elapsed(t));
 			}
+
+			Log::info("startup: {} initialized in {} ms", chainID, elapsed(start));
 		}
 
 		CoreSpvService::~CoreSpvService() {
@@ -76,7 +137,7 @@ namespace Elastos {
 			return _peerManager;
 		}
 
-		void CoreSpvService::balanceChanged(const uint256 &asset, const BigInt &balance) {
+		void CoreSpvService::balanceChanged(const uint256 &asset, const Amount &balance) {
 
 		}
 
@@ -399,7 +460,7 @@ namespace Elastos {
 				_listener(listener) {
 		}
 
-		void WrappedExceptionWalletListener::balanceChanged(const uint256 &asset, const BigInt &balance) {
+		void WrappedExceptionWalletListener::balanceChanged(const uint256 &asset, const Amount &balance) {
 			try {
 				_listener->balanceChanged(asset, balance);
 			} catch (const std::exception &e) {
@@ -502,7 +563,7 @@ namespace Elastos {
 				_executor(executor) {
 		}
 
-		void WrappedExecutorWalletListener::balanceChanged(const uint256 &asset, const BigInt &balance) {
+		void WrappedExecutorWalletListener::balanceChanged(const uint256 &asset, const Amount &balance) {
 			_executor->Execute(Runnable([this, asset, balance]() -> void {
 				try {
 					_listener->balanceChanged(asset, balance);
@@ -41,7 +41,7 @@ namespace Elastos {
 			virtual const PeerManagerPtr &GetPeerManager() const;
 
 		public: //override from Wallet
-			virtual void balanceChanged(const uint256 &asset, const BigInt &balance);
+			virtual void balanceChanged(const uint256 &asset, const Amount &balance);
 
 			virtual void onCoinBaseTxAdded(const UTXOPtr &cb);
 
@@ -184,7 +184,7 @@ namespace Elastos {
 		public:
 			WrappedExceptionWalletListener(Wallet::Listener *listener);
 
-			virtual void balanceChanged(const uint256 &asset, const BigInt &balance);
+			virtual void balanceChanged(const uint256 &asset, const Amount &balance);
 
 			virtual void onCoinBaseTxAdded(const UTXOPtr &cb);
 
@@ -214,7 +214,7 @@ namespace Elastos {
 		public:
 			WrappedExecutorWalletListener(Wallet::Listener *listener, Executor *executor);
 
-			virtual void balanceChanged(const uint256 &asset, const BigInt &balance);
+			virtual void balanceChanged(const uint256 &asset, const Amount &balance);
 
 			virtual void onCoinBaseTxAdded(const UTXOPtr &cb);
 
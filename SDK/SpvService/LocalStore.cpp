@@ -102,7 +102,7 @@ namespace Elastos {
 					if (mpk.is_object()) {
 						bytes.setHex(mpk["ELA"]);
 						if (!bytes.isZero()) {
-							ByteStream stream(bytes);
+							ByteStreamView stream(bytes);
 							stream.Skip(4);
 							bytes_t pubKey, chainCode;
 							stream.ReadBytes(chainCode, 32);
@@ -4,6 +4,7 @@
 
 
 #include "SpvService.h"
+#include "Config.h"
 
 #include <Common/Log.h>
 #include <Common/Utils.h>
@@ -14,6 +15,8 @@
 #include <Plugin/Transaction/TransactionOutput.h>
 #include <Wallet/UTXO.h>
 #include <Database/DatabaseManager.h>
+#include <Database/WriteBehindQueue.h>
+#include <P2P/ChainParams.h>
 
 #include <BRMerkleBlock.h>
 #include <BRTransaction.h>
@@ -36,12 +39,25 @@ namespace Elastos {
 							   const ChainConfigPtr &config,
 							   const std::string &netType) :
 				_executor(BACKGROUND_THREAD_COUNT),
-				_databaseManager(new DatabaseManager(dbPath)) {
+				_databaseManager(new DatabaseManager(dbPath, config->DatabaseProfile())),
+				_writeBehind(new WriteBehindQueue(boost::bind(&DatabaseManager::BeginBatch, _databaseManager.get()),
+												  boost::bind(&DatabaseManager::EndBatch, _databaseManager.get()))),
+				_bulkSyncBlocks(config->BulkSyncBlocks()),
+				_targetTimePerBlock(config->ChainParameters()->TargetTimePerBlock()) {
 			Init(walletID, chainID, subAccount, earliestPeerTime, config, netType);
+			// queued behind the wallet callbacks sent during Init
+			_executor.Execute(Runnable([this]() -> void {
+				try {
+					SummarizeStoredTransactions();
+				} catch (const std::exception &e) {
+					Log::error("summarize stored transactions exception: {}", e.what());
+				}
+			}));
 		}
 
 		SpvService::~SpvService() {
 			_executor.StopThread();
+			_writeBehind->Stop();
 		}
 
 		void SpvService::SyncStart() {
@@ -69,11 +85,12 @@ namespace Elastos {
 		}
 
 		void SpvService::DatabaseFlush() {
+			_writeBehind->Flush();
 			_databaseManager->flush();
 		}
 
 		//override Wallet listener
-		void SpvService::balanceChanged(const uint256 &asset, const BigInt &balance) {
+		void SpvService::balanceChanged(const uint256 &asset, const Amount &balance) {
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&asset, &balance](Wallet::Listener *listener) {
 							  listener->balanceChanged(asset, balance);
@@ -81,8 +98,9 @@ namespace Elastos {
 		}
 
 		void SpvService::onCoinBaseTxAdded(const UTXOPtr &cb) {
-
-			_databaseManager->PutCoinBase(cb);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, cb]() { db->PutCoinBase(cb); });
+			SummarizeSpenders(cb->Hash(), cb->BlockHeight());
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&cb](Wallet::Listener *listener) {
@@ -96,13 +114,19 @@ namespace Elastos {
 			for (UTXOArray::const_iterator it = cbs.cbegin(); it != cbs.cend(); ++it)
 				txHashes.push_back((*it)->Hash());
 
-			_databaseManager->DeleteTxByHashes(txHashes);
-			_databaseManager->PutCoinBase(cbs);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, txHashes, cbs]() {
+				db->DeleteTxByHashes(txHashes);
+				db->SyncCoinBase(cbs);
+			});
 		}
 
 		void SpvService::onCoinBaseTxUpdated(const std::vector<uint256> &hashes, uint32_t blockHeight,
 											 time_t timestamp) {
-			_databaseManager->UpdateCoinBase(hashes, blockHeight, timestamp);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, hashes, blockHeight, timestamp]() {
+				db->UpdateCoinBase(hashes, blockHeight, timestamp);
+			});
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&hashes, &blockHeight, &timestamp](Wallet::Listener *listener) {
@@ -111,7 +135,8 @@ namespace Elastos {
 		}
 
 		void SpvService::onCoinBaseSpent(const UTXOArray &spentUTXO) {
-			_databaseManager->UpdateSpentCoinBase(spentUTXO);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, spentUTXO]() { db->UpdateSpentCoinBase(spentUTXO); });
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&spentUTXO](Wallet::Listener *listener) {
@@ -120,7 +145,8 @@ namespace Elastos {
 		}
 
 		void SpvService::onCoinBaseTxDeleted(const uint256 &hash, bool notifyUser, bool recommendRescan) {
-			_databaseManager->DeleteCoinBase(hash);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, hash]() { db->DeleteCoinBase(hash); });
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&hash, &notifyUser, &recommendRescan](Wallet::Listener *listener) {
@@ -129,7 +155,8 @@ namespace Elastos {
 		}
 
 		void SpvService::onTxAdded(const TransactionPtr &tx) {
-			_databaseManager->PutTransaction(ISO, tx);
+			WriteTransaction(tx);
+			SummarizeSpenders(tx->GetHash(), tx->GetBlockHeight());
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&tx](Wallet::Listener *listener) {
@@ -138,7 +165,10 @@ namespace Elastos {
 		}
 
 		void SpvService::onTxUpdated(const std::vector<uint256> &hashes, uint32_t blockHeight, time_t timestamp) {
-			_databaseManager->UpdateTransaction(hashes, blockHeight, timestamp);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, hashes, blockHeight, timestamp]() {
+				db->UpdateTransaction(hashes, blockHeight, timestamp);
+			});
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&hashes, &blockHeight, &timestamp](Wallet::Listener *listener) {
@@ -147,7 +177,8 @@ namespace Elastos {
 		}
 
 		void SpvService::onTxDeleted(const uint256 &hash, bool notifyUser, bool recommendRescan) {
-			_databaseManager->DeleteTxByHash(hash);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue("txns/" + hash.GetHex(), [db, hash]() { db->DeleteTxByHash(hash); });
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&hash, &notifyUser, &recommendRescan](Wallet::Listener *listener) {
@@ -156,8 +187,17 @@ namespace Elastos {
 		}
 
 		void SpvService::onTxUpdatedAll(const std::vector<TransactionPtr> &txns) {
-			_databaseManager->DeleteAllTransactions();
-			_databaseManager->PutTransactions(ISO, txns);
+			std::vector<TransactionEntity> entities;
+			entities.reserve(txns.size());
+			// sent while the wallet is constructed, see SummarizeStoredTransactions
+			for (size_t i = 0; i < txns.size(); ++i)
+				entities.push_back(TransactionEntity(*txns[i]));
+
+			// replaces the whole table, so a newer snapshot supersedes a pending one
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue("txns", [db, entities]() {
+				db->SyncTransactions(ISO, entities);
+			});
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&txns](Wallet::Listener *listener) {
@@ -170,7 +210,9 @@ namespace Elastos {
 			ByteStream stream;
 			asset->Serialize(stream);
 			AssetEntity assetEntity(assetID, amount, stream.GetBytes());
-			_databaseManager->PutAsset(asset->GetName(), assetEntity);
+			std::string name = asset->GetName();
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, name, assetEntity]() { db->PutAsset(name, assetEntity); });
 
 			std::for_each(_walletListeners.begin(), _walletListeners.end(),
 						  [&asset, &amount, &controller](Wallet::Listener *listener) {
@@ -180,6 +222,12 @@ namespace Elastos {
 
 		//override PeerManager listener
 		void SpvService::syncStarted() {
+			uint32_t behind = BlocksBehind();
+			if (_bulkSyncBlocks > 0 && behind > _bulkSyncBlocks) {
+				Log::info("{} blocks behind, relax database durability until sync stopped", behind);
+				_databaseManager->BeginBulkSync();
+			}
+
 			std::for_each(_peerManagerListeners.begin(), _peerManagerListeners.end(),
 						  [](PeerManager::Listener *listener) {
 							  listener->syncStarted();
@@ -194,12 +242,28 @@ namespace Elastos {
 		}
 
 		void SpvService::syncStopped(const std::string &error) {
+			if (_databaseManager->IsBulkSync() && !_databaseManager->EndBulkSync())
+				Log::error("restore database durability failed");
+
 			std::for_each(_peerManagerListeners.begin(), _peerManagerListeners.end(),
 						  [&error](PeerManager::Listener *listener) {
 							  listener->syncStopped(error);
 						  });
 		}
 
+		uint32_t SpvService::BlocksBehind() const {
+			uint32_t lastHeight = GetPeerManager()->GetLastBlockHeight();
+			uint32_t estimatedHeight = GetPeerManager()->GetEstimatedBlockHeight();
+			uint32_t behind = estimatedHeight - lastHeight;
+
+			// before any peer has reported its height, estimate from the age of the last block
+			time_t elapsed = time(NULL) - (time_t)GetPeerManager()->GetLastBlockTimestamp();
+			if (_targetTimePerBlock > 0 && elapsed > 0 && elapsed / _targetTimePerBlock > behind)
+				behind = (uint32_t)(elapsed / _targetTimePerBlock);
+
+			return behind;
+		}
+
 		void SpvService::txStatusUpdate() {
 			std::for_each(_peerManagerListeners.begin(), _peerManagerListeners.end(),
 						  [](PeerManager::Listener *listener) {
@@ -209,10 +273,6 @@ namespace Elastos {
 
 		void SpvService::saveBlocks(bool replace, const std::vector<MerkleBlockPtr> &blocks) {
 
-			if (replace) {
-				_databaseManager->DeleteAllBlocks(ISO);
-			}
-
 			if (blocks.size() == 1) {
 				SPVLOG_INFO("{} checkpoint ====> [{}, \"{}\", {}, {}],",
 				           _peerManager->GetID(),
@@ -222,7 +282,23 @@ namespace Elastos {
 				           blocks[0]->GetTarget());
 			}
 
-			_databaseManager->PutMerkleBlocks(ISO, blocks);
+			// copied here, the peer manager keeps changing blocks after handing them over
+			std::vector<HeaderRecord> records;
+			for (size_t i = 0; i < blocks.size(); ++i)
+				records.push_back(HeaderRecord(*blocks[i]));
+
+			DatabaseManagerPtr db = _databaseManager;
+			if (replace) {
+				_writeBehind->Enqueue("blocks", [db, records]() { db->SyncMerkleBlocks(ISO, records); });
+			} else {
+				for (size_t i = 0; i < records.size(); ++i) {
+					std::vector<HeaderRecord> record(1, records[i]);
+					_writeBehind->Enqueue("blocks/" + records[i].Hash.GetHex(), [db, record]() {
+						db->PutMerkleBlocks(ISO, record);
+					});
+				}
+			}
+			_writeBehind->EndBatch();
 
 			std::for_each(_peerManagerListeners.begin(), _peerManagerListeners.end(),
 						  [replace, &blocks](PeerManager::Listener *listener) {
@@ -232,10 +308,6 @@ namespace Elastos {
 
 		void SpvService::savePeers(bool replace, const std::vector<PeerInfo> &peers) {
 
-			if (replace) {
-				_databaseManager->DeleteAllPeers();
-			}
-
 			std::vector<PeerEntity> peerEntityList;
 			PeerEntity peerEntity;
 			for (size_t i = 0; i < peers.size(); ++i) {
@@ -244,7 +316,19 @@ namespace Elastos {
 				peerEntity.timeStamp = peers[i].Timestamp;
 				peerEntityList.push_back(peerEntity);
 			}
-			_databaseManager->PutPeers(peerEntityList);
+			DatabaseManagerPtr db = _databaseManager;
+			if (replace) {
+				_writeBehind->Enqueue("peers", [db, peerEntityList]() {
+					db->DeleteAllPeers();
+					db->PutPeers(peerEntityList);
+				});
+			} else {
+				for (size_t i = 0; i < peerEntityList.size(); ++i) {
+					const PeerEntity &entity = peerEntityList[i];
+					_writeBehind->Enqueue("peers/" + entity.address.GetHex() + ":" + std::to_string(entity.port),
+										  [db, entity]() { db->PutPeer(entity); });
+				}
+			}
 
 			std::for_each(_peerManagerListeners.begin(), _peerManagerListeners.end(),
 						  [replace, &peers](PeerManager::Listener *listener) {
@@ -258,28 +342,38 @@ namespace Elastos {
 			entity.port = peer.Port;
 			entity.timeStamp = peer.Timestamp;
 
-			_databaseManager->PutBlackPeer(entity);
-			_databaseManager->DeletePeer(entity);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, entity]() {
+				db->PutBlackPeer(entity);
+				db->DeletePeer(entity);
+			});
 		}
 
 		void SpvService::saveDIDInfo(const DIDEntity &didEntity) {
-			_databaseManager->PutDID(ISO, didEntity);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, didEntity]() { db->PutDID(ISO, didEntity); });
 		}
 
 		void SpvService::updateDIDInfo(const std::vector<uint256> &hashes, uint32_t blockHeight, time_t timeStamp) {
-			_databaseManager->UpdateDID(hashes, blockHeight, timeStamp);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, hashes, blockHeight, timeStamp]() {
+				db->UpdateDID(hashes, blockHeight, timeStamp);
+			});
 		}
 
 		void SpvService::deleteDIDInfo(const std::string &txHash) {
-			_databaseManager->DeleteDIDByTxHash(txHash);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, txHash]() { db->DeleteDIDByTxHash(txHash); });
 		}
 
 		std::string SpvService::GetDIDByTxHash(const std::string &txHash) const {
+			_writeBehind->Flush();
 			return _databaseManager->GetDIDByTxHash(txHash);
 		}
 
-		std::vector<DIDEntity> SpvService::loadDIDList() const {
-			return _databaseManager->GetAllDID();
+		bool SpvService::loadDIDList(const boost::function<bool(const DIDEntity &)> &visitor) const {
+			_writeBehind->Flush();
+			return _databaseManager->ForEachDID(visitor);
 		}
 
 		bool SpvService::networkIsReachable() {
@@ -307,13 +401,79 @@ namespace Elastos {
 		}
 
 		TransactionPtr SpvService::GetTransaction(const uint256 &hash, const std::string &chainID) {
+			_writeBehind->Flush();
 			return _databaseManager->GetTransaction(hash, chainID);
 		}
 
 		size_t SpvService::GetAllTransactionsCount() {
+			_writeBehind->Flush();
 			return _databaseManager->GetAllTransactionsCount();
 		}
 
+		std::vector<TransactionSummary> SpvService::GetTransactionSummaries(const bytes_t &types, size_t start,
+																			size_t count) {
+			_writeBehind->Flush();
+			return _databaseManager->GetTransactionSummaries(types, start, count);
+		}
+
+		size_t SpvService::GetTransactionSummaryCount(const bytes_t &types) {
+			_writeBehind->Flush();
+			return _databaseManager->GetTransactionSummaryCount(types);
+		}
+
+		// A summary is computed against the wallet as the tx is written. It also depends on the txs its inputs
+		// spend, so a tx arriving after its spenders has them written again, see SummarizeSpenders.
+		TransactionEntity SpvService::Summarize(const TransactionPtr &tx) const {
+			TransactionSummary summary;
+			tx->GetSummaryAmounts(_wallet, summary.Direction, summary.Amount, summary.Fee);
+			summary.Type = tx->GetTransactionType();
+			// serialized here, the writer thread must not read a tx the wallet may still change
+			return TransactionEntity(*tx, summary);
+		}
+
+		void SpvService::WriteTransaction(const TransactionPtr &tx) {
+			TransactionEntity entity = Summarize(tx);
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue("txns/" + entity.TxHash.GetHex(), [db, entity]() { db->ReplaceTransaction(ISO, entity); });
+		}
+
+		// Addresses the wallet derives later lie past every address a stored tx pays to, so only the spenders
+		// of a new tx can have a stale summary.
+		void SpvService::SummarizeSpenders(const uint256 &hash, uint32_t blockHeight) {
+			std::vector<TransactionPtr> spenders = _wallet->TransactionsSpending(hash, blockHeight);
+			for (size_t i = 0; i < spenders.size(); ++i)
+				WriteTransaction(spenders[i]);
+		}
+
+		// Rows written before summaries were stored, or by onTxUpdatedAll before the wallet existed.
+		void SpvService::SummarizeStoredTransactions() {
+			_writeBehind->Flush();
+			std::vector<uint256> hashes = _databaseManager->GetTransactionsWithoutSummary();
+			if (hashes.empty())
+				return;
+
+			std::vector<TransactionSummary> summaries;
+			summaries.reserve(hashes.size());
+			for (size_t i = 0; i < hashes.size(); ++i) {
+				TransactionSummary summary;
+				summary.TxHash = hashes[i];
+
+				// left with an empty direction, so the row is neither listed nor looked up again
+				TransactionPtr tx = _wallet->TransactionForHash(hashes[i]);
+				if (tx != nullptr) {
+					tx->GetSummaryAmounts(_wallet, summary.Direction, summary.Amount, summary.Fee);
+					summary.Type = tx->GetTransactionType();
+				}
+				summaries.push_back(summary);
+			}
+
+			DatabaseManagerPtr db = _databaseManager;
+			_writeBehind->Enqueue([db, summaries]() {
+				if (!db->UpdateTransactionSummaries(summaries))
+					Log::error("update {} transaction summaries failed", summaries.size());
+			});
+		}
+
 		std::vector<UTXOPtr> SpvService::loadCoinBaseUTXOs() {
 			return _databaseManager->GetAllCoinBase();
 		}
@@ -330,11 +490,10 @@ namespace Elastos {
 		std::vector<PeerInfo> SpvService::loadPeers() {
 			std::vector<PeerInfo> peers;
 
-			std::vector<PeerEntity> peersEntity = _databaseManager->GetAllPeers();
-
-			for (size_t i = 0; i < peersEntity.size(); ++i) {
-				peers.push_back(PeerInfo(peersEntity[i].address, peersEntity[i].port, peersEntity[i].timeStamp));
-			}
+			_databaseManager->ForEachPeer([&peers](const PeerEntity &entity) {
+				peers.push_back(PeerInfo(entity.address, entity.port, entity.timeStamp));
+				return true;
+			});
 
 			return peers;
 		}
@@ -342,11 +501,10 @@ namespace Elastos {
 		std::set<PeerInfo> SpvService::loadBlackPeers() {
 			std::set<PeerInfo> peers;
 
-			std::vector<PeerEntity> entity = _databaseManager->GetAllBlackPeers();
-
-			for (size_t i = 0; i < entity.size(); ++i) {
-				peers.insert(PeerInfo(entity[i].address, entity[i].port, entity[i].timeStamp));
-			}
+			_databaseManager->ForEachBlackPeer([&peers](const PeerEntity &entity) {
+				peers.insert(PeerInfo(entity.address, entity.port, entity.timeStamp));
+				return true;
+			});
 
 			return peers;
 		}
@@ -354,16 +512,15 @@ namespace Elastos {
 		std::vector<AssetPtr> SpvService::loadAssets() {
 			std::vector<AssetPtr> assets;
 
-			std::vector<AssetEntity> assetsEntity = _databaseManager->GetAllAssets();
-
-			for (size_t i = 0; i < assetsEntity.size(); ++i) {
-				ByteStream stream(assetsEntity[i].Asset);
+			_databaseManager->ForEachAsset([&assets](const AssetEntity &entity) {
+				ByteStreamView stream(entity.Asset);
 				AssetPtr asset(new Asset());
 				if (asset->Deserialize(stream)) {
-					asset->SetHash(uint256(assetsEntity[i].AssetID));
+					asset->SetHash(uint256(entity.AssetID));
 					assets.push_back(asset);
 				}
-			}
+				return true;
+			});
 
 			return assets;
 		}
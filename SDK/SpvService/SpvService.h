@@ -11,14 +11,18 @@
 #include <boost/filesystem.hpp>
 #include <boost/function.hpp>
 #include <nlohmann/json.hpp>
+#include <set>
 #include <vector>
 
 namespace Elastos {
 	namespace ElaWallet {
 
 		class DatabaseManager;
+		class WriteBehindQueue;
 		class Transaction;
 		struct DIDEntity;
+		struct TransactionEntity;
+		struct TransactionSummary;
 
 		typedef boost::shared_ptr<Transaction> TransactionPtr;
 		typedef boost::shared_ptr<DatabaseManager> DatabaseManagerPtr;
@@ -47,6 +51,11 @@ namespace Elastos {
 
 			size_t GetAllTransactionsCount();
 
+			// History listings served by the database, see DatabaseManager::GetTransactionSummaries.
+			std::vector<TransactionSummary> GetTransactionSummaries(const bytes_t &types, size_t start, size_t count);
+
+			size_t GetTransactionSummaryCount(const bytes_t &types);
+
 			void RegisterWalletListener(Wallet::Listener *listener);
 
 			void RegisterPeerManagerListener(PeerManager::Listener *listener);
@@ -55,8 +64,17 @@ namespace Elastos {
 
 			void DatabaseFlush();
 
+		private:
+			TransactionEntity Summarize(const TransactionPtr &tx) const;
+
+			void WriteTransaction(const TransactionPtr &tx);
+
+			void SummarizeSpenders(const uint256 &hash, uint32_t blockHeight);
+
+			void SummarizeStoredTransactions();
+
 		public:
-			virtual void balanceChanged(const uint256 &asset, const BigInt &balance);
+			virtual void balanceChanged(const uint256 &asset, const Amount &balance);
 
 			virtual void onCoinBaseTxAdded(const UTXOPtr &cb);
 
@@ -107,7 +125,7 @@ namespace Elastos {
 
 			virtual std::string GetDIDByTxHash(const std::string &txHash) const;
 
-			virtual std::vector<DIDEntity> loadDIDList()  const;
+			virtual bool loadDIDList(const boost::function<bool(const DIDEntity &)> &visitor) const;
 
 		protected:
 			virtual std::vector<UTXOPtr> loadCoinBaseUTXOs();
@@ -126,8 +144,14 @@ namespace Elastos {
 
 			virtual const WalletListenerPtr &createWalletListener();
 
+		private:
+			uint32_t BlocksBehind() const;
+
 		private:
 			DatabaseManagerPtr _databaseManager;
+			boost::shared_ptr<WriteBehindQueue> _writeBehind;
+			uint32_t _bulkSyncBlocks;
+			uint32_t _targetTimePerBlock;
 
 			BackgroundExecutor _executor;
 
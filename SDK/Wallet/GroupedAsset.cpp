@@ -41,46 +41,46 @@ namespace Elastos {
 			_balanceVote = proto._balanceVote;
 			_balanceLocked = proto._balanceLocked;
 			_balanceDeposit = proto._balanceDeposit;
-			_utxos = proto._utxos;
-			_utxosVote = proto._utxosVote;
-			_utxosCoinbase = proto._utxosCoinbase;
-			_utxosDeposit = proto._utxosDeposit;
-			_utxosLocked = proto._utxosLocked;
+			_utxoTable = proto._utxoTable;
 			*_asset = *proto._asset;
 			_parent = proto._parent;
 			return *this;
 		}
 
 		UTXOArray GroupedAsset::GetUTXOs(const std::string &addr) const {
-			UTXOArray result;
+			std::vector<size_t> rows;
+			const UTXOTable::Kind kinds[] = {UTXOTable::Normal, UTXOTable::Vote, UTXOTable::Coinbase,
+											 UTXOTable::Deposit, UTXOTable::Locked};
+
+			for (size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); ++i) {
+				std::vector<size_t> kindRows = _utxoTable.Rows(kinds[i]);
+				rows.insert(rows.end(), kindRows.begin(), kindRows.end());
+			}
 
-			result.insert(result.end(), _utxos.begin(), _utxos.end());
-			result.insert(result.end(), _utxosVote.begin(), _utxosVote.end());
-			result.insert(result.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
-			result.insert(result.end(), _utxosDeposit.begin(), _utxosDeposit.end());
-			result.insert(result.end(), _utxosLocked.begin(), _utxosLocked.end());
 			if (!addr.empty()) {
-				for (UTXOArray::iterator it = result.begin(); it != result.end();) {
-					if (addr != (*it)->Output()->Addr()->String()) {
-						it = result.erase(it);
+				Address address(addr);
+				size_t addrIndex = address.Valid() ? _utxoTable.FindAddress(address.ProgramHash()) : UTXOTable::npos;
+				for (std::vector<size_t>::iterator it = rows.begin(); it != rows.end();) {
+					if (addrIndex == UTXOTable::npos || _utxoTable.GetAddressIndex(*it) != addrIndex) {
+						it = rows.erase(it);
 					} else {
 						++it;
 					}
 				}
 			}
 
-			return result;
+			return RowsToUTXOs(rows);
 		}
 
-		const UTXOSet &GroupedAsset::GetVoteUTXO() const {
-			return _utxosVote;
+		UTXOArray GroupedAsset::GetVoteUTXO() const {
+			return RowsToUTXOs(_utxoTable.Rows(UTXOTable::Vote));
 		}
 
-		const UTXOSet &GroupedAsset::GetCoinBaseUTXOs() const {
-			return _utxosCoinbase;
+		UTXOArray GroupedAsset::GetCoinBaseUTXOs() const {
+			return RowsToUTXOs(_utxoTable.Rows(UTXOTable::Coinbase));
 		}
 
-		BigInt GroupedAsset::GetBalance() const {
+		Amount GroupedAsset::GetBalance() const {
 			return _balance;
 		}
 
@@ -92,28 +92,23 @@ namespace Elastos {
 			info["DepositBalance"] = _balanceDeposit.getDec();
 			info["VotedBalance"] = _balanceVote.getDec();
 
-			UTXOArray utxo(_utxos.begin(), _utxos.end());
-			utxo.insert(utxo.end(), _utxosVote.begin(), _utxosVote.end());
-			utxo.insert(utxo.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
-			utxo.insert(utxo.end(), _utxosDeposit.begin(), _utxosDeposit.end());
-			utxo.insert(utxo.end(), _utxosLocked.begin(), _utxosLocked.end());
-
-			BigInt spendingAmount;
-			std::map<std::string, BigInt> addrAmount;
-			for (UTXOArray::iterator iter = utxo.begin(); iter != utxo.end(); ++iter) {
-				const OutputPtr &o = (*iter)->Output();
-				if (_parent->IsUTXOSpending(*iter))
-					spendingAmount += o->Amount();
+			Amount spendingAmount;
+			const std::vector<uint168> &addresses = _utxoTable.GetAddresses();
+			std::vector<Amount> addrAmount(addresses.size());
+			std::vector<bool> addrUsed(addresses.size(), false);
+			for (size_t row = 0; row < _utxoTable.Size(); ++row) {
+				if (_parent->IsUTXOSpending(_utxoTable.GetUTXO(row)))
+					spendingAmount += _utxoTable.GetAmount(row);
 
-				std::string addr = o->Addr()->String();
-				if (addrAmount.find(addr) == addrAmount.end())
-					addrAmount[addr] = o->Amount();
-				else
-					addrAmount[addr] += o->Amount();
+				uint32_t addr = _utxoTable.GetAddressIndex(row);
+				addrAmount[addr] += _utxoTable.GetAmount(row);
+				addrUsed[addr] = true;
 			}
 
-			for (std::map<std::string, BigInt>::iterator it = addrAmount.begin(); it != addrAmount.end(); ++it)
-				addrBalance[it->first] = it->second.getDec();
+			for (size_t i = 0; i < addresses.size(); ++i) {
+				if (addrUsed[i])
+					addrBalance[Address(addresses[i]).String()] = addrAmount[i].getDec();
+			}
 
 			info["SpendingBalance"] = spendingAmount.getDec();
 			info["Address"] = addrBalance;
@@ -123,11 +118,11 @@ namespace Elastos {
 
 		TransactionPtr GroupedAsset::CreateRetrieveDepositTx(uint8_t type,
 															 const PayloadPtr &payload,
-															 const BigInt &amount,
+															 const Amount &amount,
 															 const AddressPtr &fromAddress,
 															 const std::string &memo) {
 			uint64_t feeAmount;
-			BigInt totalInputAmount, totalOutputAmount;
+			Amount totalInputAmount, totalOutputAmount;
 			TransactionPtr tx = TransactionPtr(new Transaction(type, payload));
 
 			std::string nonce = std::to_string((std::rand() & 0xFFFFFFFF));
@@ -138,20 +133,22 @@ namespace Elastos {
 
 			_parent->Lock();
 
-			for (UTXOSet::iterator u = _utxosDeposit.begin(); u != _utxosDeposit.end(); ++u) {
-				if (_parent->IsUTXOSpending(*u))
+			std::vector<size_t> deposits = _utxoTable.Rows(UTXOTable::Deposit);
+			for (std::vector<size_t>::iterator r = deposits.begin(); r != deposits.end(); ++r) {
+				const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+				if (_parent->IsUTXOSpending(u))
 					continue;
 
-				if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+				if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 					continue;
 
-				if (*fromAddress == *(*u)->Output()->Addr()) {
-					totalInputAmount += (*u)->Output()->Amount();
+				if (*fromAddress == *u->Output()->Addr()) {
+					totalInputAmount += _utxoTable.GetAmount(*r);
 
-					tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+					tx->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
 					bytes_t code;
 					std::string path;
-					_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+					_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 					tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 				}
 			}
@@ -163,12 +160,12 @@ namespace Elastos {
 				ErrorChecker::ThrowLogicException(Error::DepositNotFound, "Deposit utxo not found");
 			}
 
-			totalOutputAmount = amount - feeAmount;
-			if (totalInputAmount < totalOutputAmount + feeAmount || totalOutputAmount <= 0) {
+			if (amount <= feeAmount || totalInputAmount < amount) {
 				ErrorChecker::ThrowLogicException(Error::BalanceNotEnough, "Available balance is not enough");
 			}
 
 			AddressPtr receiveAddress = _parent->_subAccount->UnusedAddresses(1, 0)[0];
+			totalOutputAmount = amount - feeAmount;
 			tx->AddOutput(OutputPtr(new TransactionOutput(totalOutputAmount, *receiveAddress)));
 
 			tx->SetFee(feeAmount);
@@ -181,11 +178,11 @@ namespace Elastos {
 			bytes_t code;
 			std::string path;
 			uint64_t txSize = 0, feeAmount = 0;
-			BigInt newVoteMaxAmount;
-			BigInt totalInputAmount;
+			Amount newVoteMaxAmount;
+			Amount totalInputAmount;
 			bool lastUTXOPending = false;
 			UTXOPtr firstInput;
-			BigInt totalOutputAmount;
+			Amount totalOutputAmount;
 			dropedVotes.clear();
 
 			ErrorChecker::CheckCondition(max && voteContent.GetType() == VoteContent::CRC, Error::InvalidArgument,
@@ -214,16 +211,18 @@ namespace Elastos {
 
 			totalOutputAmount = newVoteMaxAmount;
 			VoteContentArray oldVoteContent;
-			std::vector<BigInt> oldVoteAmount;
+			std::vector<Amount> oldVoteAmount;
 			_parent->Lock();
-			for (UTXOSet::const_iterator u = _utxosVote.cbegin(); u != _utxosVote.cend(); ++u) {
-				if ((*u)->GetConfirms(_parent->_blockHeight) < 2 || _parent->IsUTXOSpending(*u)) {
+			std::vector<size_t> votes = _utxoTable.Rows(UTXOTable::Vote);
+			for (std::vector<size_t>::const_iterator r = votes.cbegin(); r != votes.cend(); ++r) {
+				const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+				if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2 || _parent->IsUTXOSpending(u)) {
 					_parent->Unlock();
 					ErrorChecker::ThrowLogicException(Error::LastVoteConfirming, "Last vote tx is pending");
 					return nullptr;
 				}
 
-				PayloadVote *pv = dynamic_cast<PayloadVote *>((*u)->Output()->GetPayload().get());
+				PayloadVote *pv = dynamic_cast<PayloadVote *>(u->Output()->GetPayload().get());
 				if (pv == nullptr)
 					continue;
 
@@ -242,9 +241,9 @@ namespace Elastos {
 
 						oldVoteContent.push_back(vc);
 						if (vc.GetType() == VoteContent::CRC || vc.GetType() == VoteContent::CRCImpeachment) {
-							oldVoteAmount.push_back(BigInt(vc.GetTotalVoteAmount()));
+							oldVoteAmount.push_back(Amount(vc.GetTotalVoteAmount()));
 						} else if (vc.GetType() == VoteContent::Delegate || vc.GetType() == VoteContent::CRCProposal) {
-							oldVoteAmount.push_back(BigInt(vc.GetMaxVoteAmount()));
+							oldVoteAmount.push_back(Amount(vc.GetMaxVoteAmount()));
 						} else {
 							_parent->Unlock();
 							ErrorChecker::ThrowLogicException(Error::LastVoteConfirming, "Invalid vote content type");
@@ -265,8 +264,8 @@ namespace Elastos {
 
 						if (!picked && vc.GetType() == VoteContent::Delegate && vc.GetType() != voteContent.GetType()) {
 							oldVoteContent.push_back(vc);
-							oldVoteContent.back().SetAllCandidateVotes((*u)->Output()->Amount().getUint64());
-							oldVoteAmount.push_back((*u)->Output()->Amount());
+							oldVoteContent.back().SetAllCandidateVotes(_utxoTable.GetAmount(*r).getUint64());
+							oldVoteAmount.push_back(_utxoTable.GetAmount(*r));
 
 							if (oldVoteAmount.back() > totalOutputAmount)
 								totalOutputAmount = oldVoteAmount.back();
@@ -274,49 +273,45 @@ namespace Elastos {
 					}
 				}
 
-				totalInputAmount += (*u)->Output()->Amount();
+				totalInputAmount += _utxoTable.GetAmount(*r);
 
-				firstInput = *u;
-				tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-				_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+				firstInput = u;
+				tx->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+				_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 				tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 			}
 			feeAmount = CalculateFee(_parent->_feePerKb, tx->EstimateSize());
 
-			UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-			std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-				return a->Output()->Amount() > b->Output()->Amount();
-			});
-
-			utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
+			std::vector<size_t> utxo2Pick = RowsToPick();
 
-			for (UTXOArray::const_iterator u = utxo2Pick.cbegin(); u != utxo2Pick.cend(); ++u) {
+			for (std::vector<size_t>::const_iterator r = utxo2Pick.cbegin(); r != utxo2Pick.cend(); ++r) {
 				if (!max && totalInputAmount >= totalOutputAmount + feeAmount)
 					break;
 
-				if (_parent->IsUTXOSpending(*u)) {
+				const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+				if (_parent->IsUTXOSpending(u)) {
 					lastUTXOPending = true;
 					continue;
 				}
 
-				if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+				if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 					continue;
-				tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-				_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+				tx->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+				_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 				tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
 				txSize = tx->EstimateSize();
 
-				totalInputAmount += (*u)->Output()->Amount();
+				totalInputAmount += _utxoTable.GetAmount(*r);
 				feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 
 				if (firstInput == nullptr)
-					firstInput = *u;
+					firstInput = u;
 
 				if (txSize >= TX_MAX_SIZE - 1000) { // transaction size-in-bytes too large
 					_parent->Unlock();
 
-					BigInt maxAmount = totalInputAmount - feeAmount;
+					Amount maxAmount = totalInputAmount > feeAmount ? totalInputAmount - feeAmount : Amount(0);
 					ErrorChecker::CheckCondition(true, Error::CreateTransactionExceedSize,
 												 "Tx size too large, max available amount: " + maxAmount.getDec() +
 												 " sela");
@@ -326,16 +321,20 @@ namespace Elastos {
 
 			_parent->Unlock();
 
+			Amount availableAmount(0);
+			if (totalInputAmount > feeAmount)
+				availableAmount = totalInputAmount - feeAmount;
+
 			VoteContentArray newVoteContent;
 			newVoteContent.push_back(voteContent);
 			if (max) {
-				newVoteMaxAmount = totalInputAmount - feeAmount;
+				newVoteMaxAmount = availableAmount;
 				if (newVoteMaxAmount > totalOutputAmount)
 					totalOutputAmount = newVoteMaxAmount;
 				newVoteContent.back().SetAllCandidateVotes(newVoteMaxAmount.getUint64());
 			} else {
-				if (totalOutputAmount > totalInputAmount - feeAmount)
-					totalOutputAmount = totalInputAmount - feeAmount;
+				if (totalOutputAmount > availableAmount)
+					totalOutputAmount = availableAmount;
 			}
 
 			if (totalOutputAmount < newVoteMaxAmount) {
@@ -346,7 +345,7 @@ namespace Elastos {
 
 			assert(oldVoteAmount.size() == oldVoteContent.size());
 			for (size_t i = 0; i < oldVoteAmount.size(); ++i) {
-				if (oldVoteAmount[i] <= totalInputAmount - feeAmount) {
+				if (oldVoteAmount[i] <= availableAmount) {
 					newVoteContent.push_back(oldVoteContent[i]);
 				} else {
 					Log::warn("drop old vote content type: {} amount: {}", oldVoteContent[i].GetType(),
@@ -356,7 +355,7 @@ namespace Elastos {
 			}
 
 			if (totalInputAmount < feeAmount || totalInputAmount - feeAmount < totalOutputAmount) {
-				BigInt maxAvailable(0);
+				Amount maxAvailable(0);
 				if (totalInputAmount >= feeAmount)
 					maxAvailable = totalInputAmount - feeAmount;
 
@@ -381,7 +380,7 @@ namespace Elastos {
 			if (totalInputAmount > totalOutputAmount + feeAmount) {
 				// change
 				AddressPtr changeAddress = _parent->_subAccount->UnusedAddresses(1, 1)[0];
-				BigInt changeAmount = totalInputAmount - totalOutputAmount - feeAmount;
+				Amount changeAmount = totalInputAmount - totalOutputAmount - feeAmount;
 				OutputPtr changeOutput(new TransactionOutput(changeAmount, *changeAddress));
 				tx->AddOutput(changeOutput);
 			}
@@ -393,7 +392,7 @@ namespace Elastos {
 
 		TransactionPtr GroupedAsset::Consolidate(const std::string &memo) {
 			TransactionPtr tx = TransactionPtr(new Transaction());
-			BigInt totalInputAmount;
+			Amount totalInputAmount;
 			uint64_t feeAmount = 0, txSize = 0;
 			bool lastUTXOPending = false;
 
@@ -404,32 +403,28 @@ namespace Elastos {
 
 			_parent->Lock();
 
-			UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-			std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-				return a->Output()->Amount() > b->Output()->Amount();
-			});
+			std::vector<size_t> utxo2Pick = RowsToPick();
 
-			utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
-
-			for (UTXOArray::iterator u = utxo2Pick.begin(); u != utxo2Pick.end(); ++u) {
+			for (std::vector<size_t>::iterator r = utxo2Pick.begin(); r != utxo2Pick.end(); ++r) {
 				if (txSize >= TX_MAX_SIZE - 1000 || tx->GetInputs().size() >= 500)
 					break;
 
-				if (_parent->IsUTXOSpending(*u)) {
+				const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+				if (_parent->IsUTXOSpending(u)) {
 					lastUTXOPending = true;
 					continue;
 				}
 
-				if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+				if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 					continue;
 
-				tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+				tx->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
 				bytes_t code;
 				std::string path;
-				_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+				_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 				tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
-				totalInputAmount += (*u)->Output()->Amount();
+				totalInputAmount += _utxoTable.GetAmount(*r);
 
 				txSize = tx->EstimateSize();
 				if (_asset->GetName() == "ELA")
@@ -437,7 +432,8 @@ namespace Elastos {
 			}
 
 #if 0
-			for (UTXOArray::iterator u = _utxosVote.begin(); u != _utxosVote.end(); ++u) {
+			UTXOArray votes = GetVoteUTXO();
+			for (UTXOArray::iterator u = votes.begin(); u != votes.end(); ++u) {
 				if (txSize >= TX_MAX_SIZE - 1000)
 					break;
 
@@ -500,7 +496,7 @@ namespace Elastos {
 									 "Unsupport max for multi outputs");
 
 			TransactionPtr txn = TransactionPtr(new Transaction(type, payload));
-			BigInt totalOutputAmount(0), totalInputAmount(0);
+			Amount totalOutputAmount(0), totalInputAmount(0);
 			uint64_t txSize = 0, feeAmount = 0;
 			bytes_t code;
 			std::string path;
@@ -522,19 +518,21 @@ namespace Elastos {
 
 			if (pickVoteFirst && totalInputAmount < totalOutputAmount + feeAmount) {
 				// voted utxo
-				for (UTXOSet::iterator u = _utxosVote.begin(); u != _utxosVote.end(); ++u) {
-					if (_parent->IsUTXOSpending(*u)) {
+				std::vector<size_t> votes = _utxoTable.Rows(UTXOTable::Vote);
+				for (std::vector<size_t>::iterator r = votes.begin(); r != votes.end(); ++r) {
+					const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+					if (_parent->IsUTXOSpending(u)) {
 						lastUTXOPending = true;
 						continue;
 					}
 
-					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+					if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 						continue;
 
-					txn->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-					_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+					txn->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+					_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 					txn->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
-					totalInputAmount += (*u)->Output()->Amount();
+					totalInputAmount += _utxoTable.GetAmount(*r);
 
 					txSize = txn->EstimateSize();
 					if (_asset->GetName() == "ELA")
@@ -542,29 +540,26 @@ namespace Elastos {
 				}
 			}
 
-			UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-			std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-				return a->Output()->Amount() > b->Output()->Amount();
-			});
+			std::vector<size_t> utxo2Pick = RowsToPick();
 
-			utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
-
-			for (UTXOArray::iterator u = utxo2Pick.begin(); u != utxo2Pick.end(); ++u) {
+			for (std::vector<size_t>::iterator r = utxo2Pick.begin(); r != utxo2Pick.end(); ++r) {
 				if (!max && totalInputAmount >= totalOutputAmount + feeAmount && txSize >= 2000)
 					break;
 
-				if (_parent->IsUTXOSpending(*u)) {
+				const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+				if (_parent->IsUTXOSpending(u)) {
 					lastUTXOPending = true;
 					continue;
 				}
 
-				if (fromAddress->Valid() && *fromAddress != *(*u)->Output()->Addr())
+				if (fromAddress->Valid() &&
+					fromAddress->ProgramHash() != _utxoTable.GetAddresses()[_utxoTable.GetAddressIndex(*r)])
 					continue;
 
-				if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+				if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 					continue;
-				txn->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-				_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+				txn->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+				_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 				txn->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
 				txSize = txn->EstimateSize();
@@ -573,33 +568,35 @@ namespace Elastos {
 					if (!pickVoteFirst)
 						return CreateTxForOutputs(type, payload, outputs, fromAddress, memo, max, !pickVoteFirst);
 
-					BigInt maxAmount = totalInputAmount - feeAmount;
+					Amount maxAmount = totalInputAmount > feeAmount ? totalInputAmount - feeAmount : Amount(0);
 					ErrorChecker::CheckCondition(true, Error::CreateTransactionExceedSize,
 												 "Tx size too large, max available amount: " + maxAmount.getDec() +
 												 " sela");
 					return nullptr;
 				}
 
-				totalInputAmount += (*u)->Output()->Amount();
+				totalInputAmount += _utxoTable.GetAmount(*r);
 				if (_asset->GetName() == "ELA")
 					feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 			}
 
 			if (!pickVoteFirst && (max || totalInputAmount < totalOutputAmount + feeAmount)) {
 				// voted utxo
-				for (UTXOSet::iterator u = _utxosVote.begin(); u != _utxosVote.end(); ++u) {
-					if (_parent->IsUTXOSpending(*u)) {
+				std::vector<size_t> votes = _utxoTable.Rows(UTXOTable::Vote);
+				for (std::vector<size_t>::iterator r = votes.begin(); r != votes.end(); ++r) {
+					const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+					if (_parent->IsUTXOSpending(u)) {
 						lastUTXOPending = true;
 						continue;
 					}
 
-					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+					if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 						continue;
 
-					txn->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-					_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+					txn->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+					_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 					txn->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
-					totalInputAmount += (*u)->Output()->Amount();
+					totalInputAmount += _utxoTable.GetAmount(*r);
 
 					txSize = txn->EstimateSize();
 					if (_asset->GetName() == "ELA")
@@ -609,14 +606,15 @@ namespace Elastos {
 
 			_parent->Unlock();
 
-			if (max) {
+			if (max && totalInputAmount >= feeAmount) {
 				totalOutputAmount = totalInputAmount - feeAmount;
 				txn->GetOutputs().front()->SetAmount(totalOutputAmount);
+				txn->ResetHash();
 			}
 
 			if (txn) {
 				if (totalInputAmount < feeAmount || totalInputAmount - feeAmount < totalOutputAmount) {
-					BigInt maxAvailable(0);
+					Amount maxAvailable(0);
 					if (totalInputAmount >= feeAmount)
 						maxAvailable = totalInputAmount - feeAmount;
 
@@ -633,7 +631,7 @@ namespace Elastos {
 					uint256 assetID = txn->GetOutputs()[0]->AssetID();
 					AddressArray addresses = _parent->_subAccount->UnusedAddresses(1, 1);
 					ErrorChecker::CheckCondition(addresses.empty(), Error::GetUnusedAddress, "Get address failed");
-					BigInt changeAmount = totalInputAmount - totalOutputAmount - feeAmount;
+					Amount changeAmount = totalInputAmount - totalOutputAmount - feeAmount;
 					txn->AddOutput(OutputPtr(new TransactionOutput(changeAmount, *addresses[0], assetID)));
 				}
 				txn->SetFee(feeAmount);
@@ -644,7 +642,7 @@ namespace Elastos {
 
 		void GroupedAsset::AddFeeForTx(TransactionPtr &tx) {
 			uint64_t feeAmount = 0, txSize = 0;
-			BigInt totalInputAmount(0);
+			Amount totalInputAmount(0);
 			bool lastUTXOPending = false;
 			bytes_t code;
 			std::string path;
@@ -666,26 +664,25 @@ namespace Elastos {
 			txSize = tx->EstimateSize();
 			feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 
-			UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-			utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
+			std::vector<size_t> utxo2Pick = _utxoTable.Rows(UTXOTable::Normal);
+			std::vector<size_t> coinbase = _utxoTable.Rows(UTXOTable::Coinbase);
+			utxo2Pick.insert(utxo2Pick.end(), coinbase.begin(), coinbase.end());
+			_utxoTable.SortByAmount(utxo2Pick);
 
-			std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-				return a->Output()->Amount() > b->Output()->Amount();
-			});
-
-			for (UTXOArray::iterator u = utxo2Pick.begin(); u != utxo2Pick.end(); ++u) {
+			for (std::vector<size_t>::iterator r = utxo2Pick.begin(); r != utxo2Pick.end(); ++r) {
 				if (totalInputAmount >= feeAmount && txSize >= 2000)
 					break;
 
-				if (_parent->IsUTXOSpending(*u)) {
+				const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+				if (_parent->IsUTXOSpending(u)) {
 					lastUTXOPending = true;
 					continue;
 				}
 
-				if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+				if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 					continue;
-				tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-				_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+				tx->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+				_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 				tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
 				txSize = tx->EstimateSize();
@@ -699,26 +696,28 @@ namespace Elastos {
 					break;
 				}
 
-				totalInputAmount += (*u)->Output()->Amount();
+				totalInputAmount += _utxoTable.GetAmount(*r);
 				if (_asset->GetName() == "ELA")
 					feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 			}
 
 			if (totalInputAmount < feeAmount) {
-				for (UTXOSet::iterator u = _utxosVote.begin(); u != _utxosVote.end(); ++u) {
-					if (_parent->IsUTXOSpending(*u)) {
+				std::vector<size_t> votes = _utxoTable.Rows(UTXOTable::Vote);
+				for (std::vector<size_t>::iterator r = votes.begin(); r != votes.end(); ++r) {
+					const UTXOPtr &u = _utxoTable.GetUTXO(*r);
+					if (_parent->IsUTXOSpending(u)) {
 						lastUTXOPending = true;
 						continue;
 					}
 
-					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
+					if (_utxoTable.GetConfirms(*r, _parent->_blockHeight) < 2)
 						continue;
 
-					tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
-					_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path);
+					tx->AddInput(InputPtr(new TransactionInput(u->Hash(), u->Index())));
+					_parent->_subAccount->GetCodeAndPath(u->Output()->Addr(), code, path);
 					tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
-					totalInputAmount += (*u)->Output()->Amount();
+					totalInputAmount += _utxoTable.GetAmount(*r);
 					txSize = tx->EstimateSize();
 					if (_asset->GetName() == "ELA")
 						feeAmount = CalculateFee(_parent->_feePerKb, txSize);
@@ -740,7 +739,7 @@ namespace Elastos {
 				uint256 assetID = Asset::GetELAAssetID();
 				AddressArray addresses = _parent->_subAccount->UnusedAddresses(1, 1);
 				ErrorChecker::CheckCondition(addresses.empty(), Error::GetUnusedAddress, "Get address failed");
-				BigInt changeAmount = totalInputAmount - feeAmount;
+				Amount changeAmount = totalInputAmount - feeAmount;
 				tx->AddOutput(OutputPtr(new TransactionOutput(changeAmount, *addresses[0], assetID)));
 			}
 
@@ -754,7 +753,7 @@ namespace Elastos {
 		bool GroupedAsset::AddUTXO(const UTXOPtr &o) {
 			if (_parent->_subAccount->IsProducerDepositAddress(o->Output()->Addr()) ||
 				_parent->_subAccount->IsCRDepositAddress(o->Output()->Addr())) {
-				if (!_utxosDeposit.insert(o).second)
+				if (!_utxoTable.Insert(o, UTXOTable::Deposit))
 					return false;
 
 				_balanceDeposit += o->Output()->Amount();
@@ -763,7 +762,7 @@ namespace Elastos {
 							 o->Output()->Amount().getDec(), _balanceDeposit.getDec());
 			} else {
 				if (o->Output()->GetType() == TransactionOutput::Type::VoteOutput) {
-					if (!_utxosVote.insert(o).second)
+					if (!_utxoTable.Insert(o, UTXOTable::Vote))
 						return false;
 
 					_balanceVote += o->Output()->Amount();
@@ -772,13 +771,13 @@ namespace Elastos {
 								 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
 								 o->Output()->Amount().getDec(), _balanceVote.getDec(), _balance.getDec());
 				} else {
-					if (!_utxos.insert(o).second)
+					if (!_utxoTable.Insert(o, UTXOTable::Normal))
 						return false;
 
 					_balance += o->Output()->Amount();
 					SPVLOG_DEBUG("{} +++ utxo {}:{}:{}:{} -> balance {}, size: {}", _parent->_walletID,
 								 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
-								 o->Output()->Amount().getDec(), _balance.getDec(), _utxos.size());
+								 o->Output()->Amount().getDec(), _balance.getDec(), _utxoTable.Size());
 				}
 			}
 
@@ -789,16 +788,21 @@ namespace Elastos {
 			if (o->Spent())
 				return false;
 
+			size_t row = _utxoTable.Find(o->Hash(), o->Index());
+			if (row != UTXOTable::npos) {
+				// the wallet moves coinbase utxos to a new height in place, keep the copy in the table current
+				_utxoTable.SetHeight(row, o->BlockHeight());
+				return false;
+			}
+
 			if (o->GetConfirms(_parent->_blockHeight) <= 100) {
-				if (!_utxosLocked.insert(o).second)
-					return false;
+				_utxoTable.Insert(o, UTXOTable::Locked);
 				_balanceLocked += o->Output()->Amount();
 				SPVLOG_DEBUG("{} +++ coinbase locked utxo {}:{}:{}:{} -> locked {}", _parent->_walletID,
 							 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
 							 o->Output()->Amount().getDec(), _balanceLocked.getDec());
 			} else {
-				if (!_utxosCoinbase.insert(o).second)
-					return false;
+				_utxoTable.Insert(o, UTXOTable::Coinbase);
 				_balance += o->Output()->Amount();
 				SPVLOG_DEBUG("{} +++ coinbase utxo {}:{}:{}:{} -> balance {}", _parent->_walletID, o->Hash().GetHex(),
 							 o->Index(), o->Output()->Addr()->String(), o->Output()->Amount().getDec(),
@@ -812,7 +816,7 @@ namespace Elastos {
 			bool removed = false;
 
 			for (InputArray::const_iterator in = inputs.cbegin(); in != inputs.cend(); ++in) {
-				if (RemoveSpentUTXO(UTXOPtr(new UTXO(*in)), spentCoinbase))
+				if (RemoveSpentUTXO((*in)->TxHash(), (*in)->Index(), spentCoinbase))
 					removed = true;
 			}
 
@@ -820,71 +824,70 @@ namespace Elastos {
 		}
 
 		bool GroupedAsset::RemoveSpentUTXO(const UTXOPtr &u, UTXOArray &spentCoinbase) {
-			UTXOSet::iterator it;
-
-			if ((it = _utxosCoinbase.find(u)) != _utxosCoinbase.end()) {
-				spentCoinbase.push_back(*it);
-				(*it)->SetSpent(true);
-				_balance -= (*it)->Output()->Amount();
-				SPVLOG_DEBUG("{} --- coinbase utxo {}:{}:{}:{} -> balance {}", _parent->_walletID,
-							 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Addr()->String(),
-							 (*it)->Output()->Amount().getDec(), _balance.getDec());
-				_utxosCoinbase.erase(it);
-				return true;
-			}
-
-			if ((it = _utxosVote.find(u)) != _utxosVote.end()) {
-				_balanceVote -= (*it)->Output()->Amount();
-				_balance -= (*it)->Output()->Amount();
-				SPVLOG_DEBUG("{} --- vote utxo {}:{}:{}:{} -> vote balance {} balance {}", _parent->_walletID,
-							 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Addr()->String(),
-							 (*it)->Output()->Amount().getDec(), _balanceVote.getDec(), _balance.getDec());
-				_utxosVote.erase(it);
-				return true;
-			}
-
-			if ((it = _utxos.find(u)) != _utxos.end()) {
-				_balance -= (*it)->Output()->Amount();
-				SPVLOG_DEBUG("{} --- utxo {}:{}:{}:{} -> balance {}", _parent->_walletID, (*it)->Hash().GetHex(),
-							 (*it)->Index(), (*it)->Output()->Addr()->String(), (*it)->Output()->Amount().getDec(),
-							 _balance.getDec());
-				_utxos.erase(it);
-				return true;
-			}
+			return RemoveSpentUTXO(u->Hash(), u->Index(), spentCoinbase);
+		}
 
-			if ((it = _utxosDeposit.find(u)) != _utxosDeposit.end()) {
-				_balanceDeposit -= (*it)->Output()->Amount();
-				SPVLOG_DEBUG("{} --- deposit utxo {}:{}:{}:{} -> deposit balance {}", _parent->_walletID,
-							 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Addr()->String(),
-							 (*it)->Output()->Amount().getDec(), _balanceDeposit.getDec());
-				_utxosDeposit.erase(it);
-				return true;
-			}
+		bool GroupedAsset::RemoveSpentUTXO(const uint256 &hash, uint16_t index, UTXOArray &spentCoinbase) {
+			size_t row = _utxoTable.Find(hash, index);
+			if (row == UTXOTable::npos)
+				return false;
+
+			const UTXOPtr &u = _utxoTable.GetUTXO(row);
+			const Amount &amount = _utxoTable.GetAmount(row);
+			switch (_utxoTable.GetKind(row)) {
+				case UTXOTable::Coinbase:
+					spentCoinbase.push_back(u);
+					u->SetSpent(true);
+					_balance -= amount;
+					SPVLOG_DEBUG("{} --- coinbase utxo {}:{}:{}:{} -> balance {}", _parent->_walletID,
+								 u->Hash().GetHex(), u->Index(), u->Output()->Addr()->String(),
+								 amount.getDec(), _balance.getDec());
+					break;
 
-			if ((it = _utxosLocked.find(u)) != _utxosLocked.end()) {
-				_balanceLocked -= (*it)->Output()->Amount();
-				_utxosLocked.erase(it);
-				return true;
+				case UTXOTable::Vote:
+					_balanceVote -= amount;
+					_balance -= amount;
+					SPVLOG_DEBUG("{} --- vote utxo {}:{}:{}:{} -> vote balance {} balance {}", _parent->_walletID,
+								 u->Hash().GetHex(), u->Index(), u->Output()->Addr()->String(),
+								 amount.getDec(), _balanceVote.getDec(), _balance.getDec());
+					break;
+
+				case UTXOTable::Normal:
+					_balance -= amount;
+					SPVLOG_DEBUG("{} --- utxo {}:{}:{}:{} -> balance {}", _parent->_walletID, u->Hash().GetHex(),
+								 u->Index(), u->Output()->Addr()->String(), amount.getDec(), _balance.getDec());
+					break;
+
+				case UTXOTable::Deposit:
+					_balanceDeposit -= amount;
+					SPVLOG_DEBUG("{} --- deposit utxo {}:{}:{}:{} -> deposit balance {}", _parent->_walletID,
+								 u->Hash().GetHex(), u->Index(), u->Output()->Addr()->String(),
+								 amount.getDec(), _balanceDeposit.getDec());
+					break;
+
+				case UTXOTable::Locked:
+					_balanceLocked -= amount;
+					break;
 			}
 
-			return false;
+			_utxoTable.Remove(row);
+			return true;
 		}
 
 		bool GroupedAsset::UpdateLockedBalance() {
 			bool changed = false;
 
-			for (UTXOSet::iterator it = _utxosLocked.begin(); it != _utxosLocked.end();) {
-				if ((*it)->GetConfirms(_parent->_blockHeight) > 100) {
-					_balanceLocked -= (*it)->Output()->Amount();
-					_balance += (*it)->Output()->Amount();
-					_utxosCoinbase.insert(*it);
+			for (size_t row = 0; row < _utxoTable.Size(); ++row) {
+				if (_utxoTable.GetKind(row) == UTXOTable::Locked &&
+					_utxoTable.GetConfirms(row, _parent->_blockHeight) > 100) {
+					const Amount &amount = _utxoTable.GetAmount(row);
+					_balanceLocked -= amount;
+					_balance += amount;
+					_utxoTable.SetKind(row, UTXOTable::Coinbase);
 					SPVLOG_DEBUG("{} move locked utxo {}:{}:{} -> locked balance {} balance {}", _parent->_walletID,
-								 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Amount().getDec(),
-								 _balanceLocked.getDec(), _balance.getDec());
-					it = _utxosLocked.erase(it);
+								 _utxoTable.GetOutpoint(row).hash.GetHex(), _utxoTable.GetOutpoint(row).index,
+								 amount.getDec(), _balanceLocked.getDec(), _balance.getDec());
 					changed = true;
-				} else {
-					++it;
 				}
 			}
 
@@ -892,17 +895,30 @@ namespace Elastos {
 		}
 
 		bool GroupedAsset::ContainUTXO(const UTXOPtr &o) const {
-			return _utxosVote.find(o) != _utxosVote.end() ||
-				   _utxos.find(o) != _utxos.end() ||
-				   _utxosCoinbase.find(o) != _utxosCoinbase.end() ||
-				   _utxosDeposit.find(o) != _utxosDeposit.end() ||
-				   _utxosLocked.find(o) != _utxosLocked.end();
+			return _utxoTable.Contains(o->Hash(), o->Index());
 		}
 
 		uint64_t GroupedAsset::CalculateFee(uint64_t feePerKB, size_t size) const {
 			return (size + 999) / 1000 * feePerKB;
 		}
 
+		std::vector<size_t> GroupedAsset::RowsToPick() const {
+			std::vector<size_t> rows = _utxoTable.Rows(UTXOTable::Normal);
+			_utxoTable.SortByAmount(rows);
+
+			std::vector<size_t> coinbase = _utxoTable.Rows(UTXOTable::Coinbase);
+			rows.insert(rows.end(), coinbase.begin(), coinbase.end());
+			return rows;
+		}
+
+		UTXOArray GroupedAsset::RowsToUTXOs(const std::vector<size_t> &rows) const {
+			UTXOArray result;
+			result.reserve(rows.size());
+			for (size_t i = 0; i < rows.size(); ++i)
+				result.push_back(_utxoTable.GetUTXO(rows[i]));
+			return result;
+		}
+
 	}
 }
 
@@ -6,11 +6,12 @@
 #define __ELASTOS_SDK__GROUPEDASSET_H__
 
 #include "UTXO.h"
+#include "UTXOTable.h"
 
 #include <Common/ElementSet.h>
 #include <Common/Lockable.h>
 #include <Account/SubAccount.h>
-#include <Common/BigInt.h>
+#include <Common/Amount.h>
 #include <Plugin/Transaction/Payload/IPayload.h>
 
 #include <map>
@@ -42,15 +43,15 @@ namespace Elastos {
 
 			UTXOArray GetUTXOs(const std::string &addr) const;
 
-			const UTXOSet &GetVoteUTXO() const;
+			UTXOArray GetVoteUTXO() const;
 
-			const UTXOSet &GetCoinBaseUTXOs() const;
+			UTXOArray GetCoinBaseUTXOs() const;
 
-			BigInt GetBalance() const;
+			Amount GetBalance() const;
 
 			nlohmann::json GetBalanceInfo();
 
-			TransactionPtr CreateRetrieveDepositTx(uint8_t type, const PayloadPtr &payload, const BigInt &amount,
+			TransactionPtr CreateRetrieveDepositTx(uint8_t type, const PayloadPtr &payload, const Amount &amount,
 												   const AddressPtr &fromAddress, const std::string &memo);
 
 			TransactionPtr Vote(const VoteContent &voteContent, const std::string &memo, bool max,
@@ -78,6 +79,8 @@ namespace Elastos {
 
 			bool RemoveSpentUTXO(const UTXOPtr &u, UTXOArray &spentCoinbase);
 
+			bool RemoveSpentUTXO(const uint256 &hash, uint16_t index, UTXOArray &spentCoinbase);
+
 			bool UpdateLockedBalance();
 
 			bool ContainUTXO(const UTXOPtr &o) const;
@@ -85,9 +88,14 @@ namespace Elastos {
 		private:
 			uint64_t CalculateFee(uint64_t feePerKB, size_t size) const;
 
+			// normal utxos, largest first, then coinbase utxos
+			std::vector<size_t> RowsToPick() const;
+
+			UTXOArray RowsToUTXOs(const std::vector<size_t> &rows) const;
+
 		private:
-			BigInt _balance, _balanceVote, _balanceDeposit, _balanceLocked;
-			UTXOSet _utxos, _utxosVote, _utxosCoinbase, _utxosDeposit, _utxosLocked;
+			Amount _balance, _balanceVote, _balanceDeposit, _balanceLocked;
+			UTXOTable _utxoTable;
 
 			AssetPtr _asset;
 
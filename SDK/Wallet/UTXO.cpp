@@ -7,7 +7,7 @@
 #include <Plugin/Transaction/TransactionInput.h>
 #include <Plugin/Transaction/TransactionOutput.h>
 #include <Common/ErrorChecker.h>
-#include <Common/BigInt.h>
+#include <Common/Amount.h>
 
 #include <boost/bind.hpp>
 
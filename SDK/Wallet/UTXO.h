@@ -13,7 +13,6 @@ namespace Elastos {
 	namespace ElaWallet {
 
 		class TransactionInput;
-		class BigInt;
 		typedef boost::shared_ptr<TransactionInput> InputPtr;
 
 		class UTXO {
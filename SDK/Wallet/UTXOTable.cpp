@@ -0,0 +1,118 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "UTXOTable.h"
+
+#include <Plugin/Transaction/TransactionOutput.h>
+#include <WalletCore/Address.h>
+
+#include <algorithm>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+#define TX_UNCONFIRMED INT32_MAX
+
+		const size_t UTXOTable::npos;
+
+		bool UTXOTable::Insert(const UTXOPtr &u, Kind kind) {
+			const OutputPtr &o = u->Output();
+			return Insert(u->Hash(), u->Index(), o->Amount(), u->BlockHeight(), o->Addr()->ProgramHash(), kind, u);
+		}
+
+		bool UTXOTable::Insert(const uint256 &hash, uint16_t index, const Amount &amount, uint32_t height,
+							   const uint168 &programHash, Kind kind, const UTXOPtr &u) {
+			if (!_rowOf.insert(std::make_pair(Outpoint(hash, index), _kinds.size())).second)
+				return false;
+
+			_outpoints.push_back(Outpoint(hash, index));
+			_amounts.push_back(amount);
+			_heights.push_back(height);
+			_addresses.push_back(AddressIndex(programHash));
+			_kinds.push_back((uint8_t) kind);
+			_utxos.push_back(u);
+			return true;
+		}
+
+		void UTXOTable::Remove(size_t row) {
+			size_t last = _kinds.size() - 1;
+
+			_rowOf.erase(_outpoints[row]);
+			if (row != last) {
+				_outpoints[row] = _outpoints[last];
+				_amounts[row] = _amounts[last];
+				_heights[row] = _heights[last];
+				_addresses[row] = _addresses[last];
+				_kinds[row] = _kinds[last];
+				_utxos[row] = _utxos[last];
+				_rowOf[_outpoints[row]] = row;
+			}
+
+			_outpoints.pop_back();
+			_amounts.pop_back();
+			_heights.pop_back();
+			_addresses.pop_back();
+			_kinds.pop_back();
+			_utxos.pop_back();
+		}
+
+		size_t UTXOTable::Find(const uint256 &hash, uint16_t index) const {
+			FlatHashMap<Outpoint, size_t, OutpointHash>::const_iterator it = _rowOf.find(Outpoint(hash, index));
+			return it == _rowOf.end() ? npos : it->second;
+		}
+
+		void UTXOTable::Clear() {
+			_outpoints.clear();
+			_amounts.clear();
+			_heights.clear();
+			_addresses.clear();
+			_kinds.clear();
+			_utxos.clear();
+			_rowOf.clear();
+			_programHashes.clear();
+			_addressOf.clear();
+		}
+
+		uint32_t UTXOTable::GetConfirms(size_t row, uint32_t lastBlockHeight) const {
+			uint32_t height = _heights[row];
+			if (height == TX_UNCONFIRMED)
+				return 0;
+
+			return lastBlockHeight >= height ? lastBlockHeight - height + 1 : 0;
+		}
+
+		size_t UTXOTable::FindAddress(const uint168 &programHash) const {
+			FlatHashMap<uint168, uint32_t>::const_iterator it = _addressOf.find(programHash);
+			return it == _addressOf.end() ? npos : it->second;
+		}
+
+		std::vector<size_t> UTXOTable::Rows(Kind kind) const {
+			std::vector<size_t> rows;
+			for (size_t i = 0; i < _kinds.size(); ++i) {
+				if (_kinds[i] == kind)
+					rows.push_back(i);
+			}
+
+			std::sort(rows.begin(), rows.end(), [this](size_t a, size_t b) {
+				return _outpoints[a] < _outpoints[b];
+			});
+			return rows;
+		}
+
+		void UTXOTable::SortByAmount(std::vector<size_t> &rows) const {
+			std::stable_sort(rows.begin(), rows.end(), [this](size_t a, size_t b) {
+				return _amounts[a] > _amounts[b];
+			});
+		}
+
+		uint32_t UTXOTable::AddressIndex(const uint168 &programHash) {
+			std::pair<FlatHashMap<uint168, uint32_t>::iterator, bool> r;
+			r = _addressOf.insert(std::make_pair(programHash, (uint32_t) _programHashes.size()));
+			if (r.second)
+				_programHashes.push_back(programHash);
+			return r.first->second;
+		}
+
+	}
+}
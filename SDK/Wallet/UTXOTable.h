@@ -0,0 +1,124 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_UTXOTABLE_H__
+#define __ELASTOS_SDK_UTXOTABLE_H__
+
+#include "UTXO.h"
+
+#include <Common/Amount.h>
+#include <Common/FlatHashMap.h>
+#include <Common/uint256.h>
+
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * UTXOs of one asset kept column by column: outpoint, amount, height, address and kind each
+		 * sit in their own array, so balance scans and coin selection walk dense memory instead of
+		 * chasing UTXO and output pointers. The UTXO object itself is only kept for callers that
+		 * need the full output, e.g. to sign with its address. Lookups by outpoint and by address
+		 * go through side indexes. Removing a row moves the last row into its place, so row
+		 * numbers are only stable until the next Remove.
+		 */
+		class UTXOTable {
+		public:
+			enum Kind {
+				Normal,
+				Vote,
+				Coinbase,
+				Deposit,
+				Locked
+			};
+
+			struct Outpoint {
+				Outpoint() : index(0) {}
+
+				Outpoint(const uint256 &h, uint16_t n) : hash(h), index(n) {}
+
+				bool operator==(const Outpoint &o) const { return index == o.index && hash == o.hash; }
+
+				bool operator<(const Outpoint &o) const { return hash == o.hash ? index < o.index : hash < o.hash; }
+
+				uint256 hash;
+				uint16_t index;
+			};
+
+			struct OutpointHash {
+				size_t operator()(const Outpoint &o) const { return std::hash<uint256>()(o.hash) ^ o.index; }
+			};
+
+			static const size_t npos = (size_t) -1;
+
+		public:
+			// Returns false and leaves the table as is when the outpoint is already in it.
+			bool Insert(const UTXOPtr &u, Kind kind);
+
+			bool Insert(const uint256 &hash, uint16_t index, const Amount &amount, uint32_t height,
+						const uint168 &programHash, Kind kind, const UTXOPtr &u);
+
+			void Remove(size_t row);
+
+			size_t Find(const uint256 &hash, uint16_t index) const;
+
+			bool Contains(const uint256 &hash, uint16_t index) const { return Find(hash, index) != npos; }
+
+			size_t Size() const { return _kinds.size(); }
+
+			void Clear();
+
+			const Outpoint &GetOutpoint(size_t row) const { return _outpoints[row]; }
+
+			const Amount &GetAmount(size_t row) const { return _amounts[row]; }
+
+			uint32_t GetHeight(size_t row) const { return _heights[row]; }
+
+			void SetHeight(size_t row, uint32_t height) { _heights[row] = height; }
+
+			// Same as UTXO::GetConfirms.
+			uint32_t GetConfirms(size_t row, uint32_t lastBlockHeight) const;
+
+			Kind GetKind(size_t row) const { return (Kind) _kinds[row]; }
+
+			void SetKind(size_t row, Kind kind) { _kinds[row] = (uint8_t) kind; }
+
+			const UTXOPtr &GetUTXO(size_t row) const { return _utxos[row]; }
+
+			uint32_t GetAddressIndex(size_t row) const { return _addresses[row]; }
+
+			// Every program hash seen so far, an address index points into this list.
+			const std::vector<uint168> &GetAddresses() const { return _programHashes; }
+
+			// Index of programHash, npos if no UTXO ever paid to it.
+			size_t FindAddress(const uint168 &programHash) const;
+
+			// Rows of one kind in outpoint order, the order the old ordered sets iterated in.
+			std::vector<size_t> Rows(Kind kind) const;
+
+			// Largest amount first, rows with equal amounts keep their order.
+			void SortByAmount(std::vector<size_t> &rows) const;
+
+		private:
+			uint32_t AddressIndex(const uint168 &programHash);
+
+		private:
+			std::vector<Outpoint> _outpoints;
+			std::vector<Amount> _amounts;
+			std::vector<uint32_t> _heights;
+			std::vector<uint32_t> _addresses;
+			std::vector<uint8_t> _kinds;
+			std::vector<UTXOPtr> _utxos;
+
+			FlatHashMap<Outpoint, size_t, OutpointHash> _rowOf;
+
+			std::vector<uint168> _programHashes;
+			FlatHashMap<uint168, uint32_t> _addressOf;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_UTXOTABLE_H__
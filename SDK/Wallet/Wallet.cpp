@@ -141,7 +141,7 @@ namespace Elastos {
 
 			std::for_each(_groupedAssets.begin(), _groupedAssets.end(),
 						  [&result](GroupedAssetMap::reference &asset) {
-							  const UTXOSet &utxos = asset.second->GetVoteUTXO();
+							  UTXOArray utxos = asset.second->GetVoteUTXO();
 							  result.insert(result.end(), utxos.begin(), utxos.end());
 						  });
 
@@ -163,10 +163,10 @@ namespace Elastos {
 			return info;
 		}
 
-		BigInt Wallet::GetBalanceWithAddress(const uint256 &assetID, const std::string &addr) const {
+		Amount Wallet::GetBalanceWithAddress(const uint256 &assetID, const std::string &addr) const {
 			boost::mutex::scoped_lock scopedLock(lock);
 
-			BigInt balance = 0;
+			Amount balance = 0;
 			std::vector<UTXOPtr> utxos = GetUTXO(assetID, addr);
 
 			for (size_t i = 0; i < utxos.size(); ++i) {
@@ -176,7 +176,7 @@ namespace Elastos {
 			return balance;
 		}
 
-		BigInt Wallet::GetBalance(const uint256 &assetID) const {
+		Amount Wallet::GetBalance(const uint256 &assetID) const {
 			ErrorChecker::CheckParam(!ContainsAsset(assetID), Error::InvalidAsset, "asset not found");
 
 			boost::mutex::scoped_lock scoped_lock(lock);
@@ -215,7 +215,7 @@ namespace Elastos {
 			return tx;
 		}
 
-		TransactionPtr Wallet::CreateRetrieveTransaction(uint8_t type, const PayloadPtr &payload, const BigInt &amount,
+		TransactionPtr Wallet::CreateRetrieveTransaction(uint8_t type, const PayloadPtr &payload, const Amount &amount,
 														 const AddressPtr &fromAddress, const std::string &memo) {
 			std::string memoFixed;
 
@@ -238,9 +238,6 @@ namespace Elastos {
 			for (const OutputPtr &output : outputs) {
 				ErrorChecker::CheckParam(!output->Addr()->Valid(), Error::CreateTransaction,
 										 "invalid receiver address");
-
-				ErrorChecker::CheckParam(output->Amount() < 0, Error::CreateTransaction,
-										 "output amount should big than zero");
 			}
 
 			std::string memoFixed;
@@ -280,7 +277,7 @@ namespace Elastos {
 		bool Wallet::RegisterTransaction(const TransactionPtr &tx) {
 			bool r = true, wasAdded = false;
 			UTXOPtr cb = nullptr;
-			std::map<uint256, BigInt> changedBalance;
+			std::map<uint256, Amount> changedBalance;
 			UTXOArray spentUTXO;
 
 			bool IsReceiveTx = IsReceiveTransaction(tx);
@@ -319,7 +316,7 @@ namespace Elastos {
 				coinBaseTxAdded(cb);
 			}
 
-			for (std::map<uint256, BigInt>::iterator it = changedBalance.begin(); it != changedBalance.end(); ++it)
+			for (std::map<uint256, Amount>::iterator it = changedBalance.begin(); it != changedBalance.end(); ++it)
 				balanceChanged(it->first, it->second);
 
 			return r;
@@ -389,8 +386,8 @@ namespace Elastos {
 		void Wallet::UpdateTransactions(const std::vector<uint256> &txHashes, uint32_t blockHeight, time_t timestamp) {
 			std::vector<uint256> hashes, cbHashes;
 			UTXOArray spentCoinBase;
-			std::map<uint256, BigInt> changedBalance;
-			std::vector<RegisterAsset *> payloads;
+			std::map<uint256, Amount> changedBalance;
+			std::vector<const RegisterAsset *> payloads;
 			UTXOPtr cb;
 			size_t i;
 
@@ -408,7 +405,7 @@ namespace Elastos {
 					if (tx->GetBlockHeight() == TX_UNCONFIRMED && blockHeight != TX_UNCONFIRMED) {
 						needUpdate = true;
 						if (tx->GetTransactionType() == Transaction::registerAsset) {
-							RegisterAsset *p = dynamic_cast<RegisterAsset *>(tx->GetPayload());
+							const RegisterAsset *p = dynamic_cast<const RegisterAsset *>(tx->GetPayload());
 							if (p) payloads.push_back(p);
 						}
 					}
@@ -467,7 +464,7 @@ namespace Elastos {
 					assetRegistered(payloads[i]->GetAsset(), payloads[i]->GetAmount(), payloads[i]->GetController());
 			}
 
-			for (std::map<uint256, BigInt>::iterator it = changedBalance.begin(); it != changedBalance.end(); ++it)
+			for (std::map<uint256, Amount>::iterator it = changedBalance.begin(); it != changedBalance.end(); ++it)
 				balanceChanged(it->first, it->second);
 		}
 
@@ -476,6 +473,24 @@ namespace Elastos {
 			return _allTx.Get(txHash);
 		}
 
+		std::vector<TransactionPtr> Wallet::TransactionsSpending(const uint256 &txHash, uint32_t blockHeight) const {
+			std::vector<TransactionPtr> spenders;
+
+			boost::mutex::scoped_lock scopedLock(lock);
+			for (size_t i = _transactions.size(); i > 0; i--) { // sorted by height, so only the tail is searched
+				const TransactionPtr &t = _transactions[i - 1];
+				if (t->GetBlockHeight() < blockHeight) break;
+
+				for (size_t j = 0; j < t->GetInputs().size(); j++) {
+					if (t->GetInputs()[j]->TxHash() != txHash) continue;
+					spenders.push_back(t);
+					break;
+				}
+			}
+
+			return spenders;
+		}
+
 		size_t Wallet::GetAllTransactionCount() const {
 			boost::mutex::scoped_lock scopedLock(lock);
 			return _transactions.size();
@@ -580,14 +595,14 @@ namespace Elastos {
 		}
 #endif
 
-		BigInt Wallet::AmountSentByTx(const TransactionPtr &tx) {
-			BigInt amount(0);
+		Amount Wallet::AmountSentByTx(const TransactionPtr &tx) {
+			Amount amount(0);
 
 			boost::mutex::scoped_lock scopedLock(lock);
 			if (!tx)
 				return amount;
 
-			for (InputArray::iterator in = tx->GetInputs().begin(); in != tx->GetInputs().end(); ++in) {
+			for (InputArray::const_iterator in = tx->GetInputs().begin(); in != tx->GetInputs().end(); ++in) {
 				TransactionPtr t = _allTx.Get((*in)->TxHash());
 				UTXOPtr cb = nullptr;
 				if (t) {
@@ -607,7 +622,7 @@ namespace Elastos {
 		bool Wallet::IsReceiveTransaction(const TransactionPtr &tx) const {
 			boost::mutex::scoped_lock scopedLock(lock);
 			bool status = true;
-			for (InputArray::iterator in = tx->GetInputs().begin(); in != tx->GetInputs().end(); ++in) {
+			for (InputArray::const_iterator in = tx->GetInputs().begin(); in != tx->GetInputs().end(); ++in) {
 				if (ContainsInput(*in)) {
 					status = false;
 					break;
@@ -737,6 +752,11 @@ namespace Elastos {
 			_subAccount->SignTransaction(tx, payPassword);
 		}
 
+		void Wallet::SignTransactions(const std::vector<TransactionPtr> &txs, const std::string &payPassword) const {
+			boost::mutex::scoped_lock scopedLock(lock);
+			_subAccount->SignTransactions(txs, payPassword);
+		}
+
 		std::string
 		Wallet::SignWithDID(const AddressPtr &did, const std::string &msg, const std::string &payPasswd) const {
 			boost::mutex::scoped_lock scopedLock(lock);
@@ -1050,9 +1070,9 @@ namespace Elastos {
 			return true;
 		}
 
-		std::map<uint256, BigInt> Wallet::BalanceAfterUpdatedTx(const TransactionPtr &tx, UTXOArray &spentCoinbase) {
+		std::map<uint256, Amount> Wallet::BalanceAfterUpdatedTx(const TransactionPtr &tx, UTXOArray &spentCoinbase) {
 			GroupedAssetMap::iterator it;
-			std::map<uint256, BigInt> changedBalance;
+			std::map<uint256, Amount> changedBalance;
 			if (tx->GetBlockHeight() != TX_UNCONFIRMED) {
 				for (it = _groupedAssets.begin(); it != _groupedAssets.end(); ++it) {
 					if (it->second->RemoveSpentUTXO(tx->GetInputs(), spentCoinbase)) {
@@ -1101,7 +1121,7 @@ namespace Elastos {
 		}
 
 		void Wallet::UpdateLockedBalance() {
-			std::map<uint256, BigInt> changedBalance;
+			std::map<uint256, Amount> changedBalance;
 
 			lock.lock();
 			for (GroupedAssetMap::iterator it = _groupedAssets.begin(); it != _groupedAssets.end(); ++it) {
@@ -1111,7 +1131,7 @@ namespace Elastos {
 			}
 			lock.unlock();
 
-			for (std::map<uint256, BigInt>::iterator it = changedBalance.begin(); it != changedBalance.end(); ++it)
+			for (std::map<uint256, Amount>::iterator it = changedBalance.begin(); it != changedBalance.end(); ++it)
 				balanceChanged(it->first, it->second);
 		}
 
@@ -1139,7 +1159,7 @@ namespace Elastos {
 			return false;
 		}
 
-		void Wallet::balanceChanged(const uint256 &asset, const BigInt &balance) {
+		void Wallet::balanceChanged(const uint256 &asset, const Amount &balance) {
 			if (!_listener.expired()) {
 				_listener.lock()->balanceChanged(asset, balance);
 			}
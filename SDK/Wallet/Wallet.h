@@ -53,7 +53,7 @@ namespace Elastos {
 		public:
 			class Listener {
 			public:
-				virtual void balanceChanged(const uint256 &asset, const BigInt &balance) = 0;
+				virtual void balanceChanged(const uint256 &asset, const Amount &balance) = 0;
 
 				virtual void onCoinBaseTxAdded(const UTXOPtr &utxo) = 0;
 
@@ -102,7 +102,7 @@ namespace Elastos {
 
 			nlohmann::json GetBalanceInfo();
 
-			BigInt GetBalanceWithAddress(const uint256 &assetID, const std::string &addr) const;
+			Amount GetBalanceWithAddress(const uint256 &assetID, const std::string &addr) const;
 
 			// returns the first unused external address
 			AddressPtr GetReceiveAddress() const;
@@ -128,7 +128,7 @@ namespace Elastos {
 			// true if the address was previously generated by BRWalletUnusedAddrs() (even if it's now used)
 			bool ContainsAddress(const AddressPtr &address);
 
-			BigInt GetBalance(const uint256 &assetID) const;
+			Amount GetBalance(const uint256 &assetID) const;
 
 			uint64_t GetFeePerKb() const;
 
@@ -141,7 +141,7 @@ namespace Elastos {
 
 			TransactionPtr Consolidate(const std::string &memo, const uint256 &asset);
 
-			TransactionPtr CreateRetrieveTransaction(uint8_t type, const PayloadPtr &payload, const BigInt &amount,
+			TransactionPtr CreateRetrieveTransaction(uint8_t type, const PayloadPtr &payload, const Amount &amount,
 													 const AddressPtr &fromAddress, const std::string &memo);
 
 			TransactionPtr CreateTransaction(uint8_t type, const PayloadPtr &payload,
@@ -158,6 +158,9 @@ namespace Elastos {
 
 			TransactionPtr TransactionForHash(const uint256 &transactionHash);
 
+			// Txs spending an output of txHash, which can't be below blockHeight, the height of txHash.
+			std::vector<TransactionPtr> TransactionsSpending(const uint256 &txHash, uint32_t blockHeight) const;
+
 			size_t GetAllTransactionCount() const;
 
 			UTXOPtr CoinBaseTxForHash(const uint256 &txHash) const;
@@ -176,7 +179,7 @@ namespace Elastos {
 			bool TransactionIsVerified(const TransactionPtr &transaction);
 #endif
 
-			BigInt AmountSentByTx(const TransactionPtr &tx);
+			Amount AmountSentByTx(const TransactionPtr &tx);
 
 			bool IsReceiveTransaction(const TransactionPtr &tx) const;
 
@@ -184,6 +187,8 @@ namespace Elastos {
 
 			void SignTransaction(const TransactionPtr &tx, const std::string &payPassword) const;
 
+			void SignTransactions(const std::vector<TransactionPtr> &txs, const std::string &payPassword) const;
+
 			std::string SignWithDID(const AddressPtr &did, const std::string &msg, const std::string &payPasswd) const;
 
 			std::string SignDigestWithDID(const AddressPtr &did, const uint256 &digest,
@@ -232,7 +237,7 @@ namespace Elastos {
 
 			bool IsAssetUnique(const std::vector<OutputPtr> &outputs) const;
 
-			std::map<uint256, BigInt> BalanceAfterUpdatedTx(const TransactionPtr &tx, UTXOArray &spentCoinbase);
+			std::map<uint256, Amount> BalanceAfterUpdatedTx(const TransactionPtr &tx, UTXOArray &spentCoinbase);
 
 			void BalanceAfterRemoveTx(const TransactionPtr &tx);
 
@@ -247,7 +252,7 @@ namespace Elastos {
 			bool IsUTXOSpending(const UTXOPtr &utxo) const;
 
 		protected:
-			void balanceChanged(const uint256 &asset, const BigInt &balance);
+			void balanceChanged(const uint256 &asset, const Amount &balance);
 
 			void coinBaseTxAdded(const UTXOPtr &cb);
 
@@ -13,15 +13,21 @@
 #include <WalletCore/secp256k1_openssl.h>
 
 #include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace Elastos {
 	namespace ElaWallet {
 
-		Address::Address() {
+		static boost::mutex &AddressStringLock() {
+			static boost::mutex lock;
+			return lock;
+		}
+
+		Address::Address() : _strReady(false) {
 			_isValid = false;
 		}
 
-		Address::Address(const std::string &address) {
+		Address::Address(const std::string &address) : _strReady(true) {
 			_str = address;
 			if (address.empty()) {
 				_isValid = false;
@@ -41,24 +47,22 @@ namespace Elastos {
 			Address(prefix, {pubKey}, 1) {
 		}
 
-		Address::Address(Prefix prefix, const std::vector<bytes_t> &pubkeys, uint8_t m) {
+		Address::Address(Prefix prefix, const std::vector<bytes_t> &pubkeys, uint8_t m) : _strReady(false) {
 			if (pubkeys.size() == 0) {
 				_isValid = false;
 			} else {
 				GenerateCode(prefix, pubkeys, m);
 				GenerateProgramHash(prefix);
-				if (CheckValid())
-					_str = Base58::CheckEncode(_programHash.bytes());
+				CheckValid();
 			}
 		}
 
-		Address::Address(const uint168 &programHash) {
+		Address::Address(const uint168 &programHash) : _strReady(false) {
 			_programHash = programHash;
-			if (CheckValid())
-				_str = Base58::CheckEncode(_programHash.bytes());
+			CheckValid();
 		}
 
-		Address::Address(const Address &address) {
+		Address::Address(const Address &address) : _strReady(false) {
 			operator=(address);
 		}
 
@@ -78,6 +82,15 @@ namespace Elastos {
 		}
 
 		std::string Address::String() const {
+			if (!_strReady.load(std::memory_order_acquire)) {
+				boost::mutex::scoped_lock scopedLock(AddressStringLock());
+				if (!_strReady.load(std::memory_order_relaxed)) {
+					if (_isValid)
+						_str = Base58::CheckEncode(_programHash.bytes());
+					_strReady.store(true, std::memory_order_release);
+				}
+			}
+
 			return _str;
 		}
 
@@ -87,8 +100,8 @@ namespace Elastos {
 
 		void Address::SetProgramHash(const uint168 &programHash) {
 			_programHash = programHash;
-			if (CheckValid())
-				_str = Base58::CheckEncode(_programHash.bytes());
+			CheckValid();
+			ResetString();
 		}
 
 		SignType Address::PrefixToSignType(Prefix prefix) const {
@@ -118,11 +131,11 @@ namespace Elastos {
 			return type;
 		}
 
-		void Address::SetRedeemScript(Prefix prefix, const bytes_t &code) {
+		void Address::SetRedeemScript(Prefix prefix, const SmallBytes &code) {
 			_code = code;
 			GenerateProgramHash(prefix);
-			if (CheckValid())
-				_str = Base58::CheckEncode(_programHash.bytes());
+			CheckValid();
+			ResetString();
 			ErrorChecker::CheckCondition(!_isValid, Error::InvalidArgument, "redeemscript is invalid");
 		}
 
@@ -133,11 +146,11 @@ namespace Elastos {
 				ErrorChecker::ThrowLogicException(Error::Address, "can't change to or from multi-sign prefix");
 
 			GenerateProgramHash(prefix);
-			_str = Base58::CheckEncode(_programHash.bytes());
+			ResetString();
 			return true;
 		}
 
-		const bytes_t &Address::RedeemScript() const {
+		const SmallBytes &Address::RedeemScript() const {
 			assert(!_code.empty());
 			return _code;
 		}
@@ -150,7 +163,12 @@ namespace Elastos {
 			_programHash = address._programHash;
 			_code = address._code;
 			_isValid = address._isValid;
-			_str = address._str;
+			if (address._strReady.load(std::memory_order_acquire)) {
+				_str = address._str;
+				_strReady.store(true, std::memory_order_release);
+			} else {
+				ResetString();
+			}
 			return *this;
 		}
 
@@ -216,8 +234,9 @@ namespace Elastos {
 		}
 
 		void Address::GenerateProgramHash(Prefix prefix) {
-			bytes_t hash = hash160(_code);
-			_programHash = uint168(prefix, hash);
+			uint160 hash;
+			hash160(_code.data(), _code.size(), hash);
+			_programHash = uint168(prefix, bytes_t(hash.begin(), hash.size()));
 		}
 
 		bool Address::CheckValid() {
@@ -235,5 +254,10 @@ namespace Elastos {
 			return _isValid;
 		}
 
+		void Address::ResetString() {
+			_str.clear();
+			_strReady.store(false, std::memory_order_release);
+		}
+
 	}
 }
\ No newline at end of file
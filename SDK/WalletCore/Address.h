@@ -6,8 +6,11 @@
 #define __ELASTOS_SDK_ADDRESS_H__
 
 #include <Common/typedefs.h>
+#include <Common/SmallBytes.h>
 #include <Common/uint256.h>
 
+#include <atomic>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -62,6 +65,7 @@ namespace Elastos {
 
 			bool IsIDAddress() const;
 
+			// Base58 is encoded on first use, comparisons only need the program hash.
 			std::string String() const;
 
 			const uint168 &ProgramHash() const;
@@ -70,9 +74,9 @@ namespace Elastos {
 
 			SignType PrefixToSignType(Prefix prefix) const;
 
-			const bytes_t &RedeemScript() const;
+			const SmallBytes &RedeemScript() const;
 
-			void SetRedeemScript(Prefix prefix, const bytes_t &code);
+			void SetRedeemScript(Prefix prefix, const SmallBytes &code);
 
 			bool ChangePrefix(Prefix prefix);
 
@@ -98,10 +102,13 @@ namespace Elastos {
 
 			bool CheckValid();
 
+			void ResetString();
+
 		private:
 			uint168 _programHash;
-			bytes_t _code;
-			std::string _str;
+			SmallBytes _code;
+			mutable std::string _str;
+			mutable std::atomic<bool> _strReady;
 			bool _isValid;
 		};
 
@@ -17,43 +17,89 @@
 namespace Elastos {
 	namespace ElaWallet {
 
+		namespace {
+
+			// hmac-sha512 with the key already absorbed into the inner and outer contexts, so each round only hashes
+			// the message and the inner digest
+			class HMACSHA512 {
+			public:
+				HMACSHA512(const bytes_t &key) {
+					uint8_t k[SHA512_CBLOCK] = {0}, pad[SHA512_CBLOCK];
+
+					if (key.size() > sizeof(k))
+						SHA512(key.data(), key.size(), k);
+					else
+						memcpy(k, key.data(), key.size());
+
+					for (size_t i = 0; i < sizeof(k); ++i) pad[i] = k[i] ^ 0x36;
+					SHA512_Init(&_inner);
+					SHA512_Update(&_inner, pad, sizeof(pad));
+
+					for (size_t i = 0; i < sizeof(k); ++i) pad[i] = k[i] ^ 0x5c;
+					SHA512_Init(&_outer);
+					SHA512_Update(&_outer, pad, sizeof(pad));
+
+					memset(k, 0, sizeof(k));
+					memset(pad, 0, sizeof(pad));
+				}
+
+				~HMACSHA512() {
+					memset(&_inner, 0, sizeof(_inner));
+					memset(&_outer, 0, sizeof(_outer));
+				}
+
+				void Compute(const uint8_t *data, size_t len, uint8_t md[SHA512_DIGEST_LENGTH]) const {
+					SHA512_CTX ctx = _inner;
+					SHA512_Update(&ctx, data, len);
+					SHA512_Final(md, &ctx);
+
+					ctx = _outer;
+					SHA512_Update(&ctx, md, SHA512_DIGEST_LENGTH);
+					SHA512_Final(md, &ctx);
+
+					memset(&ctx, 0, sizeof(ctx));
+				}
+
+			private:
+				SHA512_CTX _inner, _outer;
+			};
+
+		}
+
 		uint512 BIP39::PBKDF2(const bytes_t &pw, const bytes_t &salt, unsigned int rounds) {
 			bytes_t s(salt.size() + sizeof(uint32_t));
-			uint32_t i, j;
+			uint8_t U[SHA512_DIGEST_LENGTH], T[SHA512_DIGEST_LENGTH];
 			uint512 key;
 			size_t length, keyLen = key.size();
-			bytes_t U, T, k;
+			HMACSHA512 hmac(pw);
 
 			assert(rounds > 0);
 
 			memcpy(s.data(), salt.data(), salt.size());
 
-			for (i = 0; keyLen > 0; i++) {
+			for (uint32_t i = 0; keyLen > 0; i++) {
 				s[salt.size() + 0] = (uint8_t)(((i + 1) >> 24) & 0xff);
 				s[salt.size() + 1] = (uint8_t)(((i + 1) >> 16) & 0xff);
 				s[salt.size() + 2] = (uint8_t)(((i + 1) >> 8) & 0xff);
 				s[salt.size() + 3] = (uint8_t)((i + 1) & 0xff);
 
-				U = hmac_sha512(pw, s); // U1 = hmac_hash(pw, salt || be32(i))
-				T = U;
+				hmac.Compute(s.data(), s.size(), U); // U1 = hmac_hash(pw, salt || be32(i))
+				memcpy(T, U, sizeof(T));
 
 				for (unsigned int r = 1; r < rounds; r++) {
-					U = hmac_sha512(pw, U); // Urounds = hmac_hash(pw, Urounds-1)
-					for (j = 0; j < T.size(); j++) T[j] ^= U[j]; // Ti = U1 ^ U2 ^ ... ^ Urounds
+					hmac.Compute(U, sizeof(U), U); // Urounds = hmac_hash(pw, Urounds-1)
+					for (size_t j = 0; j < sizeof(T); j++) T[j] ^= U[j]; // Ti = U1 ^ U2 ^ ... ^ Urounds
 				}
 
 				// dk = T1 || T2 || ... || Tdklen/hlen
-				length = keyLen < T.size() ? keyLen : T.size();
-				k += T;
+				length = keyLen < sizeof(T) ? keyLen : sizeof(T);
+				memcpy(key.begin() + key.size() - keyLen, T, length);
 				keyLen -= length;
 			}
 
-			key = uint512(k);
-
 			s.clean();
-			U.clean();
-			T.clean();
-			k.clean();
+			memset(U, 0, sizeof(U));
+			memset(T, 0, sizeof(T));
 
 			return key;
 		}
@@ -102,7 +148,28 @@ namespace Elastos {
 			return mnemonic;
 		}
 
+		BIP39::WordIndex BIP39::BuildIndex(const std::vector<std::string> &dictionary) {
+			WordIndex index;
+			index.reserve(dictionary.size());
+
+			for (size_t i = 0; i < dictionary.size(); ++i) {
+				std::string dictWord = dictionary[i];
+
+				dictWord.erase(std::remove_if(dictWord.begin(), dictWord.end(), [](char &c) {
+					return c == '\t' || c == '\r' || c == ' ' || c == '\n';
+				}), dictWord.end());
+
+				index.emplace(dictWord, (uint16_t) i); // the first of duplicated words wins
+			}
+
+			return index;
+		}
+
 		bytes_t BIP39::Decode(const std::vector<std::string> &dictionary, const std::string &mnemonic) {
+			return Decode(BuildIndex(dictionary), mnemonic);
+		}
+
+		bytes_t BIP39::Decode(const WordIndex &index, const std::string &mnemonic) {
 			uint32_t x, y, count = 0, idx[24], i;
 			uint8_t b = 0;
 			bytes_t entropy;
@@ -112,22 +179,12 @@ namespace Elastos {
 			words.erase(std::remove(words.begin(), words.end(), ""), words.end());
 
 			for (const auto &word: words) {
-				for (i = 0; i < dictionary.size(); ++i) {
-					std::string dictWord = dictionary[i];
-
-					dictWord.erase(std::remove_if(dictWord.begin(), dictWord.end(), [](char &c) {
-						return c == '\t' || c == '\r' || c == ' ' || c == '\n';
-					}), dictWord.end());
-
-					if (dictWord == word) {
-						idx[count++] = i;
-						break;
-					}
-				}
-
-				if (i >= dictionary.size()) {
+				WordIndex::const_iterator it = index.find(word);
+				if (it == index.end() || count >= sizeof(idx) / sizeof(idx[0])) {
 					return bytes_t();
 				}
+
+				idx[count++] = it->second;
 			}
 
 			if ((count % 3) == 0) { // check that phrase has correct number of words
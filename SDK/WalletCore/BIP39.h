@@ -11,6 +11,8 @@
 #include <Common/typedefs.h>
 #include <Common/uint256.h>
 
+#include <unordered_map>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -18,12 +20,19 @@ namespace Elastos {
 
 		class BIP39 {
 		public:
+			// word -> position in the dictionary, build once per dictionary and reuse it for every Decode
+			typedef std::unordered_map<std::string, uint16_t> WordIndex;
+
+			static WordIndex BuildIndex(const std::vector<std::string> &dictionary);
+
 			static uint512 DeriveSeed(const std::string &mnemonic, const std::string &passphrase = "");
 
 			static std::string Encode(const std::vector<std::string> &dictionary, const bytes_t &entropy);
 
 			static bytes_t Decode(const std::vector<std::string> &dictionary, const std::string &mnemonic);
 
+			static bytes_t Decode(const WordIndex &index, const std::string &mnemonic);
+
 		private:
 			static uint512 PBKDF2(const bytes_t &pw, const bytes_t &salt, unsigned int rounds);
 		};
@@ -9,6 +9,8 @@
 #include <Common/hash.h>
 #include <Common/BigInt.h>
 
+#include <cstring>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -34,9 +36,9 @@ namespace Elastos {
 			uchar_vector data;
 			data.push_back(version);                                        // prepend version byte
 			data += payload;
-			uchar_vector checksum = sha256_2(data);
-			checksum.assign(checksum.begin(), checksum.begin() + 4);        // compute checksum
-			data += checksum;                                               // append checksum
+			uint256 checksum;
+			sha256_2(data.data(), data.size(), checksum);                   // compute checksum
+			data.insert(data.end(), checksum.begin(), checksum.begin() + 4); // append checksum
 			BigInt bn(data);
 			std::string base58check = bn.getInBase(58, pchars);             // convert to base58
 			std::string leading0s(countLeading0s(data), pchars[0]);         // prepend leading 0's (1 in base58)
@@ -48,9 +50,9 @@ namespace Elastos {
 			uchar_vector data;
 			data += version;                                            // prepend version byte
 			data += payload;
-			uchar_vector checksum = sha256_2(data);
-			checksum.assign(checksum.begin(), checksum.begin() + 4);        // compute checksum
-			data += checksum;                                               // append checksum
+			uint256 checksum;
+			sha256_2(data.data(), data.size(), checksum);                   // compute checksum
+			data.insert(data.end(), checksum.begin(), checksum.begin() + 4); // append checksum
 #if 0
 			BigInt bn(data);
 			std::string base58check = bn.getInBase(58, pchars);             // convert to base58
@@ -70,9 +72,9 @@ namespace Elastos {
 			bytes.assign(bytes.begin(), bytes.end() - 4);                           // split string into payload part and checksum part
 			uchar_vector leading0s(countLeading0s(base58check, pchars[0]), 0); // prepend leading 0's
 			bytes = leading0s + bytes;
-			uchar_vector hashBytes = sha256_2(bytes);
-			hashBytes.assign(hashBytes.begin(), hashBytes.begin() + 4);
-			if (hashBytes != checksum) return false;                                // verify checksum
+			uint256 hashBytes;
+			sha256_2(bytes.data(), bytes.size(), hashBytes);
+			if (memcmp(hashBytes.begin(), checksum.data(), 4) != 0) return false;  // verify checksum
 			version = bytes[0];
 			payload.assign(bytes.begin() + 1, bytes.end());
 			return true;
@@ -87,9 +89,9 @@ namespace Elastos {
 			bytes.assign(bytes.begin(), bytes.end() - 4);                           // split string into payload part and checksum part
 			uchar_vector leading0s(countLeading0s(base58check, pchars[0]), 0); // prepend leading 0's
 			bytes = leading0s + bytes;
-			uchar_vector hashBytes = sha256_2(bytes);
-			hashBytes.assign(hashBytes.begin(), hashBytes.begin() + 4);
-			if (hashBytes != checksum) return false;                                // verify checksum
+			uint256 hashBytes;
+			sha256_2(bytes.data(), bytes.size(), hashBytes);
+			if (memcmp(hashBytes.begin(), checksum.data(), 4) != 0) return false;  // verify checksum
 			payload.assign(bytes.begin(), bytes.end());
 			return true;
 		}
@@ -147,9 +149,9 @@ namespace Elastos {
 			bytes.assign(bytes.begin(), bytes.end() - 4);                           // split string into payload part and checksum part
 			uchar_vector leading0s(countLeading0s(base58check, pchars[0]), 0); // prepend leading 0's
 			bytes = leading0s + bytes;
-			uchar_vector hashBytes = sha256_2(bytes);
-			hashBytes.assign(hashBytes.begin(), hashBytes.begin() + 4);
-			return (hashBytes == checksum);
+			uint256 hashBytes;
+			sha256_2(bytes.data(), bytes.size(), hashBytes);
+			return memcmp(hashBytes.begin(), checksum.data(), 4) == 0;
 		}
 
 	}
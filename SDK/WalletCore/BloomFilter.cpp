@@ -38,7 +38,7 @@ namespace Elastos {
 		}
 
 		//todo add max size check of BLOOM_MAX_FILTER_LENGTH
-		bool BloomFilter::Deserialize(const ByteStream &istream) {
+		bool BloomFilter::Deserialize(const ByteStreamView &istream) {
 			if (!istream.ReadVarBytes(_filter)) {
 				Log::error("Bloom filter deserialize filter fail");
 				return false;
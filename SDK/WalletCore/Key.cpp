@@ -61,6 +61,10 @@ namespace Elastos {
 			return nullptr != _key.setPubKey(pubKey);
 		}
 
+		bool Key::SetPubKey(const SmallBytes &pubKey) {
+			return nullptr != _key.setPubKey(pubKey.data(), pubKey.size());
+		}
+
 		bytes_t Key::PubKey(bool compress) const {
 			return _key.getPubKey(compress);
 		}
@@ -79,7 +83,8 @@ namespace Elastos {
 		}
 
 		bytes_t Key::Sign(const bytes_t &message) const {
-			uint256 digest(sha256(message));
+			uint256 digest;
+			sha256(message.data(), message.size(), digest);
 			return Sign(digest);
 		}
 
@@ -120,15 +125,27 @@ namespace Elastos {
 		}
 
 		bool Key::Verify(const bytes_t &message, const bytes_t &signature) const {
-			uint256 digest(sha256(message));
+			uint256 digest;
+			sha256(message.data(), message.size(), digest);
 			return Verify(digest, signature);
 		}
 
 		bool Key::Verify(const uint256 &digest, const bytes_t &signature) const {
+			return Verify(digest, signature.data(), signature.size());
+		}
+
+		bool Key::Verify(const uint256 &digest, const SmallBytes &signature) const {
+			return Verify(digest, signature.data(), signature.size());
+		}
+
+		bool Key::Verify(const uint256 &digest, const uint8_t *signature, size_t size) const {
 			bool result = false;
 
 			ErrorChecker::CheckLogic(_key.getKey() == nullptr, Error::Sign, "invalid key for verify");
 
+			if (size < 64)
+				return false;
+
 			ECDSA_SIG *sig = ECDSA_SIG_new();
 			if (nullptr != sig) {
 				BIGNUM *r = BN_bin2bn(&signature[0], 32, nullptr);
@@ -7,6 +7,7 @@
 
 #include <Common/uint256.h>
 #include <Common/typedefs.h>
+#include <Common/SmallBytes.h>
 #include <WalletCore/secp256k1_openssl.h>
 #include <WalletCore/HDKeychain.h>
 
@@ -35,6 +36,8 @@ namespace Elastos {
 
 			bool SetPubKey(const bytes_t &pub);
 
+			bool SetPubKey(const SmallBytes &pub);
+
 			bytes_t PubKey(bool compress = true) const;
 
 			bytes_t PrvKey() const;
@@ -53,6 +56,11 @@ namespace Elastos {
 
 			bool Verify(const uint256 &digest, const bytes_t &signature) const;
 
+			bool Verify(const uint256 &digest, const SmallBytes &signature) const;
+
+		private:
+			bool Verify(const uint256 &digest, const uint8_t *signature, size_t size) const;
+
 		private:
 			secp256k1_key _key;
 		};
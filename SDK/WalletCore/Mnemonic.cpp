@@ -86,40 +86,22 @@ namespace Elastos {
 		}
 
 		bool Mnemonic::Validate(const std::string &mnemonic) const {
-			bytes_t entropy = BIP39::Decode(EnglishWordLists, mnemonic);
-			if (!entropy.empty()) {
-				entropy.clean();
-				return true;
-			}
-
-			entropy = BIP39::Decode(ChineseWordLists, mnemonic);
-			if (!entropy.empty()) {
-				entropy.clean();
-				return true;
-			}
-
-			entropy = BIP39::Decode(FrenchWordLists, mnemonic);
-			if (!entropy.empty()) {
-				entropy.clean();
-				return true;
-			}
-
-			entropy = BIP39::Decode(ItalianWordLists, mnemonic);
-			if (!entropy.empty()) {
-				entropy.clean();
-				return true;
-			}
-
-			entropy = BIP39::Decode(JapaneseWordLists, mnemonic);
-			if (!entropy.empty()) {
-				entropy.clean();
-				return true;
-			}
-
-			entropy = BIP39::Decode(SpanishWordLists, mnemonic);
-			if (!entropy.empty()) {
-				entropy.clean();
-				return true;
+			static const BIP39::WordIndex builtinIndexes[] = {
+				BIP39::BuildIndex(EnglishWordLists),
+				BIP39::BuildIndex(ChineseWordLists),
+				BIP39::BuildIndex(FrenchWordLists),
+				BIP39::BuildIndex(ItalianWordLists),
+				BIP39::BuildIndex(JapaneseWordLists),
+				BIP39::BuildIndex(SpanishWordLists)
+			};
+
+			bytes_t entropy;
+			for (size_t i = 0; i < sizeof(builtinIndexes) / sizeof(builtinIndexes[0]); ++i) {
+				entropy = BIP39::Decode(builtinIndexes[i], mnemonic);
+				if (!entropy.empty()) {
+					entropy.clean();
+					return true;
+				}
 			}
 
 			bool valid = false;
@@ -61,7 +61,10 @@ finish:
 			}
 
 		secp256k1_key &secp256k1_key::operator=(const secp256k1_key &from) {
-			if (_key) EC_KEY_dup(from._key);
+			if (this == &from)
+				return *this;
+
+			if (_key) EC_KEY_free(_key);
 			_key = EC_KEY_dup(from._key);
 			return *this;
 		}
@@ -132,12 +135,16 @@ finish:
 		}
 
 		EC_KEY *secp256k1_key::setPubKey(const bytes_t &pubkey) {
-			ErrorChecker::CheckLogic(pubkey.empty(), Error::Key, "pubkey is empty");
+			return setPubKey(pubkey.data(), pubkey.size());
+		}
+
+		EC_KEY *secp256k1_key::setPubKey(const void *pubkey, size_t size) {
+			ErrorChecker::CheckLogic(size == 0, Error::Key, "pubkey is empty");
 			if (!_key)
 				init();
 
-			const unsigned char *pBegin = (unsigned char *) &pubkey[0];
-			if (!o2i_ECPublicKey(&_key, &pBegin, pubkey.size())) {
+			const unsigned char *pBegin = (const unsigned char *) pubkey;
+			if (!o2i_ECPublicKey(&_key, &pBegin, size)) {
 				ErrorChecker::ThrowLogicException(Error::Key, "o2i_ECPublicKey failed");
 				return nullptr;
 			}
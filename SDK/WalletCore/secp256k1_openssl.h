@@ -47,6 +47,8 @@ namespace Elastos {
 
 				EC_KEY *setPubKey(const bytes_t &pubkey);
 
+				EC_KEY *setPubKey(const void *pubkey, size_t size);
+
 			private:
 				void init();
 
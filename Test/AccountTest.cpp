@@ -7,6 +7,10 @@
 #include <catch.hpp>
 #include <Account/Account.h>
 #include <Common/Log.h>
+#include <WalletCore/HDKeychain.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
 
 using namespace Elastos::ElaWallet;
 
@@ -116,3 +120,33 @@ TEST_CASE("Account test", "[Account]") {
 	}
 
 }
+
+TEST_CASE("Account derived address codes", "[Account]") {
+	Log::registerMultiLogger();
+	std::string mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+	std::string payPasswd = "12345678";
+
+	AccountPtr account(new Account("Data/derived", mnemonic, "", payPasswd, false));
+	account->Save();
+
+	std::vector<bytes_t> codes = account->AddressCodes(SEQUENCE_EXTERNAL_CHAIN, 5, 30);
+	REQUIRE(codes.size() == 30);
+
+	HDKeychain chain = account->MasterPubKey()->getChild(SEQUENCE_EXTERNAL_CHAIN);
+	for (uint32_t i = 0; i < codes.size(); ++i)
+		REQUIRE(codes[i] == Address(PrefixStandard, chain.getChild(i + 5).pubkey()).RedeemScript());
+
+	// kept out of the local store, which holds the keys
+	REQUIRE(boost::filesystem::exists("Data/derived/DerivedCodes.dat"));
+	REQUIRE(!boost::filesystem::exists("Data/derived/DerivedCodes.dat.tmp"));
+	std::ifstream is("Data/derived/LocalStore.json");
+	nlohmann::json localStore = nlohmann::json::parse(is);
+	REQUIRE(localStore.find("derivedCodes") == localStore.end());
+
+	// reloaded from the derived code store without deriving again
+	AccountPtr reloaded(new Account("Data/derived"));
+	REQUIRE(reloaded->AddressCodes(SEQUENCE_EXTERNAL_CHAIN, 0, 35) == account->AddressCodes(SEQUENCE_EXTERNAL_CHAIN, 0, 35));
+	REQUIRE(reloaded->AddressCodes(SEQUENCE_INTERNAL_CHAIN, 0, 3).size() == 3);
+
+	account->Remove();
+}
@@ -26,4 +26,23 @@ TEST_CASE("Address test", "[Address]") {
 
 		REQUIRE("Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ" == Address(PrefixStandard, child.pubkey()).String());
 	}
+
+	SECTION("String is encoded on use and follows program hash changes") {
+		Address decoded("Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ");
+		Address addr(decoded.ProgramHash());
+		Address copy(addr);
+
+		REQUIRE(copy == decoded);
+		REQUIRE(addr.String() == "Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ");
+		REQUIRE(copy.String() == addr.String());
+
+		Address other(PrefixStandard, bytes_t("02a1b3b1b3e9f8ea4dc0ba7b8ae7c3b2fdc6bb4a2b6e2d64b5bfee3e2ed1c4e5d9"));
+		copy = other;
+		REQUIRE(copy.String() == other.String());
+		copy.SetProgramHash(decoded.ProgramHash());
+		REQUIRE(copy.String() == "Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ");
+
+		REQUIRE(Address().String().empty());
+		REQUIRE(Address(uint168()).String() == "1111111111111111111114oLvT2");
+	}
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/Amount.h>
+#include <Common/BigInt.h>
+#include <Common/Log.h>
+
+#include <stdexcept>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("Amount matches BigInt", "[Amount]") {
+	Log::registerMultiLogger();
+
+	const char *values[] = {"0", "1", "255", "256", "100000000", "18446744073709551615", "18446744073709551616",
+							"123456789012345678901234567890", "340282366920938463463374607431768211455"};
+
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+		Amount a;
+		BigInt b;
+		a.setDec(values[i]);
+		b.setDec(values[i]);
+
+		REQUIRE(a.getDec() == values[i]);
+		REQUIRE((a.getHexBytes() == b.getHexBytes()));
+		REQUIRE((a.getHexBytes(true) == b.getHexBytes(true)));
+		REQUIRE(Amount(b) == a);
+		REQUIRE(a.getBigInt() == b);
+
+		Amount c;
+		c.setHexBytes(b.getHexBytes(true), true);
+		REQUIRE(c == a);
+	}
+
+	SECTION("arithmetic") {
+		Amount x, y;
+		BigInt bx, by;
+		x.setDec("123456789012345678901234567890");
+		y.setDec("987654321987");
+		bx.setDec("123456789012345678901234567890");
+		by.setDec("987654321987");
+
+		REQUIRE((x + y).getDec() == (bx + by).getDec());
+		REQUIRE((x - y).getDec() == (bx - by).getDec());
+		REQUIRE((y * y * y).getDec() == (by * by * by).getDec());
+		REQUIRE((x / y).getDec() == (bx / by).getDec());
+		REQUIRE((x % y).getDec() == (bx % by).getDec());
+		REQUIRE(x > y);
+		REQUIRE(Amount(100) < 200);
+		REQUIRE(Amount(0).isZero());
+	}
+
+	SECTION("overflow") {
+		Amount max;
+		max.setDec("340282366920938463463374607431768211455");
+
+		REQUIRE_THROWS_AS(max + 1, std::logic_error);
+		REQUIRE_THROWS_AS(Amount(1) - Amount(2), std::logic_error);
+		REQUIRE_THROWS_AS(max * 2, std::logic_error);
+		REQUIRE_THROWS_AS(Amount(1) / Amount(0), std::logic_error);
+		REQUIRE_THROWS_AS(max.getUint64(), std::logic_error);
+		REQUIRE_THROWS_AS(max.setDec("340282366920938463463374607431768211456"), std::logic_error);
+		REQUIRE_THROWS_AS(max.setHexBytes(bytes_t("0100000000000000000000000000000000")), std::logic_error);
+	}
+}
@@ -8,6 +8,8 @@
 
 #include <WalletCore/BIP39.h>
 #include <WalletCore/WordLists/Chinese.h>
+#include <WalletCore/WordLists/English.h>
+#include <Common/Utils.h>
 #include <Common/Log.h>
 
 using namespace Elastos::ElaWallet;
@@ -42,4 +44,14 @@ TEST_CASE("BIP39 test", "[BIP39]") {
 		REQUIRE(result == mnemonic);
 	}
 
+	SECTION("Decode with word index") {
+		BIP39::WordIndex index = BIP39::BuildIndex(ChineseWordLists);
+		REQUIRE(index.size() == 2048);
+
+		bytes_t entropy = BIP39::Decode(index, "闲 齿 兰 丹 请 毛 训 胁 浇 摄 县 诉");
+		REQUIRE("e9b2c1aa5a85467099067cdb5a44f2ac" == entropy.getHex());
+
+		REQUIRE(BIP39::Decode(index, "闲 齿 兰 丹 请 毛 训 胁 浇 摄 县 abandon").empty());
+	}
+
 }
@@ -0,0 +1,39 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <catch.hpp>
+
+#include <WalletCore/BIP39.h>
+#include <WalletCore/WordLists/English.h>
+#include <Common/Utils.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("BIP39 bulk import", "[BIP39]") {
+	std::vector<std::string> mnemonics;
+	for (size_t i = 0; i < 100; ++i)
+		mnemonics.push_back(BIP39::Encode(EnglishWordLists, Utils::GetRandom(16)));
+
+	BENCHMARK("decode 100 mnemonics with the dictionary") {
+		size_t valid = 0;
+		for (size_t i = 0; i < mnemonics.size(); ++i)
+			valid += BIP39::Decode(EnglishWordLists, mnemonics[i]).empty() ? 0 : 1;
+		return valid;
+	};
+
+	BIP39::WordIndex index = BIP39::BuildIndex(EnglishWordLists);
+	BENCHMARK("decode 100 mnemonics with a word index") {
+		size_t valid = 0;
+		for (size_t i = 0; i < mnemonics.size(); ++i)
+			valid += BIP39::Decode(index, mnemonics[i]).empty() ? 0 : 1;
+		return valid;
+	};
+
+	BENCHMARK("derive 100 seeds") {
+		uint512 seed;
+		for (size_t i = 0; i < mnemonics.size(); ++i)
+			seed = BIP39::DeriveSeed(mnemonics[i]);
+		return seed;
+	};
+}
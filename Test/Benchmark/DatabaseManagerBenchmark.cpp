@@ -0,0 +1,90 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <catch.hpp>
+#include "../TestHelper.h"
+
+#include <Database/DatabaseManager.h>
+#include <Plugin/Registry.h>
+
+#include <chrono>
+
+using namespace Elastos::ElaWallet;
+
+#define DBFILE "benchmark.db"
+
+static TransactionPtr CreateTransaction() {
+	TransactionPtr tx(new Transaction());
+
+	for (size_t i = 0; i < 2; ++i) {
+		InputPtr input(new TransactionInput());
+		input->SetTxHash(getRanduint256());
+		input->SetIndex(getRandUInt16());
+		input->SetSequence(getRandUInt32());
+		tx->AddInput(input);
+	}
+	for (size_t i = 0; i < 2; ++i) {
+		OutputPtr output(new TransactionOutput(10, Address(getRandUInt168())));
+		tx->AddOutput(output);
+	}
+	tx->SetBlockHeight(getRandUInt32());
+	tx->SetTimestamp(getRandUInt32());
+
+	return tx;
+}
+
+// Writes the transaction table the way schema version 0 did, with tx hashes as hex text and no indexes.
+static void CreateLegacyDatabase(const std::vector<TransactionPtr> &txns) {
+	boost::filesystem::remove(DBFILE);
+	boost::filesystem::remove(boost::filesystem::path(DBFILE).replace_extension(".headers"));
+	boost::filesystem::remove(std::string(DBFILE) + "-wal");
+	boost::filesystem::remove(std::string(DBFILE) + "-shm");
+	Sqlite sqlite(DBFILE);
+
+	REQUIRE(sqlite.exec("create table transactionTable (_id text not null, transactionBuff blob, "
+						"transactionBlockHeight integer, transactionTimeStamp integer, "
+						"transactionRemark text DEFAULT '', assetID text not null, transactionISO text DEFAULT 'ELA');",
+						nullptr, nullptr));
+
+	REQUIRE(sqlite.BeginTransaction(IMMEDIATE));
+	for (size_t i = 0; i < txns.size(); ++i) {
+		sqlite3_stmt *stmt;
+		REQUIRE(sqlite.PrepareCached("INSERT INTO transactionTable VALUES (?, ?, ?, ?, '', '', 'ela1');", &stmt));
+		ByteStream stream;
+		txns[i]->Serialize(stream, true);
+		sqlite.BindText(stmt, 1, txns[i]->GetHash().GetHex(), SQLITE_TRANSIENT);
+		sqlite.BindBlob(stmt, 2, stream.GetBytes(), nullptr);
+		sqlite.BindInt(stmt, 3, txns[i]->GetBlockHeight());
+		sqlite.BindInt64(stmt, 4, txns[i]->GetTimestamp());
+		REQUIRE(SQLITE_DONE == sqlite.Step(stmt));
+		REQUIRE(sqlite.Finalize(stmt));
+	}
+	REQUIRE(sqlite.EndTransaction());
+}
+
+TEST_CASE("DatabaseManager schema migration", "[DatabaseManager]") {
+	const size_t count = 100000;
+	std::vector<TransactionPtr> txns;
+	for (size_t i = 0; i < count; ++i)
+		txns.push_back(CreateTransaction());
+	CreateLegacyDatabase(txns);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	DatabaseManager dbm(DBFILE);
+	std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+	REQUIRE(dbm.GetSchemaVersion() == DATABASE_SCHEMA_VERSION);
+	REQUIRE(dbm.GetAllTransactionsCount() == count);
+	WARN("migrated " << count << " transactions in "
+		 << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms");
+
+	size_t i = 0;
+	BENCHMARK("GetTransaction by hash") {
+		return dbm.GetTransaction(txns[i++ % count]->GetHash(), CHAINID_MAINCHAIN);
+	};
+
+	BENCHMARK("UpdateTransaction by hash") {
+		std::vector<uint256> hashes(1, txns[i++ % count]->GetHash());
+		return dbm.UpdateTransaction(hashes, 1, 1);
+	};
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <catch.hpp>
+
+#include <Common/FlatHashMap.h>
+#include <Common/uint256.h>
+
+#include <set>
+#include <stdlib.h>
+
+using namespace Elastos::ElaWallet;
+
+static uint256 RandomHash() {
+	uint256 u;
+	for (unsigned char *p = u.begin(); p != u.end(); ++p)
+		*p = (unsigned char) rand();
+	return u;
+}
+
+TEST_CASE("FlatHashSet lookup", "[FlatHashMap]") {
+	const size_t count = 20000;
+	std::vector<uint256> keys, misses;
+	for (size_t i = 0; i < count; ++i) {
+		keys.push_back(RandomHash());
+		misses.push_back(RandomHash());
+	}
+
+	std::set<uint256> ordered(keys.begin(), keys.end());
+	FlatHashSet<uint256> flat;
+	flat.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+		flat.insert(keys[i]);
+
+	BENCHMARK("std::set find") {
+		size_t found = 0;
+		for (size_t i = 0; i < count; ++i)
+			found += ordered.count(keys[i]) + ordered.count(misses[i]);
+		return found;
+	};
+
+	BENCHMARK("FlatHashSet find") {
+		size_t found = 0;
+		for (size_t i = 0; i < count; ++i)
+			found += flat.count(keys[i]) + flat.count(misses[i]);
+		return found;
+	};
+
+	BENCHMARK("std::set build") {
+		std::set<uint256> s;
+		for (size_t i = 0; i < count; ++i)
+			s.insert(keys[i]);
+		return s.size();
+	};
+
+	BENCHMARK("FlatHashSet build") {
+		FlatHashSet<uint256> s;
+		for (size_t i = 0; i < count; ++i)
+			s.insert(keys[i]);
+		return s.size();
+	};
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <catch.hpp>
+
+#include <Common/SHA256D.h>
+#include <Common/hash.h>
+#include <Common/Utils.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("sha256d merkle level", "[SHA256D]") {
+	static const char *kernels[] = {"openssl", "sse4.1", "avx2"};
+	const std::string detected = SHA256D::Implementation();
+	const size_t count = 4096;
+	std::vector<uint256> in(2 * count), out(count);
+	for (size_t i = 0; i < in.size(); ++i)
+		in[i] = uint256(Utils::GetRandom(32));
+
+	BENCHMARK("sha256_2 one pair at a time") {
+		for (size_t i = 0; i < count; ++i)
+			sha256_2(in[2 * i], in[2 * i + 1], out[i]);
+		return out[0];
+	};
+
+	for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+		if (!SHA256D::SetImplementation(kernels[k]))
+			continue;
+
+		BENCHMARK(std::string("SHA256D::HashPairs ") + kernels[k]) {
+			SHA256D::HashPairs(out.data(), in.data(), count);
+			return out[0];
+		};
+	}
+
+	SHA256D::SetImplementation(detected);
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <catch.hpp>
+
+#include <Database/Sqlite.h>
+#include <Common/Utils.h>
+
+using namespace Elastos::ElaWallet;
+
+#define DBFILE "sqlite_benchmark.db"
+
+static const std::string insertSql = "INSERT INTO kv (k, v) VALUES (?, ?);";
+
+static void ResetDatabase(Sqlite &sqlite) {
+	REQUIRE(sqlite.exec("DROP TABLE IF EXISTS kv;", nullptr, nullptr));
+	REQUIRE(sqlite.exec("CREATE TABLE kv (k INTEGER PRIMARY KEY, v BLOB);", nullptr, nullptr));
+}
+
+static bool Insert(Sqlite &sqlite, int key, const bytes_t &value, bool cached) {
+	sqlite3_stmt *stmt;
+	bool ok = cached ? sqlite.PrepareCached(insertSql, &stmt) : sqlite.Prepare(insertSql, &stmt, nullptr);
+	if (!ok)
+		return false;
+
+	ok = sqlite.BindInt(stmt, 1, key) && sqlite.BindBlob(stmt, 2, value, nullptr) &&
+		 SQLITE_DONE == sqlite.Step(stmt);
+
+	return sqlite.Finalize(stmt) && ok;
+}
+
+TEST_CASE("Sqlite bulk insert", "[Sqlite]") {
+	const int count = 5000;
+	const bytes_t value = Utils::GetRandom(200);
+	Sqlite sqlite(DBFILE);
+	REQUIRE(sqlite.IsValid());
+
+	BENCHMARK("prepare and finalize per row") {
+		ResetDatabase(sqlite);
+		bool ok = sqlite.BeginTransaction(IMMEDIATE);
+		for (int i = 0; i < count; ++i)
+			ok = Insert(sqlite, i, value, false) && ok;
+		return sqlite.EndTransaction() && ok;
+	};
+
+	BENCHMARK("cached statement") {
+		ResetDatabase(sqlite);
+		bool ok = sqlite.BeginTransaction(IMMEDIATE);
+		for (int i = 0; i < count; ++i)
+			ok = Insert(sqlite, i, value, true) && ok;
+		return sqlite.EndTransaction() && ok;
+	};
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <catch.hpp>
+#include "../TestHelper.h"
+
+#include <Plugin/Transaction/Transaction.h>
+#include <Common/ByteStream.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("Transaction deserialize", "[Transaction]") {
+	const size_t count = 500;
+	std::vector<bytes_t> raw(count);
+	for (size_t i = 0; i < count; ++i) {
+		Transaction tx;
+		initTransaction(tx, Transaction::TxVersion::V09);
+		ByteStream stream;
+		tx.Serialize(stream);
+		raw[i] = stream.GetBytes();
+	}
+
+	BENCHMARK("Deserialize, address strings left unencoded") {
+		size_t outputs = 0;
+		for (size_t i = 0; i < count; ++i) {
+			Transaction tx;
+			tx.Deserialize(ByteStream(raw[i]));
+			outputs += tx.GetOutputs().size();
+		}
+		return outputs;
+	};
+
+	// what every deserialize paid before strings were encoded on use
+	BENCHMARK("Deserialize, encoding every output address") {
+		size_t length = 0;
+		for (size_t i = 0; i < count; ++i) {
+			Transaction tx;
+			tx.Deserialize(ByteStream(raw[i]));
+			for (const OutputPtr &o : tx.GetOutputs())
+				length += o->Addr()->String().size();
+		}
+		return length;
+	};
+}
+
+TEST_CASE("Transaction serialize", "[Transaction]") {
+	const size_t count = 500;
+	std::vector<Transaction> txns(count);
+	for (size_t i = 0; i < count; ++i)
+		initTransaction(txns[i], Transaction::TxVersion::V09);
+
+	BENCHMARK("Serialize, growing buffer") {
+		size_t bytes = 0;
+		for (size_t i = 0; i < count; ++i) {
+			ByteStream stream;
+			txns[i].Serialize(stream, true);
+			bytes += stream.GetBytes().size();
+		}
+		return bytes;
+	};
+
+	BENCHMARK("Serialize, counted then written once") {
+		size_t bytes = 0;
+		for (size_t i = 0; i < count; ++i) {
+			ByteStream stream;
+			stream.WriteExact([&](ByteStream &s) { txns[i].Serialize(s, true); });
+			bytes += stream.GetBytes().size();
+		}
+		return bytes;
+	};
+}
@@ -17,12 +17,86 @@
 #include <Plugin/Block/MerkleBlock.h>
 #include <Plugin/ELAPlugin.h>
 
+#include <algorithm>
 #include <fstream>
 
 using namespace Elastos::ElaWallet;
 
 #define ISO "ela1"
 #define DBFILE "wallet.db"
+#define HEADERFILE "wallet.headers"
+
+static void RemoveDatabase() {
+	boost::filesystem::remove(DBFILE);
+	boost::filesystem::remove(HEADERFILE);
+	boost::filesystem::remove(std::string(DBFILE) + "-wal");
+	boost::filesystem::remove(std::string(DBFILE) + "-shm");
+}
+
+static TransactionPtr CreateTransaction() {
+	TransactionPtr tx(new Transaction());
+
+	for (size_t i = 0; i < 2; ++i) {
+		InputPtr input(new TransactionInput());
+		input->SetTxHash(getRanduint256());
+		input->SetIndex(getRandUInt16());
+		input->SetSequence(getRandUInt32());
+		tx->AddInput(input);
+	}
+	for (size_t i = 0; i < 2; ++i) {
+		OutputPtr output(new TransactionOutput(10, Address(getRandUInt168())));
+		tx->AddOutput(output);
+	}
+	tx->SetBlockHeight(getRandUInt32());
+	tx->SetTimestamp(getRandUInt32());
+
+	return tx;
+}
+
+// Writes tables the way schema version 0 did, with tx hashes as hex text and no indexes.
+static void CreateLegacyDatabase(const std::vector<TransactionPtr> &txns, const UTXOArray &coinbase) {
+	RemoveDatabase();
+	Sqlite sqlite(DBFILE);
+
+	REQUIRE(sqlite.exec("create table transactionTable (_id text not null, transactionBuff blob, "
+						"transactionBlockHeight integer, transactionTimeStamp integer, "
+						"transactionRemark text DEFAULT '', assetID text not null, transactionISO text DEFAULT 'ELA');"
+						"create table coinBaseUTXOTable (txHash text not null, blockHeight INTEGER, "
+						"timestamp INTEGER, outputIndex INTEGER, programHash BLOB, assetID BLOB, outputLock INTEGER, "
+						"amount TEXT DEFAULT '0', payload BLOB, spent INTEGER);", nullptr, nullptr));
+
+	REQUIRE(sqlite.BeginTransaction(IMMEDIATE));
+	for (size_t i = 0; i < txns.size(); ++i) {
+		sqlite3_stmt *stmt;
+		REQUIRE(sqlite.PrepareCached("INSERT INTO transactionTable VALUES (?, ?, ?, ?, '', '', ?);", &stmt));
+		ByteStream stream;
+		txns[i]->Serialize(stream, true);
+		sqlite.BindText(stmt, 1, txns[i]->GetHash().GetHex(), SQLITE_TRANSIENT);
+		sqlite.BindBlob(stmt, 2, stream.GetBytes(), nullptr);
+		sqlite.BindInt(stmt, 3, txns[i]->GetBlockHeight());
+		sqlite.BindInt64(stmt, 4, txns[i]->GetTimestamp());
+		sqlite.BindText(stmt, 5, ISO, nullptr);
+		REQUIRE(SQLITE_DONE == sqlite.Step(stmt));
+		REQUIRE(sqlite.Finalize(stmt));
+	}
+	for (size_t i = 0; i < coinbase.size(); ++i) {
+		sqlite3_stmt *stmt;
+		REQUIRE(sqlite.PrepareCached("INSERT INTO coinBaseUTXOTable VALUES (?, ?, ?, ?, ?, ?, ?, ?, NULL, ?);", &stmt));
+		const UTXOPtr &u = coinbase[i];
+		sqlite.BindText(stmt, 1, u->Hash().GetHex(), SQLITE_TRANSIENT);
+		sqlite.BindInt(stmt, 2, u->BlockHeight());
+		sqlite.BindInt64(stmt, 3, u->Timestamp());
+		sqlite.BindInt(stmt, 4, u->Index());
+		sqlite.BindBlob(stmt, 5, u->Output()->Addr()->ProgramHash().bytes(), nullptr);
+		sqlite.BindBlob(stmt, 6, u->Output()->AssetID().begin(), u->Output()->AssetID().size(), nullptr);
+		sqlite.BindInt(stmt, 7, u->Output()->OutputLock());
+		sqlite.BindText(stmt, 8, u->Output()->Amount().getDec(), SQLITE_TRANSIENT);
+		sqlite.BindInt(stmt, 9, u->Spent());
+		REQUIRE(SQLITE_DONE == sqlite.Step(stmt));
+		REQUIRE(sqlite.Finalize(stmt));
+	}
+	REQUIRE(sqlite.EndTransaction());
+}
 
 TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 	Log::registerMultiLogger();
@@ -35,6 +109,7 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 		if (boost::filesystem::exists(DBFILE) && boost::filesystem::is_regular_file(DBFILE)) {
 			boost::filesystem::remove(DBFILE);
 		}
+		boost::filesystem::remove(HEADERFILE);
 
 		REQUIRE(!boost::filesystem::exists(DBFILE));
 	}
@@ -131,8 +206,8 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 				REQUIRE(blocksToSave[i]->GetPrevBlockHash() == blocksRead[i]->GetPrevBlockHash());
 				REQUIRE(blocksToSave[i]->GetHash() == blocksRead[i]->GetHash());
 				REQUIRE(blocksToSave[i]->GetTarget() == blocksRead[i]->GetTarget());
-				REQUIRE(blocksToSave[i]->GetNonce() == blocksRead[i]->GetNonce());
 			}
+			REQUIRE(dbm.GetAllMerkleBlocks("other", pluginType).empty());
 		}
 
 		SECTION("Merkle Block delete test") {
@@ -161,7 +236,6 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 				REQUIRE(blocksToSave[i]->GetPrevBlockHash() == blocksRead[i]->GetPrevBlockHash());
 				REQUIRE(blocksToSave[i]->GetHash() == blocksRead[i]->GetHash());
 				REQUIRE(blocksToSave[i]->GetTarget() == blocksRead[i]->GetTarget());
-				REQUIRE(blocksToSave[i]->GetNonce() == blocksRead[i]->GetNonce());
 			}
 		}
 
@@ -177,6 +251,67 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 			std::vector<MerkleBlockPtr> blocksAfterDelete = dbm.GetAllMerkleBlocks(ISO, pluginType);
 			REQUIRE(0 == blocksAfterDelete.size());
 		}
+
+		SECTION("Merkle Block torn tail test") {
+			{
+				DatabaseManager dbm(DBFILE);
+				REQUIRE(dbm.PutMerkleBlocks(ISO, blocksToSave));
+			}
+
+			// simulate a crash in the middle of appending the last record
+			uintmax_t size = boost::filesystem::file_size(HEADERFILE);
+			boost::filesystem::resize_file(HEADERFILE, size - 7);
+
+			DatabaseManager dbm(DBFILE);
+			std::vector<MerkleBlockPtr> blocksRead = dbm.GetAllMerkleBlocks(ISO, pluginType);
+			REQUIRE(blocksRead.size() == blocksToSave.size() - 1);
+			REQUIRE(blocksRead.back()->GetHash() == blocksToSave[blocksToSave.size() - 2]->GetHash());
+
+			REQUIRE(dbm.PutMerkleBlock(ISO, blocksToSave.back()));
+			blocksRead = dbm.GetAllMerkleBlocks(ISO, pluginType);
+			REQUIRE(blocksRead.size() == blocksToSave.size());
+			REQUIRE(blocksRead.back()->GetHash() == blocksToSave.back()->GetHash());
+			REQUIRE(dbm.DeleteAllBlocks(ISO));
+		}
+
+		SECTION("Merkle Block sync test") {
+			DatabaseManager dbm(DBFILE);
+			REQUIRE(dbm.PutMerkleBlocks(ISO, blocksToSave));
+
+			// dropping half of the records marks them deleted in place
+			uintmax_t size = boost::filesystem::file_size(HEADERFILE);
+			std::vector<MerkleBlockPtr> kept(blocksToSave.begin(), blocksToSave.begin() + blocksToSave.size() / 2);
+			REQUIRE(dbm.SyncMerkleBlocks(ISO, kept));
+			REQUIRE(boost::filesystem::file_size(HEADERFILE) == size);
+			REQUIRE(!boost::filesystem::exists(std::string(HEADERFILE) + ".tmp"));
+
+			std::vector<MerkleBlockPtr> blocksRead = dbm.GetAllMerkleBlocks(ISO, pluginType);
+			REQUIRE(blocksRead.size() == kept.size());
+			for (size_t i = 0; i < blocksRead.size(); ++i)
+				REQUIRE(blocksRead[i]->GetHash() == kept[i]->GetHash());
+
+			// matched by hash, the order the peer manager hands them over in does not matter
+			std::vector<MerkleBlockPtr> reversed(blocksToSave.rbegin(), blocksToSave.rend());
+			REQUIRE(dbm.SyncMerkleBlocks(ISO, reversed));
+			REQUIRE(dbm.SyncMerkleBlocks(ISO, blocksToSave));
+			REQUIRE(dbm.GetAllMerkleBlocks(ISO, pluginType).size() == blocksToSave.size());
+			REQUIRE(dbm.DeleteAllBlocks(ISO));
+		}
+
+		SECTION("Merkle Block unknown format test") {
+			boost::filesystem::remove(std::string(HEADERFILE) + ".bak");
+			{
+				std::ofstream file(HEADERFILE, std::ios::binary | std::ios::trunc);
+				file << "not a header store";
+			}
+
+			DatabaseManager dbm(DBFILE);
+			REQUIRE(boost::filesystem::exists(std::string(HEADERFILE) + ".bak"));
+			REQUIRE(dbm.GetAllMerkleBlocks(ISO, pluginType).empty());
+			REQUIRE(dbm.PutMerkleBlocks(ISO, blocksToSave));
+			REQUIRE(dbm.DeleteAllBlocks(ISO));
+			boost::filesystem::remove(std::string(HEADERFILE) + ".bak");
+		}
 	}
 
 	SECTION("Peer test") {
@@ -337,7 +472,7 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 
 		SECTION("prepare for testing") {
 			for (uint64_t i = 0; i < TEST_TX_RECORD_CNT; ++i) {
-				OutputPtr o(new TransactionOutput(getRandBigInt(), Address(getRandUInt168()), getRanduint256()));
+				OutputPtr o(new TransactionOutput(getRandAmount(), Address(getRandUInt168()), getRanduint256()));
 				o->SetOutputLock(getRandUInt32());
 				UTXOPtr entity(new UTXO(getRanduint256(), getRandUInt16(), getRandUInt32(), getRandUInt32(), o));
 
@@ -483,6 +618,123 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 			}
 		}
 
+		SECTION("Transaction replace test") {
+			DatabaseManager dbm(DBFILE);
+			TransactionEntity entity(*txToSave[0]);
+			entity.BlockHeight = 1234;
+			REQUIRE(dbm.ReplaceTransaction(ISO, entity));
+			REQUIRE(dbm.GetAllTransactionsCount() == txToSave.size());
+			REQUIRE(dbm.GetTransaction(entity.TxHash, CHAINID_MAINCHAIN)->GetBlockHeight() == 1234);
+
+			// back to the saved state for the sections below
+			REQUIRE(dbm.ReplaceTransaction(ISO, TransactionEntity(*txToSave[0])));
+			REQUIRE(dbm.GetTransaction(entity.TxHash, CHAINID_MAINCHAIN)->GetBlockHeight() ==
+					txToSave[0]->GetBlockHeight());
+		}
+
+		SECTION("Transaction cursor test") {
+			DatabaseManager dbm(DBFILE);
+			// heights are random over the whole uint32 range, the first range crosses INT32_MAX
+			const HeightRange ranges[] = {
+				HeightRange(INT32_MAX / 2, INT32_MAX / 2 + INT32_MAX),
+				HeightRange((uint32_t) INT32_MAX + 1, UINT32_MAX)
+			};
+
+			for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); ++r) {
+				const HeightRange &range = ranges[r];
+				size_t expected = 0;
+				for (size_t i = 0; i < txToSave.size(); ++i) {
+					if (range.Contains(txToSave[i]->GetBlockHeight()))
+						expected++;
+				}
+				REQUIRE(expected > 0);
+
+				size_t visited = 0;
+				REQUIRE(dbm.ForEachTransaction(CHAINID_MAINCHAIN, range, [&](const TransactionPtr &tx) {
+					REQUIRE(range.Contains(tx->GetBlockHeight()));
+					visited++;
+					return true;
+				}));
+				REQUIRE(visited == expected);
+			}
+
+			size_t visited = 0;
+			REQUIRE(dbm.ForEachTransaction(CHAINID_MAINCHAIN, HeightRange(), [&visited](const TransactionPtr &tx) {
+				visited++;
+				return false;
+			}));
+			REQUIRE(visited == 1);
+		}
+
+		SECTION("Transaction summary test") {
+			DatabaseManager dbm(DBFILE);
+			REQUIRE(dbm.GetTransactionsWithoutSummary().size() == txToSave.size());
+
+			std::vector<TransactionSummary> summaries;
+			for (size_t i = 0; i < txToSave.size(); ++i) {
+				TransactionSummary summary;
+				summary.TxHash = txToSave[i]->GetHash();
+				summary.Direction = "Received";
+				summary.Amount = 10 * i;
+				summary.Fee = i;
+				summary.Type = (uint8_t) (i % 2);
+				summaries.push_back(summary);
+			}
+			REQUIRE(dbm.UpdateTransactionSummaries(summaries));
+			REQUIRE(dbm.GetTransactionsWithoutSummary().empty());
+
+			std::vector<TransactionSummary> page = dbm.GetTransactionSummaries(bytes_t(), 2, 5);
+			REQUIRE(page.size() == 5);
+			for (size_t i = 1; i < page.size(); ++i)
+				REQUIRE(page[i - 1].BlockHeight >= page[i].BlockHeight);
+
+			bytes_t types(1, 1);
+			REQUIRE(dbm.GetTransactionSummaryCount(types) == txToSave.size() / 2);
+			std::vector<TransactionSummary> typed = dbm.GetTransactionSummaries(types, 0, TX_SUMMARY_NO_LIMIT);
+			REQUIRE(typed.size() == txToSave.size() / 2);
+			for (size_t i = 0; i < typed.size(); ++i) {
+				REQUIRE(typed[i].Type == 1);
+				REQUIRE(typed[i].Direction == "Received");
+				REQUIRE(typed[i].Fee % 2 == 1);
+				REQUIRE(typed[i].Amount == Amount(10 * typed[i].Fee));
+			}
+			REQUIRE(dbm.GetTransactionSummaries(types, 1, TX_SUMMARY_NO_LIMIT).size() == typed.size() - 1);
+
+			// a row the wallet doesn't hold is summarized with an empty direction and not listed
+			std::vector<TransactionSummary> notHeld(1);
+			notHeld[0].TxHash = txToSave[0]->GetHash();
+			REQUIRE(dbm.UpdateTransactionSummaries(notHeld));
+			REQUIRE(dbm.GetTransactionsWithoutSummary().empty());
+			REQUIRE(dbm.GetTransactionSummaryCount(bytes_t()) == txToSave.size() - 1);
+			REQUIRE(dbm.GetTransactionSummaries(bytes_t(), 0, TX_SUMMARY_NO_LIMIT).size() == txToSave.size() - 1);
+
+			// a summary written with the tx replaces the stored one, a bare tx leaves the row unsummarized
+			REQUIRE(dbm.ReplaceTransaction(ISO, TransactionEntity(*txToSave[0], summaries[1])));
+			std::vector<TransactionSummary> all = dbm.GetTransactionSummaries(bytes_t(), 0, TX_SUMMARY_NO_LIMIT);
+			REQUIRE(all.size() == txToSave.size());
+			for (size_t i = 0; i < all.size(); ++i) {
+				if (all[i].TxHash == txToSave[0]->GetHash()) {
+					REQUIRE(all[i].Fee == 1);
+					REQUIRE(all[i].Type == 1);
+				}
+			}
+
+			REQUIRE(dbm.ReplaceTransaction(ISO, TransactionEntity(*txToSave[1])));
+			std::vector<uint256> unsummarized = dbm.GetTransactionsWithoutSummary();
+			REQUIRE(unsummarized.size() == 1);
+			REQUIRE(unsummarized[0] == txToSave[1]->GetHash());
+			REQUIRE(dbm.GetTransactionSummaryCount(bytes_t()) == txToSave.size() - 1);
+
+			std::vector<TransactionEntity> entities;
+			for (size_t i = 0; i < txToSave.size(); ++i)
+				entities.push_back(TransactionEntity(*txToSave[i], summaries[i]));
+			REQUIRE(dbm.SyncTransactions(ISO, entities));
+			REQUIRE(dbm.GetTransactionsWithoutSummary().empty());
+			REQUIRE(dbm.GetTransactionSummaryCount(bytes_t()) == txToSave.size());
+
+			REQUIRE(dbm.UpdateTransactionSummaries(summaries));
+		}
+
 		SECTION("Transaction udpate test") {
 			DatabaseManager dbm(DBFILE);
 
@@ -522,6 +774,27 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 			REQUIRE(0 == readTx.size());
 		}
 
+		SECTION("Transaction sync test") {
+			DatabaseManager dbm(DBFILE);
+
+			REQUIRE(dbm.SyncTransactions(ISO, txToSave));
+			REQUIRE(txToSave.size() == dbm.GetAllTransactionsCount());
+
+			std::vector<TransactionPtr> txns(txToUpdate.begin() + 1, txToUpdate.end());
+			REQUIRE(dbm.SyncTransactions(ISO, txns));
+
+			std::vector<TransactionPtr> readTx = dbm.GetAllTransactions(CHAINID_MAINCHAIN);
+			REQUIRE(txns.size() == readTx.size());
+			for (int i = 0; i < readTx.size(); ++i) {
+				REQUIRE(readTx[i]->GetHash() != txToUpdate[0]->GetHash());
+				REQUIRE(readTx[i]->GetTimestamp() == txToUpdate[0]->GetTimestamp());
+				REQUIRE(readTx[i]->GetBlockHeight() == txToUpdate[0]->GetBlockHeight());
+			}
+
+			REQUIRE(dbm.SyncTransactions(ISO, std::vector<TransactionPtr>()));
+			REQUIRE(0 == dbm.GetAllTransactionsCount());
+		}
+
 	}
 
 	SECTION("DID test") {
@@ -608,3 +881,158 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 	}
 
 }
+
+TEST_CASE("DatabaseManager schema migration", "[DatabaseManager]") {
+	Log::registerMultiLogger();
+
+	SECTION("new database starts at the current schema version") {
+		RemoveDatabase();
+		DatabaseManager dbm(DBFILE);
+		REQUIRE(dbm.GetSchemaVersion() == DATABASE_SCHEMA_VERSION);
+	}
+
+	SECTION("legacy hex keys are migrated on open") {
+		std::vector<TransactionPtr> txns;
+		for (size_t i = 0; i < 20; ++i)
+			txns.push_back(CreateTransaction());
+
+		UTXOArray coinbase;
+		for (size_t i = 0; i < 5; ++i) {
+			OutputPtr o(new TransactionOutput(getRandAmount(), Address(getRandUInt168()), getRanduint256()));
+			o->SetOutputLock(getRandUInt32());
+			coinbase.push_back(UTXOPtr(new UTXO(getRanduint256(), getRandUInt16(), getRandUInt32(), getRandUInt32(), o)));
+		}
+
+		CreateLegacyDatabase(txns, coinbase);
+
+		DatabaseManager dbm(DBFILE);
+		REQUIRE(dbm.GetSchemaVersion() == DATABASE_SCHEMA_VERSION);
+
+		std::vector<TransactionPtr> readTx = dbm.GetAllTransactions(CHAINID_MAINCHAIN);
+		REQUIRE(readTx.size() == txns.size());
+		for (size_t i = 0; i < readTx.size(); ++i) {
+			REQUIRE(readTx[i]->GetHash() == txns[i]->GetHash());
+			REQUIRE(readTx[i]->GetBlockHeight() == txns[i]->GetBlockHeight());
+			REQUIRE(readTx[i]->GetTimestamp() == txns[i]->GetTimestamp());
+		}
+
+		// the legacy rows stored heights above INT32_MAX as negative values
+		HeightRange upper((uint32_t) INT32_MAX + 1, UINT32_MAX);
+		size_t expected = 0, visited = 0;
+		for (size_t i = 0; i < txns.size(); ++i) {
+			if (upper.Contains(txns[i]->GetBlockHeight()))
+				expected++;
+		}
+		REQUIRE(dbm.ForEachTransaction(CHAINID_MAINCHAIN, upper, [&visited](const TransactionPtr &tx) {
+			visited++;
+			return true;
+		}));
+		REQUIRE(visited == expected);
+
+		expected = visited = 0;
+		for (size_t i = 0; i < coinbase.size(); ++i) {
+			if (upper.Contains(coinbase[i]->BlockHeight()))
+				expected++;
+		}
+		REQUIRE(dbm.ForEachCoinBase(upper, [&visited](const UTXOPtr &u) {
+			visited++;
+			return true;
+		}));
+		REQUIRE(visited == expected);
+
+		TransactionPtr tx = dbm.GetTransaction(txns[7]->GetHash(), CHAINID_MAINCHAIN);
+		REQUIRE(tx != nullptr);
+		REQUIRE(tx->GetHash() == txns[7]->GetHash());
+
+		REQUIRE(dbm.DeleteTxByHash(txns[7]->GetHash()));
+		REQUIRE(dbm.GetAllTransactionsCount() == txns.size() - 1);
+
+		std::vector<UTXOPtr> readCoinBase = dbm.GetAllCoinBase();
+		REQUIRE(readCoinBase.size() == coinbase.size());
+		for (size_t i = 0; i < readCoinBase.size(); ++i) {
+			REQUIRE(readCoinBase[i]->Hash() == coinbase[i]->Hash());
+			REQUIRE(readCoinBase[i]->Index() == coinbase[i]->Index());
+			REQUIRE(readCoinBase[i]->Output()->Amount() == coinbase[i]->Output()->Amount());
+		}
+
+		REQUIRE(dbm.DeleteCoinBase(coinbase[0]->Hash()));
+		REQUIRE(dbm.GetCoinBaseTotalCount() == coinbase.size() - 1);
+	}
+
+	SECTION("legacy merkle blocks move to the header store once") {
+#ifdef SPV_ENABLE_STATIC
+		REGISTER_MERKLEBLOCKPLUGIN(ELA, getELAPluginComponent);
+#endif
+		std::vector<MerkleBlockPtr> blocks;
+		for (uint32_t i = 0; i < 20; ++i) {
+			MerkleBlockPtr block(Registry::Instance()->CreateMerkleBlock("ELA"));
+			block->SetHeight(i + 1);
+			block->SetTimestamp(getRandUInt32());
+			block->SetPrevBlockHash(getRanduint256());
+			block->SetTarget(getRandUInt32());
+			blocks.push_back(block);
+		}
+
+		CreateLegacyDatabase(std::vector<TransactionPtr>(), UTXOArray());
+		{
+			Sqlite sqlite(DBFILE);
+			MerkleBlockDataSource legacy(&sqlite);
+			REQUIRE(legacy.PutMerkleBlocks(ISO, blocks));
+			REQUIRE(sqlite.SetUserVersion(3));
+
+			// a migration that stopped after storing part of the blocks
+			HeaderStore store(HEADERFILE);
+			REQUIRE(store.Append(ISO, std::vector<MerkleBlockPtr>(blocks.begin(), blocks.begin() + 5)));
+		}
+
+		{
+			DatabaseManager dbm(DBFILE);
+			REQUIRE(dbm.GetSchemaVersion() == DATABASE_SCHEMA_VERSION);
+
+			std::vector<MerkleBlockPtr> readBlocks = dbm.GetAllMerkleBlocks(ISO, "ELA");
+			REQUIRE(readBlocks.size() == blocks.size());
+			for (size_t i = 0; i < readBlocks.size(); ++i) {
+				REQUIRE(readBlocks[i]->GetHash() == blocks[i]->GetHash());
+				REQUIRE(readBlocks[i]->GetPrevBlockHash() == blocks[i]->GetPrevBlockHash());
+				REQUIRE(readBlocks[i]->GetHeight() == blocks[i]->GetHeight());
+			}
+		}
+
+		Sqlite sqlite(DBFILE);
+		MerkleBlockDataSource legacy(&sqlite);
+		std::map<std::string, std::vector<HeaderRecord>> left;
+		REQUIRE(legacy.GetAllHeaders(left));
+		REQUIRE(left.empty());
+	}
+
+	SECTION("an interrupted migration resumes where it stopped") {
+		std::vector<TransactionPtr> txns;
+		for (size_t i = 0; i < 20; ++i)
+			txns.push_back(CreateTransaction());
+
+		CreateLegacyDatabase(txns, UTXOArray());
+
+		{
+			Sqlite sqlite(DBFILE);
+			// fails the third batch of 4, the two before it stay committed
+			REQUIRE(sqlite.exec("CREATE TRIGGER interrupt BEFORE DELETE ON transactionTable WHEN old.rowid >= 10 "
+								"BEGIN SELECT RAISE(ABORT, 'interrupted'); END;", nullptr, nullptr));
+
+			TransactionDataStore store(&sqlite);
+			REQUIRE(!store.MigrateBinaryKeys(4));
+			REQUIRE(store.GetAllTransactionsCount() == 8);
+
+			REQUIRE(sqlite.exec("DROP TRIGGER interrupt;", nullptr, nullptr));
+		}
+
+		DatabaseManager dbm(DBFILE);
+		REQUIRE(dbm.GetSchemaVersion() == DATABASE_SCHEMA_VERSION);
+
+		std::vector<TransactionPtr> readTx = dbm.GetAllTransactions(CHAINID_MAINCHAIN);
+		REQUIRE(readTx.size() == txns.size());
+		for (size_t i = 0; i < readTx.size(); ++i) {
+			REQUIRE(readTx[i]->GetHash() == txns[i]->GetHash());
+			REQUIRE(readTx[i]->GetBlockHeight() == txns[i]->GetBlockHeight());
+		}
+	}
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Account/DerivedKeyCache.h>
+#include <Common/Log.h>
+#include <WalletCore/BIP39.h>
+#include <WalletCore/HDKeychain.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("DerivedKeyCache", "[DerivedKeyCache]") {
+	Log::registerMultiLogger();
+
+	uint512 seed = BIP39::DeriveSeed("闲 齿 兰 丹 请 毛 训 胁 浇 摄 县 诉", "");
+	HDKeychainPtr root(new HDKeychain(HDSeed(seed.bytes()).getExtendedKey(true)));
+	DerivedKeyCache cache(root);
+
+	SECTION("cosigner node is cached") {
+		std::string path = "45'/3/0/7";
+		std::vector<SmallBytes> pubKeys;
+		pubKeys.push_back(root->getChild(path).pubkey());
+
+		Key key;
+		REQUIRE(cache.FindKey(path, pubKeys, key));
+		REQUIRE(key.PubKey() == root->getChild(path).pubkey());
+
+		REQUIRE(cache.ContainsNode("45'"));
+		REQUIRE(cache.ContainsNode("45'/3"));
+		REQUIRE(cache.ContainsNode("45'/3/0"));
+		REQUIRE(!cache.ContainsNode(path));
+
+		// a sibling reuses the cached parent
+		pubKeys[0] = root->getChild("45'/3/0/8").pubkey();
+		REQUIRE(cache.FindKey("45'/3/0/8", pubKeys, key));
+		REQUIRE(cache.Size() == 2);
+	}
+
+	SECTION("standard account nodes are cached") {
+		std::vector<SmallBytes> pubKeys;
+		pubKeys.push_back(root->getChild("44'/0'/0'/0/0").pubkey());
+
+		Key key;
+		REQUIRE(cache.FindKey("44'/0'/0'/0/0", pubKeys, key));
+		REQUIRE(cache.ContainsNode("44'/0'/0'"));
+		REQUIRE(cache.ContainsNode("44'/0'/0'/0"));
+
+		pubKeys[0] = root->getChild("44'/0'/0'/1/0").pubkey();
+		REQUIRE(!cache.FindKey("44'/0'/0'/0/1", pubKeys, key));
+		REQUIRE(cache.FindKey("44'/0'/0'/1/0", pubKeys, key));
+	}
+}
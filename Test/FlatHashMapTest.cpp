@@ -0,0 +1,103 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/FlatHashMap.h>
+#include <Common/uint256.h>
+
+#include <map>
+#include <stdlib.h>
+
+using namespace Elastos::ElaWallet;
+
+static uint256 RandomHash() {
+	uint256 u;
+	for (unsigned char *p = u.begin(); p != u.end(); ++p)
+		*p = (unsigned char) rand();
+	return u;
+}
+
+TEST_CASE("std::hash of uint types", "[FlatHashMap]") {
+	uint256 a = RandomHash(), b(a);
+	REQUIRE(std::hash<uint256>()(a) == std::hash<uint256>()(b));
+	REQUIRE(std::hash<uint256>()(a) == (size_t) a.Get64(0));
+
+	bytes_t program(21);
+	for (size_t i = 0; i < program.size(); ++i)
+		program[i] = (uint8_t) (i + 1);
+	uint168 p(program), q(program);
+	REQUIRE(std::hash<uint168>()(p) == std::hash<uint168>()(q));
+	q.begin()[0] = 0x21;
+	// the prefix is left out
+	REQUIRE(std::hash<uint168>()(p) == std::hash<uint168>()(q));
+}
+
+TEST_CASE("FlatHashMap matches std::map", "[FlatHashMap]") {
+	srand(1);
+
+	SECTION("random inserts, lookups and erases") {
+		FlatHashMap<uint256, int> flat;
+		std::map<uint256, int> ordered;
+		std::vector<uint256> keys;
+
+		for (int i = 0; i < 5000; ++i) {
+			uint256 key = RandomHash();
+			keys.push_back(key);
+			REQUIRE(flat.insert(std::make_pair(key, i)).second == ordered.insert(std::make_pair(key, i)).second);
+			// same key again
+			REQUIRE(!flat.insert(std::make_pair(key, -1)).second);
+
+			if (i % 3 == 0) {
+				const uint256 &victim = keys[rand() % keys.size()];
+				REQUIRE(flat.erase(victim) == ordered.erase(victim));
+			}
+		}
+
+		REQUIRE(flat.size() == ordered.size());
+		for (size_t i = 0; i < keys.size(); ++i) {
+			std::map<uint256, int>::iterator o = ordered.find(keys[i]);
+			FlatHashMap<uint256, int>::iterator f = flat.find(keys[i]);
+			REQUIRE((o == ordered.end()) == (f == flat.end()));
+			if (o != ordered.end())
+				REQUIRE(f->second == o->second);
+		}
+
+		size_t visited = 0;
+		for (FlatHashMap<uint256, int>::const_iterator it = flat.begin(); it != flat.end(); ++it) {
+			REQUIRE(ordered[it->first] == it->second);
+			++visited;
+		}
+		REQUIRE(visited == ordered.size());
+	}
+
+	SECTION("keys that are plain numbers") {
+		// not random like a hash, so probing relies on the mixing step
+		FlatHashSet<uint256> set;
+		for (uint64_t i = 0; i < 1000; ++i)
+			REQUIRE(set.insert(uint256(i << 32)).second);
+		for (uint64_t i = 0; i < 1000; i += 2)
+			REQUIRE(set.erase(uint256(i << 32)) == 1);
+		for (uint64_t i = 0; i < 1000; ++i)
+			REQUIRE(set.count(uint256(i << 32)) == (i % 2));
+		REQUIRE(set.size() == 500);
+
+		set.clear();
+		REQUIRE(set.empty());
+		REQUIRE(set.find(uint256(0)) == set.end());
+	}
+
+	SECTION("operator[]") {
+		FlatHashMap<uint168, int> amounts;
+		uint168 a(bytes_t(21, 1)), b(bytes_t(21, 2));
+		amounts[a] += 5;
+		amounts[a] += 5;
+		amounts[b] = 1;
+		REQUIRE(amounts.size() == 2);
+		REQUIRE(amounts[a] == 10);
+		REQUIRE(amounts[b] == 1);
+	}
+}
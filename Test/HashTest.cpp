@@ -0,0 +1,55 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/hash.h>
+#include <Common/uint256.h>
+#include <Common/Utils.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("hash test", "[hash]") {
+
+	SECTION("fixed-size digest matches vector digest") {
+		for (size_t len = 1; len < 200; len += 13) {
+			bytes_t data = Utils::GetRandom(len);
+			uint256 md;
+			uint160 md160;
+
+			sha256(data.data(), data.size(), md);
+			REQUIRE(bytes_t(md.begin(), md.size()) == sha256(data));
+
+			sha256_2(data.data(), data.size(), md);
+			REQUIRE(bytes_t(md.begin(), md.size()) == sha256_2(data));
+
+			ripemd160(data.data(), data.size(), md160);
+			REQUIRE(bytes_t(md160.begin(), md160.size()) == ripemd160(data));
+
+			hash160(data.data(), data.size(), md160);
+			REQUIRE(bytes_t(md160.begin(), md160.size()) == hash160(data));
+		}
+	}
+
+	SECTION("merkle node and incremental hasher") {
+		uint256 left(Utils::GetRandom(32)), right(Utils::GetRandom(32)), md, expect;
+
+		bytes_t data(left.begin(), left.size());
+		data += bytes_t(right.begin(), right.size());
+		expect = sha256_2(data);
+
+		sha256_2(left, right, md);
+		REQUIRE(md == expect);
+
+		SHA256Hasher hasher;
+		hasher.Write(left.begin(), left.size()).Write(right.begin(), right.size()).Finalize2(md);
+		REQUIRE(md == expect);
+
+		hasher.Reset().Write(data).Finalize(md);
+		REQUIRE(md == uint256(sha256(data)));
+	}
+
+}
@@ -252,8 +252,8 @@ TEST_CASE("Wallet GetBalance test", "[GetBalance]") {
 	REQUIRE(dm.GetAllTransactions(CHAINID_MAINCHAIN).size() == txCount);
 
 	//transfer to another address
-	BigInt transferAmount(2005);
-	BigInt totalInput(0);
+	Amount transferAmount(2005);
+	Amount totalInput(0);
 	TransactionPtr tx(new Transaction());
 	tx->SetVersion(Transaction::TxVersion::Default);
 	tx->SetLockTime(getRandUInt32());
@@ -283,7 +283,7 @@ TEST_CASE("Wallet GetBalance test", "[GetBalance]") {
 			break;
 		}
 	}
-	BigInt fee = totalInput - transferAmount;
+	Amount fee = totalInput - transferAmount;
 	Address toAddress("Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ");
 	OutputPtr output(new TransactionOutput(transferAmount, toAddress));
 	tx->AddOutput(output);
@@ -13,6 +13,7 @@
 #include <Plugin/Block/MerkleBlock.h>
 #include <Plugin/ELAPlugin.h>
 #include <Plugin/IDPlugin.h>
+#include <Common/hash.h>
 
 #include <catch.hpp>
 #include "TestHelper.h"
@@ -43,4 +44,157 @@ TEST_CASE("MerkleBlock construct test", "[MerkleBlock]") {
 
 		verifyELAMerkleBlock(static_cast<const MerkleBlock &>(*merkleBlock), mb);
 	}
+
+	SECTION("hash covers the received header") {
+		MerkleBlockPtr merkleBlock = Registry::Instance()->CreateMerkleBlock("ELA");
+		REQUIRE(merkleBlock != nullptr);
+		setMerkleBlockValues(static_cast<MerkleBlock *>(merkleBlock.get()));
+
+		ByteStream stream;
+		merkleBlock->Serialize(stream);
+
+		MerkleBlock mb, unhashed;
+		REQUIRE(mb.Deserialize(stream));
+		// the height a peer manager assigns afterwards must not change the hash
+		mb.SetHeight(merkleBlock->GetHeight() + 1);
+		REQUIRE(mb.GetHash() == merkleBlock->GetHash());
+
+		REQUIRE(unhashed.DeserializeUnhashed(stream));
+		REQUIRE(unhashed.GetHash() == merkleBlock->GetHash());
+	}
+
+	SECTION("compact") {
+		MerkleBlockPtr merkleBlock = Registry::Instance()->CreateMerkleBlock("ELA");
+		REQUIRE(merkleBlock != nullptr);
+		setMerkleBlockValues(static_cast<MerkleBlock *>(merkleBlock.get()));
+
+		uint256 hash = merkleBlock->GetHash();
+		ByteStream header, full;
+		merkleBlock->SerializeHeader(header);
+		merkleBlock->Serialize(full);
+
+		merkleBlock->Compact();
+
+		ByteStream compactHeader, compact;
+		merkleBlock->SerializeHeader(compactHeader);
+		merkleBlock->Serialize(compact);
+		REQUIRE(merkleBlock->GetHash() == hash);
+		REQUIRE(compactHeader.GetBytes() == header.GetBytes());
+		REQUIRE(compact.GetBytes().size() < full.GetBytes().size());
+
+		std::vector<uint256> txHashes;
+		REQUIRE(merkleBlock->MerkleBlockTxHashes(txHashes) == 0);
+		REQUIRE(static_cast<MerkleBlock *>(merkleBlock.get())->GetHashes().empty());
+	}
+}
+
+namespace {
+	// builds a partial merkle tree the way a full node does, see bitcoin's CPartialMerkleTree
+	class PartialMerkleTreeBuilder {
+	public:
+		PartialMerkleTreeBuilder(const std::vector<uint256> &leaves, const std::vector<bool> &matches) :
+			_leaves(leaves), _matches(matches) {
+			int height = 0;
+			while (Width(height) > 1)
+				height++;
+			Build(height, 0);
+		}
+
+		uint256 Root() const {
+			int height = 0;
+			while (Width(height) > 1)
+				height++;
+			return Hash(height, 0);
+		}
+
+		std::vector<uint256> hashes;
+		std::vector<uint8_t> flags;
+
+	private:
+		size_t Width(int height) const {
+			return (_leaves.size() + ((size_t) 1 << height) - 1) >> height;
+		}
+
+		uint256 Hash(int height, size_t pos) const {
+			if (height == 0)
+				return _leaves[pos];
+
+			uint256 left = Hash(height - 1, pos * 2), right = left, md;
+			if (pos * 2 + 1 < Width(height - 1))
+				right = Hash(height - 1, pos * 2 + 1);
+			sha256_2(left, right, md);
+			return md;
+		}
+
+		void Build(int height, size_t pos) {
+			bool parentOfMatch = false;
+			for (size_t p = pos << height; p < ((pos + 1) << height) && p < _leaves.size(); ++p)
+				parentOfMatch |= _matches[p];
+
+			if (_bits % 8 == 0)
+				flags.push_back(0);
+			if (parentOfMatch)
+				flags.back() |= 1 << (_bits % 8);
+			_bits++;
+
+			if (height == 0 || !parentOfMatch) {
+				hashes.push_back(Hash(height, pos));
+			} else {
+				Build(height - 1, pos * 2);
+				if (pos * 2 + 1 < Width(height - 1))
+					Build(height - 1, pos * 2 + 1);
+			}
+		}
+
+		const std::vector<uint256> &_leaves;
+		const std::vector<bool> &_matches;
+		size_t _bits = 0;
+	};
+
+	class MerkleBlockProbe : public MerkleBlock {
+	public:
+		using MerkleBlockBase::MerkleBlockRoot;
+	};
+}
+
+TEST_CASE("Partial merkle tree decode", "[MerkleBlock]") {
+	srand(1);
+
+	for (int round = 0; round < 200; ++round) {
+		size_t count = 1 + rand() % (round < 100 ? 16 : 600);
+		std::vector<uint256> leaves(count), matched;
+		std::vector<bool> matches(count);
+
+		for (size_t i = 0; i < count; ++i) {
+			leaves[i] = getRanduint256();
+			matches[i] = rand() % 8 == 0;
+			if (matches[i])
+				matched.push_back(leaves[i]);
+		}
+
+		PartialMerkleTreeBuilder tree(leaves, matches);
+		MerkleBlockProbe block;
+		block.SetTransactionCount((uint32_t) count);
+		block.SetHashes(tree.hashes);
+		block.SetFlags(tree.flags);
+
+		std::vector<uint256> txHashes;
+		REQUIRE(block.MerkleBlockTxHashes(txHashes) == matched.size());
+		REQUIRE((txHashes == matched));
+
+		REQUIRE(block.MerkleBlockRoot() == tree.Root());
+
+		// served from what MerkleBlockRoot() collected
+		txHashes.clear();
+		REQUIRE(block.MerkleBlockTxHashes(txHashes) == matched.size());
+		REQUIRE((txHashes == matched));
+
+		if (tree.hashes.size() >= 2) {
+			// a duplicated branch must not verify (CVE-2012-2459)
+			std::vector<uint256> forged = tree.hashes;
+			forged[1] = forged[0];
+			block.SetHashes(forged);
+			REQUIRE(block.MerkleBlockRoot() != tree.Root());
+		}
+	}
 }
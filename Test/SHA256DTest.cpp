@@ -0,0 +1,57 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/SHA256D.h>
+#include <Common/hash.h>
+#include <Common/Utils.h>
+
+using namespace Elastos::ElaWallet;
+
+static const char *kernels[] = {"openssl", "sse4.1", "avx2"};
+
+TEST_CASE("multi-buffer sha256d matches openssl", "[SHA256D]") {
+	const std::string detected = SHA256D::Implementation();
+
+	for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+		if (!SHA256D::SetImplementation(kernels[k]))
+			continue;
+
+		SECTION(std::string("hash pairs with ") + kernels[k]) {
+			for (size_t count = 0; count < 20; ++count) {
+				std::vector<uint256> in(2 * count), out(count);
+				for (size_t i = 0; i < in.size(); ++i)
+					in[i] = uint256(Utils::GetRandom(32));
+
+				SHA256D::HashPairs(out.data(), in.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					uint256 expect;
+					sha256_2(in[2 * i], in[2 * i + 1], expect);
+					REQUIRE(out[i] == expect);
+				}
+			}
+		}
+
+		SECTION(std::string("hash messages with ") + kernels[k]) {
+			std::vector<bytes_t> messages;
+			for (size_t i = 0; i < 16; ++i)
+				messages.push_back(Utils::GetRandom(80)); // merkle block header
+			for (size_t len = 0; len < 200; len += 7)
+				messages.push_back(Utils::GetRandom(len));
+			for (size_t i = 0; i < 9; ++i)
+				messages.push_back(Utils::GetRandom(55 + i % 2)); // both sides of the one block padding limit
+
+			std::vector<uint256> out(messages.size());
+			SHA256D::Hash(out.data(), messages.data(), messages.size());
+			for (size_t i = 0; i < messages.size(); ++i)
+				REQUIRE(out[i] == uint256(sha256_2(messages[i])));
+		}
+	}
+
+	REQUIRE(SHA256D::SetImplementation(detected));
+	REQUIRE(!SHA256D::SetImplementation("none"));
+}
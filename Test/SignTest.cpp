@@ -114,6 +114,33 @@ TEST_CASE("Sign transaction test", "[SignTransaction]") {
 				REQUIRE(tx->IsSigned());
 			}
 
+			SECTION("Batch sign test") {
+				AddressArray addresses;
+				subAccount1->GetAllAddresses(addresses, 0, 100, false);
+				REQUIRE(addresses.size() > 3);
+
+				std::vector<TransactionPtr> txs;
+				for (size_t i = 0; i < 20; ++i) {
+					bytes_t redeemScript;
+					std::string path;
+					TransactionPtr tx(new Transaction);
+					tx->FromJson(content);
+					tx->SetLockTime(i);
+					for (size_t k = 0; k < 3; ++k) {
+						REQUIRE(subAccount1->GetCodeAndPath(addresses[(i + k) % 4], redeemScript, path));
+						tx->AddProgram(ProgramPtr(new Program(path, redeemScript, bytes_t())));
+					}
+					txs.push_back(tx);
+				}
+
+				REQUIRE_THROWS(subAccount3->SignTransactions(txs, payPasswd));
+				REQUIRE_NOTHROW(subAccount1->SignTransactions(txs, payPasswd));
+				for (size_t i = 0; i < txs.size(); ++i)
+					REQUIRE(txs[i]->IsSigned());
+
+				REQUIRE_THROWS(subAccount1->SignTransactions(txs, payPasswd));
+			}
+
 			SECTION("Owner standard address sign test") {
 				AddressPtr addr(new Address(PrefixStandard, ownerPubKey1));
 				bytes_t redeemScript;
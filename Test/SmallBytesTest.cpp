@@ -0,0 +1,92 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/ByteStream.h>
+#include <Common/SmallBytes.h>
+#include <Common/Log.h>
+
+#include <utility>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("SmallBytes", "[SmallBytes]") {
+	Log::registerMultiLogger();
+
+	bytes_t pubkey("02b7a2d2aa9f1a8e7a8e8c2d8e3a1c8f7b8a8f1e9c5d3a7e6b2c1d0e9f8a7b6c5d");
+	bytes_t script(100);
+	for (size_t i = 0; i < script.size(); ++i)
+		script[i] = (uint8_t) i;
+
+	SECTION("inline and heap storage") {
+		SmallBytes small(pubkey);
+		REQUIRE(small.IsInline());
+		REQUIRE(small.size() == pubkey.size());
+		REQUIRE((small == pubkey));
+		REQUIRE(small.getHex() == pubkey.getHex());
+
+		SmallBytes large(script);
+		REQUIRE(!large.IsInline());
+		REQUIRE((large == script));
+		REQUIRE((bytes_t(large) == script));
+
+		SmallBytes grown;
+		for (size_t i = 0; i < script.size(); ++i)
+			grown.push_back(script[i]);
+		REQUIRE((grown == large));
+
+		grown += grown;
+		REQUIRE(grown.size() == 2 * script.size());
+		REQUIRE((SmallBytes(grown.data() + script.size(), script.size()) == script));
+	}
+
+	SECTION("copy and move") {
+		SmallBytes a(script), b(pubkey);
+
+		SmallBytes c(a);
+		REQUIRE((c == a));
+		c = b;
+		REQUIRE((c == b));
+
+		SmallBytes d(std::move(a));
+		REQUIRE((d == script));
+		REQUIRE(a.empty());
+		REQUIRE(a.IsInline());
+
+		d = std::move(b);
+		REQUIRE((d == pubkey));
+		REQUIRE(b.empty());
+	}
+
+	SECTION("order matches bytes_t") {
+		bytes_t x("0102"), y("0103"), z("00");
+		REQUIRE(((SmallBytes(x) < SmallBytes(y)) == (x < y)));
+		REQUIRE(((SmallBytes(y) < SmallBytes(x)) == (y < x)));
+		REQUIRE(((SmallBytes(z) < SmallBytes(x)) == (z < x)));
+		REQUIRE((SmallBytes(x) != y));
+		REQUIRE((SmallBytes() == bytes_t()));
+	}
+
+	SECTION("byte stream") {
+		ByteStream stream;
+		stream.WriteVarBytes(SmallBytes(pubkey));
+		stream.WriteVarBytes(SmallBytes(script));
+
+		ByteStreamView view(stream.GetBytes());
+		SmallBytes a, b;
+		REQUIRE(view.ReadVarBytes(a));
+		REQUIRE(view.ReadVarBytes(b));
+		REQUIRE((a == pubkey));
+		REQUIRE((b == script));
+		REQUIRE(!view.ReadVarBytes(a));
+
+		ByteStreamView inner(b);
+		uint8_t first = 0;
+		REQUIRE(inner.ReadUint8(first));
+		REQUIRE(first == script[0]);
+	}
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Database/Sqlite.h>
+#include <Common/Utils.h>
+#include <Common/Log.h>
+
+using namespace Elastos::ElaWallet;
+
+#define DBFILE "sqlite_test.db"
+
+static const std::string insertSql = "INSERT INTO kv (k, v) VALUES (?, ?);";
+
+static void ResetDatabase(Sqlite &sqlite) {
+	REQUIRE(sqlite.exec("DROP TABLE IF EXISTS kv;", nullptr, nullptr));
+	REQUIRE(sqlite.exec("CREATE TABLE kv (k INTEGER PRIMARY KEY, v BLOB);", nullptr, nullptr));
+}
+
+static bool Insert(Sqlite &sqlite, int key, const bytes_t &value, bool cached) {
+	sqlite3_stmt *stmt;
+	bool ok = cached ? sqlite.PrepareCached(insertSql, &stmt) : sqlite.Prepare(insertSql, &stmt, nullptr);
+	if (!ok)
+		return false;
+
+	ok = sqlite.BindInt(stmt, 1, key) && sqlite.BindBlob(stmt, 2, value, nullptr) &&
+		 SQLITE_DONE == sqlite.Step(stmt);
+
+	return sqlite.Finalize(stmt) && ok;
+}
+
+TEST_CASE("Sqlite statement cache", "[Sqlite]") {
+	Sqlite sqlite(DBFILE);
+	REQUIRE(sqlite.IsValid());
+	ResetDatabase(sqlite);
+
+	SECTION("cached statement is reused with cleared bindings") {
+		sqlite3_stmt *first, *second;
+		REQUIRE(sqlite.PrepareCached(insertSql, &first));
+		REQUIRE(sqlite.BindInt(first, 1, 1));
+		REQUIRE(sqlite.BindBlob(first, 2, Utils::GetRandom(8), nullptr));
+		REQUIRE(sqlite.Step(first) == SQLITE_DONE);
+		REQUIRE(sqlite.Finalize(first));
+
+		REQUIRE(sqlite.PrepareCached(insertSql, &second));
+		REQUIRE(second == first);
+		REQUIRE(sqlite.BindInt(second, 1, 2));
+		REQUIRE(sqlite.Step(second) == SQLITE_DONE);
+		REQUIRE(sqlite.Finalize(second));
+		REQUIRE(sqlite.CachedStatementCount() == 1);
+
+		sqlite3_stmt *stmt;
+		REQUIRE(sqlite.PrepareCached("SELECT COUNT(*) FROM kv WHERE v IS NULL;", &stmt));
+		REQUIRE(sqlite.Step(stmt) == SQLITE_ROW);
+		REQUIRE(sqlite.ColumnInt(stmt, 0) == 1);
+		REQUIRE(sqlite.Finalize(stmt));
+		REQUIRE(sqlite.CachedStatementCount() == 2);
+	}
+
+	SECTION("busy cached statement falls back to a private one") {
+		sqlite3_stmt *held, *other;
+		REQUIRE(sqlite.PrepareCached(insertSql, &held));
+		REQUIRE(sqlite.PrepareCached(insertSql, &other));
+		REQUIRE(held != other);
+		REQUIRE(sqlite.Finalize(other));
+		REQUIRE(sqlite.Finalize(held));
+		REQUIRE(sqlite.CachedStatementCount() == 1);
+
+		REQUIRE(sqlite.PrepareCached(insertSql, &other));
+		REQUIRE(other == held);
+		REQUIRE(sqlite.Finalize(other));
+	}
+
+	SECTION("bulk insert through the cache") {
+		REQUIRE(sqlite.BeginTransaction(IMMEDIATE));
+		for (int i = 0; i < 1000; ++i)
+			REQUIRE(Insert(sqlite, i, Utils::GetRandom(64), true));
+		REQUIRE(sqlite.EndTransaction());
+
+		sqlite3_stmt *stmt;
+		REQUIRE(sqlite.PrepareCached("SELECT COUNT(*) FROM kv;", &stmt));
+		REQUIRE(sqlite.Step(stmt) == SQLITE_ROW);
+		REQUIRE(sqlite.ColumnInt(stmt, 0) == 1000);
+		REQUIRE(sqlite.Finalize(stmt));
+	}
+}
+
+TEST_CASE("Sqlite nested transactions", "[Sqlite]") {
+	Log::registerMultiLogger();
+	Sqlite sqlite(DBFILE);
+	REQUIRE(sqlite.IsValid());
+	ResetDatabase(sqlite);
+
+	REQUIRE(sqlite.BeginTransaction(IMMEDIATE));
+	REQUIRE(Insert(sqlite, 1, Utils::GetRandom(8), true));
+	REQUIRE(sqlite.BeginTransaction(IMMEDIATE));
+	REQUIRE(Insert(sqlite, 2, Utils::GetRandom(8), true));
+	REQUIRE(sqlite.EndTransaction());
+	REQUIRE(!sqlite.SetDurability(DurabilityProfile::Normal()));
+	REQUIRE(sqlite.EndTransaction());
+
+	// the outermost commit ended the transaction, so a new one can begin
+	REQUIRE(sqlite.BeginTransaction(IMMEDIATE));
+	REQUIRE(Insert(sqlite, 3, Utils::GetRandom(8), true));
+	REQUIRE(sqlite.EndTransaction());
+	REQUIRE(sqlite.SetDurability(DurabilityProfile::Normal()));
+}
+
+static std::string Pragma(Sqlite &sqlite, const std::string &name) {
+	sqlite3_stmt *stmt;
+	std::string value;
+	REQUIRE(sqlite.Prepare("PRAGMA " + name + ";", &stmt, nullptr));
+	if (sqlite.Step(stmt) == SQLITE_ROW)
+		value = sqlite.ColumnText(stmt, 0);
+	REQUIRE(sqlite.Finalize(stmt));
+	return value;
+}
+
+TEST_CASE("Sqlite durability profiles", "[Sqlite]") {
+	Log::registerMultiLogger();
+	Sqlite sqlite(DBFILE);
+	REQUIRE(sqlite.IsValid());
+
+	REQUIRE(sqlite.SetDurability(DurabilityProfile::Normal()));
+	REQUIRE(Pragma(sqlite, "journal_mode") == "wal");
+	REQUIRE(Pragma(sqlite, "synchronous") == "1");
+	REQUIRE(Pragma(sqlite, "wal_autocheckpoint") == "1000");
+
+	REQUIRE(sqlite.SetDurability(DurabilityProfile::BulkSync()));
+	REQUIRE(Pragma(sqlite, "synchronous") == "0");
+	REQUIRE(Pragma(sqlite, "wal_autocheckpoint") == "0");
+	REQUIRE(Pragma(sqlite, "cache_size") == "-32768");
+	REQUIRE(sqlite.Checkpoint());
+
+	DurabilityProfile profile;
+	REQUIRE(DurabilityProfile::FromName("Safe", profile));
+	REQUIRE(sqlite.SetDurability(profile));
+	REQUIRE(Pragma(sqlite, "synchronous") == "2");
+	REQUIRE(!DurabilityProfile::FromName("Fast", profile));
+
+	profile.Synchronous = "NORMAL; DROP TABLE kv";
+	REQUIRE(!sqlite.SetDurability(profile));
+}
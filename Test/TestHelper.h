@@ -17,6 +17,7 @@
 #include <Plugin/Transaction/Payload/OutputPayload/PayloadVote.h>
 #include <Plugin/Transaction/Payload/OutputPayload/PayloadDefault.h>
 #include <Common/BigInt.h>
+#include <Common/Amount.h>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -58,6 +59,10 @@ namespace Elastos {
 			return bg;
 		}
 
+		static Amount getRandAmount() {
+			return Amount((uint64_t) rand());
+		}
+
 		static std::string getRandHexString(size_t length) {
 			char buf[length];
 			for (size_t i = 0; i < length; ) {
@@ -124,7 +129,7 @@ namespace Elastos {
 
 			for (size_t i = 0; i < 20; ++i) {
 				Address addr(getRandUInt168());
-				OutputPtr output(new TransactionOutput(getRandBigInt(), addr, getRanduint256()));
+				OutputPtr output(new TransactionOutput(getRandAmount(), addr, getRanduint256()));
 				output->SetOutputLock(getRandUInt32());
 				if (version >= Transaction::TxVersion::V09) {
 					output->SetType(TransactionOutput::Type(i % 2));
@@ -14,6 +14,8 @@
 #include <Common/Utils.h>
 #include <Common/Log.h>
 #include <Common/ElementSet.h>
+#include <Common/hash.h>
+#include <Database/TransactionDataStore.h>
 
 using namespace Elastos::ElaWallet;
 
@@ -41,6 +43,107 @@ TEST_CASE("Transaction Serialize and Deserialize", "[Transaction]") {
 		verifyTransaction(tx1, tx2, true);
 	}
 
+	SECTION("transaction Deserialize from borrowed memory") {
+		Transaction tx1;
+		initTransaction(tx1, Transaction::TxVersion::V09);
+
+		ByteStream stream;
+		tx1.Serialize(stream);
+		const bytes_t &raw = stream.GetBytes();
+
+		Transaction tx2;
+		REQUIRE(tx2.Deserialize(ByteStreamView(raw.data(), raw.size())));
+		verifyTransaction(tx1, tx2, false);
+
+		ByteStreamView truncated(raw.data(), raw.size() - 1);
+		Transaction tx3;
+		REQUIRE(!tx3.Deserialize(truncated));
+	}
+
+	SECTION("transaction Serialize into an exact buffer") {
+		Transaction tx1;
+		initTransaction(tx1, Transaction::TxVersion::V09);
+
+		ByteStream grown;
+		tx1.Serialize(grown, true);
+
+		ByteStream counter(ByteStream::CountOnly);
+		tx1.Serialize(counter, true);
+		REQUIRE(counter.WrittenSize() == grown.GetBytes().size());
+		REQUIRE(counter.size() == 0);
+
+		ByteStream exact;
+		exact.WriteExact([&tx1](ByteStream &s) { tx1.Serialize(s, true); });
+		REQUIRE(exact.GetBytes() == grown.GetBytes());
+		REQUIRE(exact.GetBytes().capacity() == exact.GetBytes().size());
+
+		ByteStream varint(ByteStream::CountOnly);
+		REQUIRE(varint.WriteVarUint(0xfc) == ByteStream::VarUintSize(0xfc));
+		REQUIRE(ByteStream::VarUintSize(0xfd) == 3);
+		REQUIRE(ByteStream::VarUintSize(0x10000) == 5);
+		REQUIRE(ByteStream::VarUintSize(0x100000000) == 9);
+	}
+
+	SECTION("transaction serialization cache") {
+		Transaction tx;
+		initTransaction(tx, Transaction::TxVersion::V09);
+
+		ByteStream unsignedStream;
+		tx.SerializeUnsigned(unsignedStream);
+		uint256 md;
+		sha256(unsignedStream.GetBytes().data(), unsignedStream.GetBytes().size(), md);
+
+		REQUIRE(tx.GetUnsignedBytes() == unsignedStream.GetBytes());
+		REQUIRE(tx.GetShaData() == md);
+		REQUIRE(tx.GetShaData() == md);
+
+		ByteStream extended;
+		tx.Serialize(extended, true);
+		tx.FixIndex();
+		REQUIRE(tx.GetShaData() == md);
+
+		uint256 hash = tx.GetHash();
+		tx.AddInput(InputPtr(new TransactionInput(getRanduint256(), 0)));
+		REQUIRE(tx.GetHash() != hash);
+		REQUIRE(tx.GetShaData() != md);
+
+		ByteStream fresh;
+		tx.SerializeUnsigned(fresh, true);
+		REQUIRE(tx.GetUnsignedBytes(true) == fresh.GetBytes());
+
+		// changed in place, the owner has to say so
+		md = tx.GetShaData();
+		tx.GetOutputs()[0]->SetOutputLock(tx.GetOutputs()[0]->OutputLock() + 1);
+		tx.ResetHash();
+		REQUIRE(tx.GetShaData() != md);
+
+		md = tx.GetShaData();
+		tx.SetLockTime(tx.GetLockTime() + 1);
+		REQUIRE(tx.GetShaData() != md);
+
+		md = tx.GetShaData();
+		tx.AddAttribute(AttributePtr(new Attribute(Attribute::Nonce, getRandBytes(8))));
+		REQUIRE(tx.GetShaData() != md);
+
+		md = tx.GetShaData();
+		tx.SetPayloadVersion(tx.GetPayloadVersion() + 1);
+		REQUIRE(tx.GetShaData() != md);
+
+		md = tx.GetShaData();
+		tx.RemoveOutput(tx.GetOutputs().back());
+		REQUIRE(tx.GetShaData() != md);
+
+		// the stored row is a snapshot, a later change to the tx doesn't reach it
+		TransactionEntity entity(tx);
+		ByteStream stored;
+		tx.Serialize(stored, true);
+		REQUIRE(entity.TxHash == tx.GetHash());
+		REQUIRE(entity.Buff == stored.GetBytes());
+		tx.SetLockTime(tx.GetLockTime() + 1);
+		REQUIRE(entity.Buff == stored.GetBytes());
+		REQUIRE(entity.TxHash != tx.GetHash());
+	}
+
 	SECTION("transaction set") {
 		ElementSet<TransactionPtr> txSet;
 
@@ -232,7 +335,7 @@ TEST_CASE("new tx with type and payload", "[IDTransaction]") {
 
 		verifyTransaction(*tx1, *tx2, false);
 
-		DIDInfo *didInfo = dynamic_cast<DIDInfo *>(tx2->GetPayload());
+		const DIDInfo *didInfo = dynamic_cast<const DIDInfo *>(tx2->GetPayload());
 
 		REQUIRE(didInfo->IsValid());
 		const DIDHeaderInfo &header = didInfo->DIDHeader();
@@ -0,0 +1,107 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Wallet/UTXOTable.h>
+#include <Plugin/Transaction/TransactionOutput.h>
+#include <WalletCore/Address.h>
+
+#include <map>
+#include <stdlib.h>
+
+using namespace Elastos::ElaWallet;
+
+static uint256 RandomHash() {
+	uint256 u;
+	for (unsigned char *p = u.begin(); p != u.end(); ++p)
+		*p = (unsigned char) rand();
+	return u;
+}
+
+static uint168 ProgramHash(uint8_t n) {
+	return uint168(bytes_t(21, n));
+}
+
+TEST_CASE("UTXOTable", "[UTXOTable]") {
+	srand(1);
+	UTXOTable table;
+
+	SECTION("insert, find and remove") {
+		std::map<UTXOTable::Outpoint, uint64_t> expected;
+		std::vector<UTXOTable::Outpoint> outpoints;
+
+		for (int i = 0; i < 1000; ++i) {
+			UTXOTable::Outpoint op(RandomHash(), (uint16_t) (rand() % 4));
+			uint64_t amount = (uint64_t) rand();
+			outpoints.push_back(op);
+			REQUIRE(table.Insert(op.hash, op.index, Amount(amount), 100, ProgramHash(i % 8), UTXOTable::Normal,
+								 nullptr));
+			REQUIRE(!table.Insert(op.hash, op.index, Amount(1), 100, ProgramHash(0), UTXOTable::Vote, nullptr));
+			expected[op] = amount;
+
+			if (i % 3 == 0) {
+				const UTXOTable::Outpoint &victim = outpoints[rand() % outpoints.size()];
+				size_t row = table.Find(victim.hash, victim.index);
+				REQUIRE((row == UTXOTable::npos) == (expected.find(victim) == expected.end()));
+				if (row != UTXOTable::npos) {
+					table.Remove(row);
+					expected.erase(victim);
+				}
+			}
+		}
+
+		REQUIRE(table.Size() == expected.size());
+		for (std::map<UTXOTable::Outpoint, uint64_t>::iterator it = expected.begin(); it != expected.end(); ++it) {
+			size_t row = table.Find(it->first.hash, it->first.index);
+			REQUIRE(row != UTXOTable::npos);
+			REQUIRE((table.GetOutpoint(row) == it->first));
+			REQUIRE(table.GetAmount(row) == Amount(it->second));
+		}
+
+		// rows come back in the order the old ordered set iterated in
+		std::vector<size_t> rows = table.Rows(UTXOTable::Normal);
+		REQUIRE(rows.size() == expected.size());
+		std::map<UTXOTable::Outpoint, uint64_t>::iterator it = expected.begin();
+		for (size_t i = 0; i < rows.size(); ++i, ++it)
+			REQUIRE((table.GetOutpoint(rows[i]) == it->first));
+
+		table.Clear();
+		REQUIRE(table.Size() == 0);
+		REQUIRE(table.GetAddresses().empty());
+	}
+
+	SECTION("kinds, amounts and confirms") {
+		uint256 hash = RandomHash();
+		table.Insert(hash, 0, Amount(5), 10, ProgramHash(1), UTXOTable::Normal, nullptr);
+		table.Insert(hash, 1, Amount(9), 10, ProgramHash(1), UTXOTable::Normal, nullptr);
+		table.Insert(hash, 2, Amount(5), INT32_MAX, ProgramHash(2), UTXOTable::Normal, nullptr);
+		table.Insert(hash, 3, Amount(7), 10, ProgramHash(2), UTXOTable::Locked, nullptr);
+
+		std::vector<size_t> rows = table.Rows(UTXOTable::Normal);
+		table.SortByAmount(rows);
+		REQUIRE(rows.size() == 3);
+		REQUIRE(table.GetOutpoint(rows[0]).index == 1);
+		// equal amounts keep outpoint order
+		REQUIRE(table.GetOutpoint(rows[1]).index == 0);
+		REQUIRE(table.GetOutpoint(rows[2]).index == 2);
+
+		REQUIRE(table.GetConfirms(rows[0], 9) == 0);
+		REQUIRE(table.GetConfirms(rows[0], 10) == 1);
+		REQUIRE(table.GetConfirms(rows[0], 111) == 102);
+		REQUIRE(table.GetConfirms(rows[2], 111) == 0);
+
+		size_t locked = table.Find(hash, 3);
+		REQUIRE(table.GetKind(locked) == UTXOTable::Locked);
+		table.SetKind(locked, UTXOTable::Coinbase);
+		REQUIRE(table.Rows(UTXOTable::Locked).empty());
+		REQUIRE(table.Rows(UTXOTable::Coinbase).size() == 1);
+
+		REQUIRE(table.GetAddresses().size() == 2);
+		REQUIRE(table.FindAddress(ProgramHash(2)) == table.GetAddressIndex(locked));
+		REQUIRE(table.FindAddress(ProgramHash(3)) == UTXOTable::npos);
+	}
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2012-2018 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Database/WriteBehindQueue.h>
+#include <Common/Log.h>
+
+#include <atomic>
+
+using namespace Elastos::ElaWallet;
+
+struct Batches {
+	Batches() : begun(0), committed(0), open(false), unbalanced(false) {}
+
+	bool Begin() {
+		unbalanced = unbalanced || open;
+		open = true;
+		++begun;
+		return true;
+	}
+
+	bool End() {
+		unbalanced = unbalanced || !open;
+		open = false;
+		++committed;
+		return true;
+	}
+
+	std::atomic<int> begun, committed;
+	std::atomic<bool> open, unbalanced;
+};
+
+TEST_CASE("WriteBehindQueue", "[WriteBehindQueue]") {
+	Log::registerMultiLogger();
+	Batches batches;
+	std::vector<int> written;
+
+	WriteBehindQueue queue(boost::bind(&Batches::Begin, &batches), boost::bind(&Batches::End, &batches));
+
+	SECTION("operations run in order and are grouped into batches") {
+		for (int i = 0; i < 1000; ++i)
+			queue.Enqueue([&written, i]() { written.push_back(i); });
+		queue.Flush();
+
+		REQUIRE(queue.PendingCount() == 0);
+		REQUIRE(written.size() == 1000);
+		for (int i = 0; i < 1000; ++i)
+			REQUIRE(written[i] == i);
+		REQUIRE(!batches.unbalanced);
+		REQUIRE(batches.committed == batches.begun);
+		REQUIRE(batches.committed < 1000);
+	}
+
+	SECTION("keyed operations supersede pending ones") {
+		boost::mutex gate;
+		gate.lock();
+		// hold the writer so everything below stays pending
+		queue.Enqueue([&gate]() { gate.lock(); gate.unlock(); });
+		queue.EndBatch();
+		while (queue.PendingCount() != 0)
+			boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+
+		queue.Enqueue("peers", [&written]() { written.push_back(1); });
+		queue.Enqueue([&written]() { written.push_back(2); });
+		queue.Enqueue("peers", [&written]() { written.push_back(3); });
+		queue.Enqueue("blocks", [&written]() { written.push_back(4); });
+		REQUIRE(queue.PendingCount() == 3);
+
+		gate.unlock();
+		queue.Flush();
+		REQUIRE(written == std::vector<int>({2, 3, 4}));
+	}
+
+	SECTION("a table key supersedes the pending records of the table") {
+		boost::mutex gate;
+		gate.lock();
+		queue.Enqueue([&gate]() { gate.lock(); gate.unlock(); });
+		queue.EndBatch();
+		while (queue.PendingCount() != 0)
+			boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+
+		queue.Enqueue("txns/a", [&written]() { written.push_back(1); });
+		queue.Enqueue("txns/b", [&written]() { written.push_back(2); });
+		queue.Enqueue("txns/a", [&written]() { written.push_back(3); });
+		queue.Enqueue("txnsX/a", [&written]() { written.push_back(4); });
+		REQUIRE(queue.PendingCount() == 3);
+
+		queue.Enqueue("txns", [&written]() { written.push_back(5); });
+		queue.Enqueue("txns/b", [&written]() { written.push_back(6); });
+		REQUIRE(queue.PendingCount() == 3);
+
+		gate.unlock();
+		queue.Flush();
+		REQUIRE(written == std::vector<int>({4, 5, 6}));
+	}
+
+	SECTION("stop commits pending work and later writes run inline") {
+		for (int i = 0; i < 10; ++i)
+			queue.Enqueue([&written, i]() { written.push_back(i); });
+		queue.Stop();
+		REQUIRE(written.size() == 10);
+
+		queue.Enqueue([&written]() { written.push_back(10); });
+		REQUIRE(written.size() == 11);
+		REQUIRE(batches.committed == batches.begun);
+	}
+}